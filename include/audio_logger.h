@@ -0,0 +1,343 @@
+// audio_logger.h
+// Asynchronous log usable from the audio thread
+//
+// logError() ... logDebug() store one fixed-size LogRecord (format string
+// pointer and up to kMaxLogArguments numbers or literals) into a lock-free
+// MpscRingBuffer; a background thread formats the records and appends them
+// to the file named by PluginInfo::kLogEnv (SIMPLEPANNER_LOG). Levels above
+// SIMPLEPANNER_LOG_LEVEL are removed at compile time.
+
+#pragma once
+
+#include "plugids.h"
+#include "background_writer.h"
+#include "mpsc_ring_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <type_traits>
+
+// Highest level compiled in: 0 off, 1 error, 2 warning, 3 info, 4 debug
+// (default: warning in release builds, debug otherwise)
+#ifndef SIMPLEPANNER_LOG_LEVEL
+#if defined(NDEBUG)
+#define SIMPLEPANNER_LOG_LEVEL 2
+#else
+#define SIMPLEPANNER_LOG_LEVEL 4
+#endif
+#endif
+
+namespace Steinberg {
+namespace SimplePanner {
+
+enum class LogLevel : uint8 {
+    kError = 1,
+    kWarning,
+    kInfo,
+    kDebug
+};
+
+constexpr int32 kCompiledLogLevel = SIMPLEPANNER_LOG_LEVEL;
+constexpr int32 kMaxLogArguments = 4;
+
+/**
+ * @brief Whether records of a level are compiled in
+ */
+constexpr bool isLogLevelEnabled(LogLevel level) {
+    return static_cast<int32>(level) <= kCompiledLogLevel;
+}
+
+//------------------------------------------------------------------------
+// One argument of a log record
+//------------------------------------------------------------------------
+struct LogArgument {
+    enum Type : uint8 { kInteger, kReal, kString };
+
+    Type type;
+    union {
+        int64 integer;
+        double real;
+        const char* string;  ///< Static storage only (formatted later)
+    };
+};
+
+//------------------------------------------------------------------------
+// One log line as queued by the recording thread
+//------------------------------------------------------------------------
+struct LogRecord {
+    int64 timeNanos;         ///< Since the logger was created
+    const char* format;      ///< String literal, "{}" marks each argument
+    uint32 instance;         ///< Object number (TraceRecorder::nextInstance())
+    LogLevel level;
+    uint8 numArguments;
+    LogArgument arguments[kMaxLogArguments];
+};
+
+//------------------------------------------------------------------------
+inline LogArgument makeLogArgument(const char* value) {
+    LogArgument argument;
+    argument.type = LogArgument::kString;
+    argument.string = value;
+    return argument;
+}
+
+template <typename T>
+LogArgument makeLogArgument(T value) {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "Log arguments are numbers, enums or string literals");
+    LogArgument argument;
+    if constexpr (std::is_floating_point<T>::value) {
+        argument.type = LogArgument::kReal;
+        argument.real = static_cast<double>(value);
+    } else {
+        argument.type = LogArgument::kInteger;
+        argument.integer = static_cast<int64>(value);
+    }
+    return argument;
+}
+
+/**
+ * @brief Collects log records from any thread and writes them to a file
+ *
+ * record() never allocates, locks or does I/O, so it may run on the audio
+ * thread: it reads the clock and pushes one LogRecord. The writer thread
+ * wakes every kWriteIntervalMs, formats the queued records and appends
+ * them to the file, one line each:
+ *
+ *     [   12.345678] W #3 message
+ *
+ * (seconds since the logger was created, level letter, instance). Records
+ * arriving while the buffer is full are dropped; the writer notes how many
+ * in a line of its own.
+ */
+class AudioLogger {
+public:
+    static constexpr size_t kCapacity = 1024;       // Records buffered between writes
+    static constexpr int kWriteIntervalMs = 50;
+
+    /**
+     * @brief Logger of this module, created on first use (call it once
+     *        outside process(), e.g. in initialize())
+     * @return nullptr unless PluginInfo::kLogEnv names a writable file,
+     *         and after shutdown()
+     */
+    static AudioLogger* get() {
+        return current().load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Write what is queued, close the file and stop the writer thread
+     *
+     * Called when the module is unloaded (ModuleTerminator in
+     * pluginfactory.cpp), like TraceRecorder::shutdown().
+     */
+    static void shutdown() {
+        delete current().exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Open a log file and start the writer thread
+     * @param path File to (over)write; check isOpen()
+     */
+    explicit AudioLogger(const char* path)
+        : mFile(path ? std::fopen(path, "w") : nullptr)
+        , mStart(std::chrono::steady_clock::now())
+        , mNumWritten(0)
+        , mNumDropped(0)
+        , mReportedDropped(0)
+    {
+        if (mFile)
+            mWriter.start(kWriteIntervalMs, [this] { writeRecords(); });
+    }
+
+    ~AudioLogger() {
+        if (!mFile)
+            return;
+
+        mWriter.stop();
+
+        writeRecords();
+        std::fclose(mFile);
+    }
+
+    AudioLogger(const AudioLogger&) = delete;
+    AudioLogger& operator=(const AudioLogger&) = delete;
+
+    bool isOpen() const { return mFile != nullptr; }
+
+    /**
+     * @brief Queue a record (any thread, lock-free)
+     * @param level Level of the record (not filtered here)
+     * @param instance Object number
+     * @param format String literal; each "{}" is replaced by the next argument
+     * @param args Up to kMaxLogArguments numbers, enums or string literals
+     */
+    template <typename... Args>
+    void record(LogLevel level, uint32 instance, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= kMaxLogArguments, "Too many log arguments");
+
+        LogRecord entry;
+        entry.timeNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - mStart).count();
+        entry.format = format;
+        entry.instance = instance;
+        entry.level = level;
+        entry.numArguments = static_cast<uint8>(sizeof...(Args));
+        int32 index = 0;
+        ((entry.arguments[index++] = makeLogArgument(args)), ...);
+        (void)index;
+
+        if (!mRecords.push(entry))
+            mNumDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64 numWritten() const { return mNumWritten.load(std::memory_order_relaxed); }
+    uint64 numDropped() const { return mNumDropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Format a record as one line without the newline (writer thread,
+     *        and tests)
+     */
+    static void format(const LogRecord& entry, char* text, size_t size) {
+        static const char kLevelLetters[] = "?EWID";
+        int32 level = static_cast<int32>(entry.level);
+        int written = std::snprintf(text, size, "[%5lld.%06lld] %c #%u ",
+                                    static_cast<long long>(entry.timeNanos / 1000000000),
+                                    static_cast<long long>(entry.timeNanos / 1000 % 1000000),
+                                    kLevelLetters[(level >= 1 && level <= 4) ? level : 0],
+                                    static_cast<unsigned>(entry.instance));
+        size_t length = written > 0 ? std::min(static_cast<size_t>(written), size - 1) : 0;
+
+        int32 next = 0;
+        for (const char* c = entry.format; *c && length + 1 < size; ++c) {
+            if (c[0] == '{' && c[1] == '}' && next < entry.numArguments) {
+                length += formatArgument(entry.arguments[next++], text + length, size - length);
+                ++c;
+            } else {
+                text[length++] = *c;
+            }
+        }
+        text[length] = '\0';
+    }
+
+private:
+    static std::atomic<AudioLogger*>& current() {
+        static std::atomic<AudioLogger*> logger{create(std::getenv(PluginInfo::kLogEnv)).release()};
+        return logger;
+    }
+
+    static std::unique_ptr<AudioLogger> create(const char* path) {
+        if (!path || !*path)
+            return nullptr;
+
+        std::unique_ptr<AudioLogger> logger(new AudioLogger(path));
+        if (!logger->isOpen())
+            return nullptr;
+        return logger;
+    }
+
+    // Numbers in the "C" style whatever the host's locale: integers as
+    // such, reals with up to six decimals
+    static size_t formatArgument(const LogArgument& argument, char* text, size_t size) {
+        int written = 0;
+        switch (argument.type) {
+            case LogArgument::kInteger:
+                written = std::snprintf(text, size, "%lld", static_cast<long long>(argument.integer));
+                break;
+            case LogArgument::kReal: {
+                double value = argument.real;
+                const char* sign = (value < 0.0) ? "-" : "";
+                double magnitude = (value < 0.0) ? -value : value;
+                if (!(magnitude < 1.0e12)) {
+                    // Huge, infinite or NaN: no decimal point to localize
+                    written = std::snprintf(text, size, "%.0f", value);
+                    break;
+                }
+                long long micros = static_cast<long long>(magnitude * 1.0e6 + 0.5);
+                long long fraction = micros % 1000000;
+                int digits = 6;
+                for (; digits > 0 && fraction % 10 == 0; --digits)
+                    fraction /= 10;
+                if (digits == 0)
+                    written = std::snprintf(text, size, "%s%lld", sign, micros / 1000000);
+                else
+                    written = std::snprintf(text, size, "%s%lld.%0*lld", sign, micros / 1000000, digits, fraction);
+                break;
+            }
+            case LogArgument::kString:
+                written = std::snprintf(text, size, "%s", argument.string ? argument.string : "(null)");
+                break;
+        }
+        return written > 0 ? std::min(static_cast<size_t>(written), size - 1) : 0;
+    }
+
+    // Append the queued records (consumer thread only)
+    void writeRecords() {
+        LogRecord entries[64];
+        char text[512];
+        size_t count;
+        while ((count = mRecords.pop(entries, 64)) > 0) {
+            for (size_t i = 0; i < count; ++i) {
+                format(entries[i], text, sizeof(text));
+                std::fputs(text, mFile);
+                std::fputc('\n', mFile);
+            }
+            mNumWritten.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        uint64 dropped = mNumDropped.load(std::memory_order_relaxed);
+        if (dropped != mReportedDropped) {
+            std::fprintf(mFile, "(%llu log records dropped: buffer full)\n",
+                         static_cast<unsigned long long>(dropped - mReportedDropped));
+            mReportedDropped = dropped;
+        }
+        std::fflush(mFile);
+    }
+
+    std::FILE* mFile;
+    std::chrono::steady_clock::time_point mStart;
+    MpscRingBuffer<LogRecord, kCapacity> mRecords;
+    std::atomic<uint64> mNumWritten;
+    std::atomic<uint64> mNumDropped;
+    uint64 mReportedDropped;            // Writer thread only
+    BackgroundWriter mWriter;
+};
+
+//------------------------------------------------------------------------
+// Logging functions: compiled out above SIMPLEPANNER_LOG_LEVEL, one branch
+// when no log file is set. Arguments are numbers, enums or string literals.
+//------------------------------------------------------------------------
+template <LogLevel kLevel, typename... Args>
+inline void logAt(uint32 instance, const char* format, Args... args) {
+    if constexpr (isLogLevelEnabled(kLevel)) {
+        if (AudioLogger* logger = AudioLogger::get())
+            logger->record(kLevel, instance, format, args...);
+    }
+}
+
+template <typename... Args>
+inline void logError(uint32 instance, const char* format, Args... args) {
+    logAt<LogLevel::kError>(instance, format, args...);
+}
+
+template <typename... Args>
+inline void logWarning(uint32 instance, const char* format, Args... args) {
+    logAt<LogLevel::kWarning>(instance, format, args...);
+}
+
+template <typename... Args>
+inline void logInfo(uint32 instance, const char* format, Args... args) {
+    logAt<LogLevel::kInfo>(instance, format, args...);
+}
+
+template <typename... Args>
+inline void logDebug(uint32 instance, const char* format, Args... args) {
+    logAt<LogLevel::kDebug>(instance, format, args...);
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
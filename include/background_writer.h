@@ -0,0 +1,82 @@
+// background_writer.h
+// Periodic writer thread for the trace recorder, the logger and session capture
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief Thread that calls a drain function at a fixed interval
+ *
+ * The owner fills a lock-free queue from any thread (e.g. the audio
+ * thread) and lets this thread move it to a file. stop() wakes the thread
+ * and joins it; the owner then drains what is left itself, so nothing
+ * queued before stop() is lost.
+ */
+class BackgroundWriter {
+public:
+    BackgroundWriter()
+        : mStopping(false)
+    {
+    }
+
+    ~BackgroundWriter() {
+        stop();
+    }
+
+    BackgroundWriter(const BackgroundWriter&) = delete;
+    BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+    /**
+     * @brief Start the thread
+     * @param intervalMs Time between two calls of drain
+     * @param drain Called on the writer thread until stop()
+     */
+    void start(int intervalMs, std::function<void()> drain) {
+        mStopping = false;
+        mThread = std::thread([this, intervalMs, drain = std::move(drain)] { run(intervalMs, drain); });
+    }
+
+    /**
+     * @brief Wake the thread and wait for it to end (no-op if not started)
+     */
+    void stop() {
+        if (!mThread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mWake.notify_one();
+        mThread.join();
+    }
+
+    bool isRunning() const { return mThread.joinable(); }
+
+private:
+    void run(int intervalMs, const std::function<void()>& drain) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (!mStopping) {
+            mWake.wait_for(lock, std::chrono::milliseconds(intervalMs));
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+
+    std::mutex mMutex;                  // Wake-up only
+    std::condition_variable mWake;
+    bool mStopping;
+    std::thread mThread;
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,55 @@
+// decimal_text.h
+// Locale-independent decimal number parsing
+//
+// strtod and friends follow LC_NUMERIC, which a host may set to a locale
+// with a decimal comma. These helpers always use '.', never allocate and
+// work on char (UTF-8) as well as Vst::TChar (UTF-16) text.
+
+#pragma once
+
+namespace Steinberg {
+namespace SimplePanner {
+namespace DecimalText {
+
+template <typename CharT>
+inline bool isSpace(CharT c) {
+    return c == ' ' || c == '\t';
+}
+
+template <typename CharT>
+inline const CharT* skipSpace(const CharT* text) {
+    while (isSpace(*text))
+        ++text;
+    return text;
+}
+
+// [+|-]digits[.digits] in the C locale; advances text past the number
+template <typename CharT>
+inline bool parseDecimal(const CharT*& text, double& value) {
+    const CharT* p = skipSpace(text);
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    double result = 0.0;
+    bool hasDigits = false;
+    for (; *p >= '0' && *p <= '9'; ++p, hasDigits = true)
+        result = result * 10.0 + (*p - '0');
+    if (*p == '.') {
+        double scale = 0.1;
+        for (++p; *p >= '0' && *p <= '9'; ++p, hasDigits = true, scale *= 0.1)
+            result += (*p - '0') * scale;
+    }
+    if (!hasDigits)
+        return false;
+
+    value = negative ? -result : result;
+    text = p;
+    return true;
+}
+
+} // namespace DecimalText
+} // namespace SimplePanner
+} // namespace Steinberg
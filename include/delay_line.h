@@ -109,6 +109,101 @@ public:
         return output;
     }
 
+    /**
+     * @brief Process a block of samples
+     * @param input Input samples
+     * @param output Output samples (may be the same buffer as input)
+     * @param numSamples Number of samples to process
+     *
+     * Produces exactly the same output as calling process() once per sample,
+     * but moves the data with contiguous copies instead of per-sample index math.
+     */
+    void processBlock(const float* input, float* output, size_t numSamples) {
+        if (mBuffer.empty()) {
+            std::fill(output, output + numSamples, 0.0f);
+            return;
+        }
+
+        size_t bufferSize = mBuffer.size();
+        size_t effectiveDelay = (mDelaySamples == 0) ? 1 : mDelaySamples;
+        float* buffer = mBuffer.data();
+
+        while (numSamples > 0) {
+            size_t readIndex = (mWriteIndex + bufferSize - effectiveDelay) % bufferSize;
+            size_t count;
+
+            if (effectiveDelay == bufferSize) {
+                // Read and write positions coincide: read old samples before overwriting
+                count = std::min(numSamples, bufferSize - mWriteIndex);
+                if (input == output) {
+                    std::swap_ranges(buffer + mWriteIndex, buffer + mWriteIndex + count, output);
+                } else {
+                    std::copy(buffer + mWriteIndex, buffer + mWriteIndex + count, output);
+                    std::copy(input, input + count, buffer + mWriteIndex);
+                }
+            } else {
+                // Write first, then read: samples delayed by less than the chunk
+                // length are read back from the chunk just written
+                count = std::min({numSamples,
+                                  bufferSize - mWriteIndex,
+                                  bufferSize - readIndex,
+                                  bufferSize - effectiveDelay});
+                std::copy(input, input + count, buffer + mWriteIndex);
+                std::copy(buffer + readIndex, buffer + readIndex + count, output);
+            }
+
+            mWriteIndex = (mWriteIndex + count) % bufferSize;
+            input += count;
+            output += count;
+            numSamples -= count;
+        }
+    }
+
+    /**
+     * @brief Write a block of samples without reading
+     * @param input Input samples
+     * @param numSamples Number of samples to write
+     *
+     * Keeps the delay history up to date when the caller handles the
+     * minimum 1-sample delay itself (see getLastInput()).
+     */
+    void write(const float* input, size_t numSamples) {
+        if (mBuffer.empty()) {
+            return;
+        }
+
+        size_t bufferSize = mBuffer.size();
+        if (numSamples > bufferSize) {
+            // Only the last bufferSize samples survive
+            size_t skipped = numSamples - bufferSize;
+            mWriteIndex = (mWriteIndex + skipped) % bufferSize;
+            input += skipped;
+            numSamples = bufferSize;
+        }
+
+        while (numSamples > 0) {
+            size_t count = std::min(numSamples, bufferSize - mWriteIndex);
+            std::copy(input, input + count, mBuffer.data() + mWriteIndex);
+            mWriteIndex = (mWriteIndex + count) % bufferSize;
+            input += count;
+            numSamples -= count;
+        }
+    }
+
+    /**
+     * @brief Get the most recently written sample
+     * @return Last input sample (0.0 if the buffer is empty)
+     *
+     * This is the sample process() returns next when the delay is 0 or 1.
+     */
+    float getLastInput() const {
+        if (mBuffer.empty()) {
+            return 0.0f;
+        }
+        size_t bufferSize = mBuffer.size();
+        return mBuffer[(mWriteIndex + bufferSize - 1) % bufferSize];
+    }
+
     /**
      * @brief Reset the delay line
      *
@@ -0,0 +1,125 @@
+// fast_math.h
+// Fast polynomial approximations for the audio path
+//
+// All functions are branch-free (selects only) and table-free so that loops
+// calling them can be auto-vectorized. The exact <cmath> based conversions in
+// parameter_utils.h and pan_calculator.h remain the reference and are what the
+// controller and editor use for display; only the processor uses these.
+// Normalized gain → linear goes through kGainTable (gain_table.h) instead.
+//
+// Maximum errors (measured in test_fast_math.cpp over the full ParamRange):
+// - fastLog2:  absolute error < 1e-6 for normal positive x
+// - fastSin:   absolute error < 2e-6 for x in [-π/2, π/2]
+// - fastCos:   absolute error < 2e-6 for x in [0, π]
+// - fastLinearToDb:  < 1e-5 dB over -60 dB to +6 dB
+// - fastCalculatePanGains:  gain error < 2e-6 (< 1e-4 degrees of pan angle)
+
+#pragma once
+
+#include "parameter_utils.h"
+#include "pan_calculator.h"
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+//------------------------------------------------------------------------
+// Logarithm
+//------------------------------------------------------------------------
+
+/**
+ * @brief Fast log2(x)
+ * @param x Positive normal number
+ * @return Approximation of log2(x)
+ *
+ * Splits x into exponent e and mantissa m in [√0.5, √2); log2(m) uses the
+ * atanh series in t = (m - 1) / (m + 1) up to t^7.
+ */
+inline float fastLog2(float x) {
+    const float kSqrt2 = 1.41421356f;
+    const float kTwoOverLn2 = 2.88539008f;
+
+    std::uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    float exponent = static_cast<float>(static_cast<std::int32_t>((bits >> 23) & 0xff) - 127);
+
+    bits = (bits & 0x007fffffu) | 0x3f800000u;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+
+    // Center the mantissa around 1.0
+    bool high = m > kSqrt2;
+    m = high ? m * 0.5f : m;
+    exponent = high ? exponent + 1.0f : exponent;
+
+    float t = (m - 1.0f) / (m + 1.0f);
+    float t2 = t * t;
+    float p = t * kTwoOverLn2 * (1.0f + t2 * (1.0f / 3.0f + t2 * (1.0f / 5.0f + t2 * (1.0f / 7.0f))));
+    return exponent + p;
+}
+
+//------------------------------------------------------------------------
+// Trigonometry
+//------------------------------------------------------------------------
+
+/**
+ * @brief Fast sin(x)
+ * @param x Angle in radians, in [-π/2, π/2]
+ * @return Approximation of sin(x)
+ *
+ * Odd degree-7 polynomial (Chebyshev fit of sin(x)/x in x²), pinned so
+ * that fastSin(π/2) is exactly 1.0f and hard pan stays bit-exact unity.
+ */
+inline float fastSin(float x) {
+    float x2 = x * x;
+    return x * (9.999939199e-01f
+         + x2 * (-1.666395960e-01f
+         + x2 * (8.299306439e-03f
+         + x2 * -1.820145154e-04f)));
+}
+
+/**
+ * @brief Fast cos(x)
+ * @param x Angle in radians, in [0, π]
+ * @return Approximation of cos(x)
+ */
+inline float fastCos(float x) {
+    const float kHalfPi = 1.57079632679489661923f;
+    return fastSin(kHalfPi - x);
+}
+
+//------------------------------------------------------------------------
+// Parameter Conversions
+//------------------------------------------------------------------------
+
+/**
+ * @brief Fast linear gain → dB (same -60 dB floor as linearToDb)
+ */
+inline float fastLinearToDb(float linear) {
+    const float k20Log10Of2 = 6.02059991f;  // 20 * log10(2)
+    float db = k20Log10Of2 * fastLog2(linear);
+    return (linear <= 0.0f) ? ParamRange::kGainMin : db;
+}
+
+/**
+ * @brief Fast equal power pan gains (same law as calculatePanGains)
+ * @param pan Pan position (-100.0 = full left, +100.0 = full right)
+ */
+inline PanGains fastCalculatePanGains(float pan) {
+    const float kHalfPi = 1.57079632679489661923f;
+
+    pan = std::max(-100.0f, std::min(100.0f, pan));
+    float angle = (pan + 100.0f) / 200.0f * kHalfPi;
+
+    PanGains gains;
+    gains.left = fastCos(angle);
+    gains.right = fastSin(angle);
+    return gains;
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,109 @@
+// gain_table.h
+// Compile-time generated lookup table for normalized → linear gain
+
+#pragma once
+
+#include "parameter_utils.h"
+
+#include <cstddef>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief Interpolated lookup table for normalizedToLinearGain()
+ *
+ * Entries are spaced 1/32 dB apart over ParamRange::kGainMin to kGainMax, so
+ * 0 dB falls exactly on an entry and unity gain stays bit-exact. Linear
+ * interpolation of 10^(dB/20) over one step has a relative error of at most
+ * h²/8 with h = ln(10)/20/32, i.e. < 2e-6 (~1.5e-5 dB), well below the
+ * 0.01 dB requirement. The whole table (2113 floats) is built by the compiler.
+ */
+class GainTable {
+public:
+    static constexpr int kStepsPerDb = 32;
+    static constexpr size_t kNumSteps =
+        static_cast<size_t>(ParamRange::kGainMax - ParamRange::kGainMin) * kStepsPerDb;
+    static constexpr size_t kSize = kNumSteps + 1;
+
+    constexpr GainTable()
+        : mTable()
+    {
+        constexpr double kLn10Over20 = 0.11512925464970229;  // ln(10) / 20
+        for (size_t i = 0; i < kSize; ++i) {
+            double db = ParamRange::kGainMin + static_cast<double>(i) / kStepsPerDb;
+            mTable[i] = static_cast<float>(constexprExp(db * kLn10Over20));
+        }
+    }
+
+    /**
+     * @brief Look up linear gain for a normalized gain value
+     * @param normalized Normalized gain (0.0 - 1.0)
+     * @return Linear gain (0.0 at -60 dB, same mute rule as dbToLinear)
+     */
+    float lookup(float normalized) const {
+        float db = normalizedToDb(normalized);
+        if (db <= ParamRange::kGainMin) {
+            return 0.0f;
+        }
+
+        float position = (db - ParamRange::kGainMin) * kStepsPerDb;
+        size_t index = static_cast<size_t>(position);
+        if (index >= kNumSteps) {
+            return mTable[kNumSteps];
+        }
+
+        float fraction = position - static_cast<float>(index);
+        return mTable[index] + fraction * (mTable[index + 1] - mTable[index]);
+    }
+
+    /**
+     * @brief Raw table entry
+     * @param index Entry index (0 - kSize-1), kGainMin + index/kStepsPerDb dB
+     */
+    constexpr float at(size_t index) const {
+        return mTable[index];
+    }
+
+private:
+    // std::exp is not constexpr: e^x = e^n * e^r with |r| <= 0.5, Taylor series for e^r
+    static constexpr double constexprExp(double x) {
+        constexpr double kE = 2.718281828459045;
+
+        int n = static_cast<int>(x < 0.0 ? x - 0.5 : x + 0.5);
+        double r = x - n;
+
+        double term = 1.0;
+        double sum = 1.0;
+        for (int k = 1; k < 20; ++k) {
+            term *= r / k;
+            sum += term;
+        }
+
+        double scale = 1.0;
+        for (int k = 0; k < (n < 0 ? -n : n); ++k) {
+            scale *= kE;
+        }
+        return n < 0 ? sum / scale : sum * scale;
+    }
+
+    float mTable[kSize];
+};
+
+/// Single shared, read-only instance (inline: one object per module)
+inline constexpr GainTable kGainTable{};
+
+static_assert(kGainTable.at(static_cast<size_t>(-ParamRange::kGainMin) * GainTable::kStepsPerDb) == 1.0f,
+              "0 dB must map to exact unity gain");
+
+/**
+ * @brief Table based normalized → linear gain (audio path)
+ * @param normalized Normalized gain (0.0 - 1.0)
+ * @return Linear gain
+ */
+inline float tableNormalizedToLinearGain(float normalized) {
+    return kGainTable.lookup(normalized);
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
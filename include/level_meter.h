@@ -0,0 +1,136 @@
+// level_meter.h
+// Peak / RMS output metering for the audio path
+//
+// measureBlock() reduces a whole block in one pass. The loop keeps
+// kMeterLanes independent peak and sum accumulators so the compiler can
+// vectorize it (max and multiply-add over full vector registers) without
+// reassociating a single float sum. LevelMeter adds blocks up to the
+// meter's reporting period; process() reports the result as read-only
+// parameters on the same -60 dB to +6 dB scale as the gain parameters.
+
+#pragma once
+
+#include "fast_math.h"
+#include "parameter_utils.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+// Independent accumulators per block reduction (two 128-bit or one 256-bit register)
+constexpr int32 kMeterLanes = 8;
+
+/**
+ * @brief Peak and energy of one block of samples
+ */
+struct BlockLevel {
+    float peak;        ///< Largest absolute sample
+    float sumSquares;  ///< Sum of squared samples
+};
+
+/**
+ * @brief Measure one block of samples
+ * @param samples Block start
+ * @param numSamples Block length (may be 0)
+ * @return Peak and sum of squares of the block
+ */
+inline BlockLevel measureBlock(const float* samples, int32 numSamples) {
+    float peak[kMeterLanes] = {};
+    float sumSquares[kMeterLanes] = {};
+
+    int32 i = 0;
+    for (; i + kMeterLanes <= numSamples; i += kMeterLanes) {
+        for (int32 lane = 0; lane < kMeterLanes; ++lane) {
+            float sample = samples[i + lane];
+            peak[lane] = std::max(peak[lane], std::abs(sample));
+            sumSquares[lane] += sample * sample;
+        }
+    }
+    for (int32 lane = 0; i < numSamples; ++i, ++lane) {
+        float sample = samples[i];
+        peak[lane] = std::max(peak[lane], std::abs(sample));
+        sumSquares[lane] += sample * sample;
+    }
+
+    BlockLevel level = {0.0f, 0.0f};
+    for (int32 lane = 0; lane < kMeterLanes; ++lane) {
+        level.peak = std::max(level.peak, peak[lane]);
+        level.sumSquares += sumSquares[lane];
+    }
+    return level;
+}
+
+/**
+ * @brief Linear level → normalized meter value
+ * @param linear Linear amplitude (0.0 = silence)
+ * @return Same normalized scale as the gain parameters, clamped to 0.0 - 1.0
+ *         (0.0 at -60 dB and below, 1.0 at +6 dB and above)
+ */
+inline float levelToNormalized(float linear) {
+    const float kFloor = 1.0e-3f;  // -60 dB (also keeps denormals away from fastLog2)
+    if (!(linear > kFloor))
+        return 0.0f;
+
+    float normalized = dbToNormalized(fastLinearToDb(linear));
+    return std::min(std::max(normalized, 0.0f), 1.0f);
+}
+
+/**
+ * @brief Peak and RMS of one channel over a reporting period
+ *
+ * add() is called once per block by the audio thread and never allocates.
+ */
+class LevelMeter {
+public:
+    LevelMeter() { reset(); }
+
+    /**
+     * @brief Start a new period
+     */
+    void reset() {
+        mPeak = 0.0f;
+        mSumSquares = 0.0;
+        mNumSamples = 0;
+    }
+
+    /**
+     * @brief Add one block
+     * @param samples Block start
+     * @param numSamples Block length
+     */
+    void add(const float* samples, int32 numSamples) {
+        if (numSamples <= 0)
+            return;
+
+        BlockLevel level = measureBlock(samples, numSamples);
+        mPeak = std::max(mPeak, level.peak);
+        mSumSquares += level.sumSquares;
+        mNumSamples += numSamples;
+    }
+
+    int64 numSamples() const { return mNumSamples; }
+
+    /**
+     * @brief Largest absolute sample of the period (linear)
+     */
+    float peak() const { return mPeak; }
+
+    /**
+     * @brief RMS level of the period (linear, 0.0 without samples)
+     */
+    float rms() const {
+        if (mNumSamples == 0)
+            return 0.0f;
+        return static_cast<float>(std::sqrt(mSumSquares / static_cast<double>(mNumSamples)));
+    }
+
+private:
+    float mPeak;
+    double mSumSquares;
+    int64 mNumSamples;
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
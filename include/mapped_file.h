@@ -0,0 +1,140 @@
+// mapped_file.h
+// Read-only memory mapping of a whole file
+
+#pragma once
+
+#include "pluginterfaces/base/ftypes.h"
+
+#include <cstddef>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief Read-only view of a file mapped into memory
+ *
+ * Opening only maps the file; pages are brought in by the OS on first
+ * access, so the cost does not depend on the file size.
+ */
+class MappedFile {
+public:
+    MappedFile()
+        : mData(nullptr)
+        , mSize(0)
+    {
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map a file, replacing any previous mapping
+     * @param path File path (UTF-8)
+     * @return True if the file exists, is not empty and was mapped
+     */
+    bool open(const char* path) {
+        close();
+        if (!path || !*path) {
+            return false;
+        }
+
+#if defined(_WIN32)
+        int length = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+        if (length <= 0) {
+            return false;
+        }
+        wchar_t* widePath = new wchar_t[length];
+        MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath, length);
+        HANDLE file = CreateFileW(widePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        delete[] widePath;
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);  // The view keeps the mapping alive
+        if (!view) {
+            return false;
+        }
+
+        mData = static_cast<const uint8*>(view);
+        mSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // The mapping stays valid after the descriptor is closed
+        if (view == MAP_FAILED) {
+            return false;
+        }
+
+        mData = static_cast<const uint8*>(view);
+        mSize = static_cast<size_t>(info.st_size);
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Unmap the file (no-op if nothing is mapped)
+     */
+    void close() {
+        if (mData) {
+#if defined(_WIN32)
+            UnmapViewOfFile(mData);
+#else
+            munmap(const_cast<uint8*>(mData), mSize);
+#endif
+        }
+        mData = nullptr;
+        mSize = 0;
+    }
+
+    bool isOpen() const { return mData != nullptr; }
+    const uint8* data() const { return mData; }
+    size_t size() const { return mSize; }
+
+private:
+    const uint8* mData;  ///< Start of the mapping, nullptr if closed
+    size_t mSize;        ///< Mapped bytes
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,144 @@
+// mix_matrix.h
+// Fused 2x2 mix matrix for gain, pan and master gain
+
+#pragma once
+
+#include "fast_math.h"
+#include "gain_table.h"
+#include "pan_law.h"
+
+#include <cmath>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief 2x2 stereo mix matrix
+ *
+ * outL = leftToLeft * inL + rightToLeft * inR
+ * outR = leftToRight * inL + rightToRight * inR
+ *
+ * Channel gains, both pan positions and master gain are all linear, so the
+ * whole chain folds into these four coefficients.
+ */
+struct MixMatrix {
+    float leftToLeft;    ///< Left input → left output
+    float rightToLeft;   ///< Right input → left output
+    float leftToRight;   ///< Left input → right output
+    float rightToRight;  ///< Right input → right output
+
+    /**
+     * @brief Check whether no input crosses over to the other output
+     * @return True if both cross terms are zero
+     */
+    bool isDiagonal() const {
+        return rightToLeft == 0.0f && leftToRight == 0.0f;
+    }
+
+    bool operator==(const MixMatrix& other) const {
+        return leftToLeft == other.leftToLeft
+            && rightToLeft == other.rightToLeft
+            && leftToRight == other.leftToRight
+            && rightToRight == other.rightToRight;
+    }
+
+    bool operator!=(const MixMatrix& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Linear per-sample ramp between two mix matrices
+ *
+ * Sample i of a ramp over numSamples uses start + step * (i + 1),
+ * so the last sample lands exactly on the end matrix.
+ */
+struct MixMatrixRamp {
+    MixMatrix start;  ///< Matrix before the first sample
+    MixMatrix step;   ///< Per-sample increment
+
+    /**
+     * @brief Build a ramp from one matrix to another
+     * @param from Matrix in effect before the block
+     * @param to Matrix to reach at the last sample of the block
+     * @param numSamples Ramp length in samples (must be > 0)
+     */
+    static MixMatrixRamp between(const MixMatrix& from, const MixMatrix& to, int numSamples) {
+        float scale = 1.0f / static_cast<float>(numSamples);
+        MixMatrixRamp ramp;
+        ramp.start = from;
+        ramp.step.leftToLeft = (to.leftToLeft - from.leftToLeft) * scale;
+        ramp.step.rightToLeft = (to.rightToLeft - from.rightToLeft) * scale;
+        ramp.step.leftToRight = (to.leftToRight - from.leftToRight) * scale;
+        ramp.step.rightToRight = (to.rightToRight - from.rightToRight) * scale;
+        return ramp;
+    }
+};
+
+/**
+ * @brief Interpolate between two compiled mix matrices (A/B morph)
+ * @param a Matrix at amount 0
+ * @param b Matrix at amount 1
+ * @param amount Morph amount (0.0 - 1.0)
+ * @return a + (b - a) * amount; exactly a at 0 and exactly b at 1
+ *
+ * The whole signal path is linear in the coefficients, so blending the
+ * compiled matrices equals crossfading the outputs of both settings.
+ */
+inline MixMatrix morphMixMatrix(const MixMatrix& a, const MixMatrix& b, float amount) {
+    if (amount <= 0.0f) {
+        return a;
+    }
+    if (amount >= 1.0f) {
+        return b;
+    }
+    MixMatrix matrix;
+    matrix.leftToLeft = a.leftToLeft + (b.leftToLeft - a.leftToLeft) * amount;
+    matrix.rightToLeft = a.rightToLeft + (b.rightToLeft - a.rightToLeft) * amount;
+    matrix.leftToRight = a.leftToRight + (b.leftToRight - a.leftToRight) * amount;
+    matrix.rightToRight = a.rightToRight + (b.rightToRight - a.rightToRight) * amount;
+    return matrix;
+}
+
+/**
+ * @brief Compile normalized parameters into a single mix matrix
+ * @param leftGain Left channel gain (normalized 0.0 - 1.0)
+ * @param rightGain Right channel gain (normalized 0.0 - 1.0)
+ * @param leftPan Left channel pan (normalized 0.0 - 1.0)
+ * @param rightPan Right channel pan (normalized 0.0 - 1.0)
+ * @param masterGain Master gain (normalized 0.0 - 1.0)
+ * @return Fused mix matrix
+ * @tparam PanLaw Pan law policy from pan_law.h
+ *
+ * Equivalent to applying channel gain, pan and master gain in sequence.
+ * Gains come from the shared kGainTable and pan gains from the PanLaw
+ * policy (fast_math.h approximations, audio path only).
+ * Coefficients below -120 dB (e.g. cos(π/2) rounding at hard pan)
+ * are flushed to zero so hard L/R panning yields a diagonal matrix.
+ */
+template <typename PanLaw = PanLawConstantPower>
+MixMatrix compileMixMatrix(float leftGain, float rightGain,
+                           float leftPan, float rightPan,
+                           float masterGain) {
+    float masterLinear = tableNormalizedToLinearGain(masterGain);
+    float leftLinear = tableNormalizedToLinearGain(leftGain) * masterLinear;
+    float rightLinear = tableNormalizedToLinearGain(rightGain) * masterLinear;
+
+    PanGains leftPanGains = PanLaw::gains(normalizedToPan(leftPan));
+    PanGains rightPanGains = PanLaw::gains(normalizedToPan(rightPan));
+
+    auto flush = [](float coefficient) {
+        const float kFlushThreshold = 1.0e-6f;  // -120 dB
+        return std::abs(coefficient) < kFlushThreshold ? 0.0f : coefficient;
+    };
+
+    MixMatrix matrix;
+    matrix.leftToLeft = flush(leftLinear * leftPanGains.left);
+    matrix.rightToLeft = flush(rightLinear * rightPanGains.left);
+    matrix.leftToRight = flush(leftLinear * leftPanGains.right);
+    matrix.rightToRight = flush(rightLinear * rightPanGains.right);
+    return matrix;
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
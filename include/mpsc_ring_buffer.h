@@ -0,0 +1,135 @@
+// mpsc_ring_buffer.h
+// Lock-free multiple producer / single consumer record queue (any thread → writer thread)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief Fixed-capacity ring buffer that several threads may push into
+ *
+ * The multi-producer counterpart of SpscRingBuffer, for records that come
+ * from more than one thread (several plugin instances, or the audio and UI
+ * threads of one). Each slot carries a sequence number: a producer claims
+ * the slot at the head with one compare-exchange, copies its record and
+ * publishes it by advancing the slot's sequence. push() is lock-free and
+ * fails instead of waiting when the buffer is full.
+ *
+ * The consumer takes published records in claim order with pop(); it stops
+ * at a slot that has been claimed but not yet written, so a producer that
+ * is preempted mid-copy delays the records behind it but never corrupts
+ * them.
+ *
+ * Storage is part of the object, so nothing is allocated after
+ * construction. Exactly one consumer thread may use it at a time.
+ *
+ * @tparam T Record type (trivially copyable)
+ * @tparam kCapacity Number of slots (power of two)
+ */
+template <typename T, size_t kCapacity>
+class alignas(64) MpscRingBuffer {
+public:
+    static_assert(kCapacity >= 2 && (kCapacity & (kCapacity - 1)) == 0,
+                  "MpscRingBuffer capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MpscRingBuffer records must be trivially copyable");
+    static_assert(std::atomic<size_t>::is_always_lock_free,
+                  "MpscRingBuffer requires a lock-free atomic size_t");
+
+    MpscRingBuffer()
+        : mHead(0)
+        , mTail(0)
+    {
+        for (size_t i = 0; i < kCapacity; ++i)
+            mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    static constexpr size_t capacity() { return kCapacity; }
+
+    //--------------------------------------------------------------------
+    // Producer side (any thread)
+    //--------------------------------------------------------------------
+
+    /**
+     * @brief Append a record (lock-free)
+     * @param record Record to copy into the buffer
+     * @return False if the buffer is full; the record is dropped
+     */
+    bool push(const T& record) {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;) {
+            slot = &mSlots[head & kMask];
+            std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(
+                slot->sequence.load(std::memory_order_acquire) - head);
+            if (lag == 0) {
+                // Free slot: claim it (a failed exchange reloads head)
+                if (mHead.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+                    break;
+            } else if (lag < 0) {
+                // Still holds a record from one lap earlier
+                return false;
+            } else {
+                // Another producer claimed it first
+                head = mHead.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->record = record;
+        slot->sequence.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //--------------------------------------------------------------------
+    // Consumer side
+    //--------------------------------------------------------------------
+
+    /**
+     * @brief Take the oldest published records, in claim order
+     * @param records Receives up to maxCount records
+     * @param maxCount Capacity of records
+     * @return Number of records taken
+     */
+    size_t pop(T* records, size_t maxCount) {
+        size_t count = 0;
+        while (count < maxCount) {
+            Slot& slot = mSlots[mTail & kMask];
+            if (slot.sequence.load(std::memory_order_acquire) != mTail + 1)
+                break;
+
+            records[count++] = slot.record;
+            slot.sequence.store(mTail + kCapacity, std::memory_order_release);
+            ++mTail;
+        }
+        return count;
+    }
+
+private:
+    static constexpr size_t kMask = kCapacity - 1;
+
+    // sequence == position: free for the producer claiming position
+    // sequence == position + 1: written, ready for the consumer
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T record;
+    };
+
+    // Producer line: next position to claim
+    alignas(64) std::atomic<size_t> mHead;
+
+    // Consumer line: next position to read (consumer thread only)
+    alignas(64) size_t mTail;
+
+    alignas(64) Slot mSlots[kCapacity];
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,91 @@
+// pan_law.h
+// Pan law policies for the mix matrix compiler
+//
+// Each policy maps a pan position to left/right gains through a static
+// gains() function. The processor instantiates compileMixMatrix() once per
+// policy and selects the instance per block (see kParamPanLaw), so switching
+// laws never adds a per-sample branch. All laws give exactly 1/0 at hard pan.
+
+#pragma once
+
+#include "plugids.h"
+#include "fast_math.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+namespace PanLawDetail {
+
+/// Pan position (-100 to +100) → 0.0 (full left) to 1.0 (full right)
+inline float panPosition(float pan) {
+    pan = std::max(-100.0f, std::min(100.0f, pan));
+    return (pan + 100.0f) / 200.0f;
+}
+
+} // namespace PanLawDetail
+
+/**
+ * @brief Linear pan law (-6 dB at center)
+ *
+ * Left = 1 - p, Right = p. Amplitudes sum to 1, so correlated signals keep
+ * their level when summed to mono.
+ */
+struct PanLawLinear {
+    static constexpr PanLawType kType = kPanLawLinear;
+
+    static PanGains gains(float pan) {
+        float position = PanLawDetail::panPosition(pan);
+        return {1.0f - position, position};
+    }
+};
+
+/**
+ * @brief Compromise pan law (-4.5 dB at center)
+ *
+ * Geometric mean of the linear and sin/cos laws.
+ */
+struct PanLawCompromise {
+    static constexpr PanLawType kType = kPanLawCompromise;
+
+    static PanGains gains(float pan) {
+        float position = PanLawDetail::panPosition(pan);
+        PanGains constantPower = fastCalculatePanGains(pan);
+        return {std::sqrt((1.0f - position) * constantPower.left),
+                std::sqrt(position * constantPower.right)};
+    }
+};
+
+/**
+ * @brief Constant power pan law (-3 dB at center)
+ *
+ * Left = cos(p·π/2), Right = sin(p·π/2), same law as calculatePanGains().
+ */
+struct PanLawConstantPower {
+    static constexpr PanLawType kType = kPanLawConstantPower;
+
+    static PanGains gains(float pan) {
+        return fastCalculatePanGains(pan);
+    }
+};
+
+/**
+ * @brief Balance law (0 dB at center)
+ *
+ * The far side is attenuated linearly while the near side stays at unity,
+ * like a stereo balance control.
+ */
+struct PanLawBalance {
+    static constexpr PanLawType kType = kPanLawBalance;
+
+    static PanGains gains(float pan) {
+        float position = PanLawDetail::panPosition(pan);
+        return {std::min(1.0f, 2.0f - 2.0f * position),
+                std::min(1.0f, 2.0f * position)};
+    }
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,345 @@
+// parameter_format.h
+// Allocation-free value text for the editor labels and the host (String128)
+//
+// Formatting writes into a caller-provided buffer of char (UTF-8) or
+// Vst::TChar (UTF-16) and never allocates, so hosts drawing many automation
+// lanes and tooltips can call it at a high rate. Parsing accepts what the
+// formatters produce plus plain numbers, with or without units.
+
+#pragma once
+
+#include "parameter_utils.h"
+#include "decimal_text.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+//------------------------------------------------------------------------
+// Formatting
+//------------------------------------------------------------------------
+
+// Buffer size that holds every formatted value, including the terminator
+constexpr int kMaxValueTextLength = 16;
+
+/**
+ * @brief Bounded writer into a NUL-terminated character buffer
+ * @tparam CharT char (UTF-8) or Vst::TChar (UTF-16)
+ *
+ * Text that does not fit is truncated; the buffer is always terminated.
+ */
+template <typename CharT>
+class ValueTextWriter {
+public:
+    ValueTextWriter(CharT* buffer, int size)
+        : mBuffer(buffer)
+        , mCapacity(size - 1)
+        , mLength(0)
+    {
+        if (mCapacity >= 0)
+            mBuffer[0] = 0;
+    }
+
+    void append(char c) {
+        if (mLength < mCapacity) {
+            mBuffer[mLength++] = static_cast<CharT>(c);
+            mBuffer[mLength] = 0;
+        }
+    }
+
+    void append(const char* text) {
+        while (*text)
+            append(*text++);
+    }
+
+    void appendInteger(long value) {
+        char digits[24];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+        for (const char* c = digits; c != result.ptr; ++c)
+            append(*c);
+    }
+
+    // Non-negative value with one decimal ("12.5"), rounded like printf("%.1f")
+    void appendTenths(double value) {
+        // value * 10 is exact for float inputs; nearbyint rounds ties to even
+        long tenths = static_cast<long>(std::nearbyint(value * 10.0));
+        appendInteger(tenths / 10);
+        append('.');
+        append(static_cast<char>('0' + tenths % 10));
+    }
+
+    // "∞": one UTF-16 unit, or three UTF-8 bytes
+    void appendInfinity() {
+        if constexpr (sizeof(CharT) == 1) {
+            append("\xE2\x88\x9E");
+        } else if (mLength < mCapacity) {
+            mBuffer[mLength++] = static_cast<CharT>(0x221E);
+            mBuffer[mLength] = 0;
+        }
+    }
+
+    int length() const { return mLength; }
+
+private:
+    CharT* mBuffer;
+    int mCapacity;  // Characters available before the terminator
+    int mLength;
+};
+
+/**
+ * @brief Pan position as "L50", "C" or "R25"
+ * @param normalized Pan (normalized 0.0 - 1.0)
+ * @param buffer Output buffer (kMaxValueTextLength is always enough)
+ * @param size Buffer size in characters
+ * @return Length of the text
+ */
+template <typename CharT>
+int formatPanText(float normalized, CharT* buffer, int size) {
+    ValueTextWriter<CharT> out(buffer, size);
+    float pan = normalizedToPan(normalized);
+
+    if (std::abs(pan) < 0.5f) {
+        out.append('C');  // Center
+    } else if (pan < 0) {
+        out.append('L');
+        out.appendInteger(static_cast<long>(std::abs(pan) + 0.5f));
+    } else {
+        out.append('R');
+        out.appendInteger(static_cast<long>(pan + 0.5f));
+    }
+    return out.length();
+}
+
+/**
+ * @brief Gain as signed dB with one decimal ("+3.0", "-12.5"), "-∞" at the minimum
+ * @param normalized Gain (normalized 0.0 - 1.0)
+ * @param buffer Output buffer (kMaxValueTextLength is always enough)
+ * @param size Buffer size in characters
+ * @return Length of the text (without unit)
+ */
+template <typename CharT>
+int formatGainText(float normalized, CharT* buffer, int size) {
+    ValueTextWriter<CharT> out(buffer, size);
+    float db = normalizedToDb(normalized);
+
+    if (db <= ParamRange::kGainMin) {
+        out.append('-');
+        out.appendInfinity();
+    } else {
+        out.append(db >= 0 ? '+' : '-');
+        out.appendTenths(std::abs(static_cast<double>(db)));
+    }
+    return out.length();
+}
+
+/**
+ * @brief Delay in ms with one decimal ("25.5")
+ * @param normalized Delay (normalized 0.0 - 1.0)
+ * @param buffer Output buffer (kMaxValueTextLength is always enough)
+ * @param size Buffer size in characters
+ * @return Length of the text (without unit)
+ */
+template <typename CharT>
+int formatDelayText(float normalized, CharT* buffer, int size) {
+    ValueTextWriter<CharT> out(buffer, size);
+    float ms = normalizedToDelayMs(normalized);
+
+    out.appendTenths(std::max(static_cast<double>(ms), 0.0));
+    return out.length();
+}
+
+/**
+ * @brief Percentage with one decimal ("50.0")
+ * @param percent Plain value in percent
+ * @param buffer Output buffer
+ * @param size Buffer size in characters
+ * @return Length of the text
+ */
+template <typename CharT>
+int formatPercentText(double percent, CharT* buffer, int size) {
+    ValueTextWriter<CharT> out(buffer, size);
+    out.appendTenths(std::max(percent, 0.0));
+    return out.length();
+}
+
+/**
+ * @brief On/off switch as "On" or "Off"
+ * @param normalized Switch value (>= 0.5 is on)
+ * @param buffer Output buffer
+ * @param size Buffer size in characters
+ * @return Length of the text
+ */
+template <typename CharT>
+int formatToggleText(double normalized, CharT* buffer, int size) {
+    ValueTextWriter<CharT> out(buffer, size);
+    out.append(normalized >= 0.5 ? "On" : "Off");
+    return out.length();
+}
+
+//------------------------------------------------------------------------
+// Parsing
+//------------------------------------------------------------------------
+
+namespace ValueTextDetail {
+
+using DecimalText::skipSpace;
+using DecimalText::parseDecimal;
+
+template <typename CharT>
+inline CharT toLower(CharT c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<CharT>(c - 'A' + 'a') : c;
+}
+
+// Case-insensitive ASCII prefix match; advances text past the word
+template <typename CharT>
+inline bool matchWord(const CharT*& text, const char* word) {
+    const CharT* p = text;
+    for (; *word; ++word, ++p) {
+        if (toLower(*p) != static_cast<CharT>(*word))
+            return false;
+    }
+    text = p;
+    return true;
+}
+
+// True if only spaces and, optionally, the unit follow
+template <typename CharT>
+inline bool atEnd(const CharT* text, const char* unit) {
+    text = skipSpace(text);
+    if (unit && *text)
+        matchWord(text, unit);
+    return *skipSpace(text) == 0;
+}
+
+} // namespace ValueTextDetail
+
+/**
+ * @brief Parse a pan position: "C", "L50", "R25" or a plain value (-100 to +100)
+ * @param text NUL-terminated text
+ * @param normalized Receives the pan (normalized, clamped)
+ * @return False if the text is not a pan position
+ */
+template <typename CharT>
+bool parsePanText(const CharT* text, float& normalized) {
+    using namespace ValueTextDetail;
+    const CharT* p = skipSpace(text);
+
+    double pan = 0.0;
+    CharT side = toLower(*p);
+    if (side == 'c' && atEnd(p + 1, "enter")) {
+        pan = 0.0;
+    } else if (side == 'l' || side == 'r') {
+        ++p;
+        if (!parseDecimal(p, pan) || !atEnd(p, nullptr))
+            return false;
+        pan = side == 'l' ? -std::abs(pan) : std::abs(pan);
+    } else if (!parseDecimal(p, pan) || !atEnd(p, nullptr)) {
+        return false;
+    }
+
+    normalized = panToNormalized(clampPan(static_cast<float>(pan)));
+    return true;
+}
+
+/**
+ * @brief Parse a gain in dB ("-6", "+3.0 dB"); "-∞" and "-inf" are the minimum
+ * @param text NUL-terminated text
+ * @param normalized Receives the gain (normalized, clamped)
+ * @return False if the text is not a gain
+ */
+template <typename CharT>
+bool parseGainText(const CharT* text, float& normalized) {
+    using namespace ValueTextDetail;
+    const CharT* p = skipSpace(text);
+
+    // Minus infinity, as formatted or typed
+    const CharT* q = p;
+    if (*q == '-')
+        ++q;
+    bool infinity = false;
+    if constexpr (sizeof(CharT) == 1) {
+        infinity = matchWord(q, "\xE2\x88\x9E");
+    } else if (*q == static_cast<CharT>(0x221E)) {
+        infinity = true;
+        ++q;
+    }
+    if (!infinity)
+        infinity = matchWord(q, "inf");
+    if (infinity) {
+        if (!atEnd(q, "db"))
+            return false;
+        normalized = 0.0f;
+        return true;
+    }
+
+    double db = 0.0;
+    if (!parseDecimal(p, db) || !atEnd(p, "db"))
+        return false;
+
+    normalized = dbToNormalized(clampGain(static_cast<float>(db)));
+    return true;
+}
+
+/**
+ * @brief Parse a delay in ms ("25.5", "10 ms")
+ * @param text NUL-terminated text
+ * @param normalized Receives the delay (normalized, clamped)
+ * @return False if the text is not a delay
+ */
+template <typename CharT>
+bool parseDelayText(const CharT* text, float& normalized) {
+    using namespace ValueTextDetail;
+    const CharT* p = text;
+
+    double ms = 0.0;
+    if (!parseDecimal(p, ms) || !atEnd(p, "ms"))
+        return false;
+
+    normalized = delayMsToNormalized(clampDelay(static_cast<float>(ms)));
+    return true;
+}
+
+/**
+ * @brief Parse a percentage ("50", "12.5 %")
+ * @param text NUL-terminated text
+ * @param percent Receives the plain value in percent (not clamped)
+ * @return False if the text is not a number
+ */
+template <typename CharT>
+bool parsePercentText(const CharT* text, double& percent) {
+    using namespace ValueTextDetail;
+    const CharT* p = text;
+    return parseDecimal(p, percent) && atEnd(p, "%");
+}
+
+/**
+ * @brief Parse an on/off switch: "On", "Off" or a number (>= 0.5 is on)
+ * @param text NUL-terminated text
+ * @param normalized Receives 0.0 or 1.0
+ * @return False if the text is not a switch value
+ */
+template <typename CharT>
+bool parseToggleText(const CharT* text, double& normalized) {
+    using namespace ValueTextDetail;
+    const CharT* p = skipSpace(text);
+
+    double value = 0.0;
+    if (matchWord(p, "on")) {
+        value = 1.0;
+    } else if (matchWord(p, "off")) {
+        value = 0.0;
+    } else if (!parseDecimal(p, value)) {
+        return false;
+    }
+    if (!atEnd(p, nullptr))
+        return false;
+
+    normalized = value >= 0.5 ? 1.0 : 0.0;
+    return true;
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
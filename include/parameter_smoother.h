@@ -29,6 +29,8 @@ public:
         , mSmoothingTimeMs(smoothingTimeMs)
         , mSampleRate(48000.0)
         , mAlpha(0.0f)
+        , mDecay(1.0f)
+        , mDecayLength(0)
     {
         updateCoefficient();
     }
@@ -81,6 +83,26 @@ public:
         return mCurrentValue;
     }
 
+    /**
+     * @brief Advance the smoother by several samples at once
+     * @param numSamples Number of samples to advance
+     * @return Smoothed value after the last sample
+     *
+     * Closed form of calling getNext() numSamples times:
+     * y[n+N] = target + (y[n] - target) * (1 - alpha)^N
+     */
+    float advance(int numSamples) {
+        if (numSamples <= 0) {
+            return mCurrentValue;
+        }
+        if (numSamples != mDecayLength) {
+            mDecayLength = numSamples;
+            mDecay = std::pow(1.0f - mAlpha, static_cast<float>(numSamples));
+        }
+        mCurrentValue = mTargetValue + (mCurrentValue - mTargetValue) * mDecay;
+        return mCurrentValue;
+    }
+
     /**
      * @brief Reset to a specific value immediately
      * @param value Value to reset to
@@ -129,6 +151,8 @@ private:
      * where tau is the time constant in seconds.
      */
     void updateCoefficient() {
+        mDecayLength = 0;  // Invalidate cached advance() decay
+
         if (mSampleRate <= 0.0 || mSmoothingTimeMs <= 0.0f) {
             mAlpha = 1.0f;  // No smoothing
             return;
@@ -151,6 +175,8 @@ private:
     float mSmoothingTimeMs;     ///< Smoothing time in milliseconds
     double mSampleRate;         ///< Sample rate in Hz
     float mAlpha;               ///< Smoothing coefficient
+    float mDecay;               ///< Cached (1 - alpha)^mDecayLength for advance()
+    int mDecayLength;           ///< Sample count mDecay was computed for (0 = none)
 };
 
 } // namespace SimplePanner
@@ -0,0 +1,93 @@
+// parameter_snapshot.h
+// Lock-free parameter snapshot published by the audio thread
+
+#pragma once
+
+#include "state_serializer.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief Seqlock protected copy of the processor's parameter values
+ *
+ * A single writer (process(), or setState while inactive) publishes the
+ * current values once per block without ever waiting; any number of
+ * readers (getState, diagnostics) take a consistent copy lock-free, retrying
+ * only if a publish was in progress. Values are stored as atomic 64-bit
+ * patterns so concurrent access is race-free under the C++ memory model.
+ *
+ * alignas(64) gives the snapshot its own cache lines (its size is rounded
+ * up to the alignment), so readers polling it do not disturb the audio
+ * thread's other members.
+ */
+class alignas(64) ParameterSnapshot {
+public:
+    ParameterSnapshot()
+        : mSequence(0)
+        , mGeneration(0)
+    {
+        publish(PluginState::defaults(), 0);
+    }
+
+    ParameterSnapshot(const ParameterSnapshot&) = delete;
+    ParameterSnapshot& operator=(const ParameterSnapshot&) = delete;
+
+    /**
+     * @brief Publish new values (single writer, wait-free)
+     * @param state Current parameter values
+     * @param generation Recall generation the values include (see setState)
+     */
+    void publish(const PluginState& state, uint32 generation) {
+        uint32 sequence = mSequence.load(std::memory_order_relaxed);
+        mSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        mGeneration.store(generation, std::memory_order_relaxed);
+        for (int32 i = 0; i < StateSerializer::kNumFields; ++i) {
+            uint64 bits;
+            std::memcpy(&bits, &state.values[i], sizeof(bits));
+            mValues[i].store(bits, std::memory_order_relaxed);
+        }
+
+        mSequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Read a consistent copy (any thread, lock-free)
+     * @param state Receives the parameter values
+     * @return Recall generation of the values
+     */
+    uint32 read(PluginState& state) const {
+        for (;;) {
+            uint32 before = mSequence.load(std::memory_order_acquire);
+            if (before & 1u) {
+                continue;  // Publish in progress
+            }
+
+            uint32 generation = mGeneration.load(std::memory_order_relaxed);
+            for (int32 i = 0; i < StateSerializer::kNumFields; ++i) {
+                uint64 bits = mValues[i].load(std::memory_order_relaxed);
+                std::memcpy(&state.values[i], &bits, sizeof(bits));
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (mSequence.load(std::memory_order_relaxed) == before) {
+                return generation;
+            }
+        }
+    }
+
+private:
+    static_assert(std::atomic<uint64>::is_always_lock_free, "ParameterSnapshot requires lock-free 64-bit atomics");
+
+    std::atomic<uint32> mSequence;                          ///< Odd while a publish is in progress
+    std::atomic<uint32> mGeneration;                        ///< Recall generation of the values
+    std::atomic<uint64> mValues[StateSerializer::kNumFields];  ///< Bit patterns of PluginState::values
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
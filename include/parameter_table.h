@@ -0,0 +1,182 @@
+// parameter_table.h
+// Single description of every parameter, shared by processor, controller,
+// editor and the component state
+//
+// Each row gives a parameter's ID, name, plain range, default, stepping,
+// display format, smoothing and processor role. Everything else is derived
+// from the table: the default state, the state field order, the controller's
+// Parameter objects and the processor's and editor's dispatch tables.
+// Adding a parameter means adding its ParameterID and one row here.
+
+#pragma once
+
+#include "plugids.h"
+
+namespace Steinberg {
+namespace SimplePanner {
+
+//------------------------------------------------------------------------
+// Display Format (selects the Parameter class and the value text)
+//------------------------------------------------------------------------
+enum ParamFormat {
+    kFormatPan = 0,      // "L50" / "C" / "R25"
+    kFormatGain,         // "+3.0" dB, "-∞" at the minimum
+    kFormatDelay,        // "25.5" ms
+    kFormatToggle,       // "On" / "Off"
+    kFormatList,         // One string per step
+    kFormatPercent,      // 0 - 100 %
+    kParamFormatCount
+};
+
+//------------------------------------------------------------------------
+// Processor Role (what a change of the parameter updates)
+//------------------------------------------------------------------------
+enum ParamRole {
+    kRoleMix = 0,        // Smoothed input of the live mix matrix
+    kRoleGain,           // Channel gain, resolved against Link L/R Gain
+    kRoleDelay,          // Delay target
+    kRoleLink,           // Link L/R Gain switch
+    kRolePanLaw,         // Mix matrix compiler
+    kRoleMorph,          // A/B morph amount (smoothed, blends compiled matrices)
+    kParamRoleCount
+};
+
+/**
+ * @brief Static description of one parameter
+ *
+ * Continuous parameters are linear in their plain range; stepped ones
+ * (stepCount > 0) map step i to minPlain + i.
+ */
+struct ParamDescriptor {
+    Vst::ParamID id;                 ///< ParameterID, equal to the row index
+    const Vst::TChar* title;         ///< Name shown by the host
+    const Vst::TChar* units;         ///< Unit shown by the host
+    ParamFormat format;              ///< Value text and Parameter class
+    float minPlain;                  ///< Plain value at normalized 0
+    float maxPlain;                  ///< Plain value at normalized 1
+    float defaultPlain;              ///< Default plain value
+    int32 stepCount;                 ///< 0 = continuous
+    bool automatable;                ///< Host may automate the parameter
+    bool smoothed;                   ///< Processor glides changes with a ParameterSmoother
+    ParamRole role;                  ///< Processor dispatch
+    const Vst::TChar* const* listEntries = nullptr;  ///< kFormatList: stepCount + 1 names
+};
+
+//------------------------------------------------------------------------
+// Pan Law names (kParamPanLaw steps, order matches PanLawType)
+//------------------------------------------------------------------------
+constexpr const Vst::TChar* kPanLawNames[kPanLawCount] = {
+    STR16("-6 dB Linear"),
+    STR16("-4.5 dB Compromise"),
+    STR16("-3 dB Sin/Cos"),
+    STR16("0 dB Balance"),
+};
+
+//------------------------------------------------------------------------
+// Parameter Table (indexed by ParameterID)
+//------------------------------------------------------------------------
+constexpr ParamDescriptor kParamTable[kParamCount] = {
+    {kParamLeftPan, STR16("Left Pan"), STR16(""), kFormatPan,
+     ParamRange::kPanMin, ParamRange::kPanMax, ParamDefault::kLeftPan, 0, true, true, kRoleMix},
+    {kParamLeftGain, STR16("Left Gain"), STR16("dB"), kFormatGain,
+     ParamRange::kGainMin, ParamRange::kGainMax, ParamDefault::kLeftGain, 0, true, true, kRoleGain},
+    {kParamLeftDelay, STR16("Left Delay"), STR16("ms"), kFormatDelay,
+     ParamRange::kDelayMin, ParamRange::kDelayMax, ParamDefault::kLeftDelay, 0, true, false, kRoleDelay},
+    {kParamRightPan, STR16("Right Pan"), STR16(""), kFormatPan,
+     ParamRange::kPanMin, ParamRange::kPanMax, ParamDefault::kRightPan, 0, true, true, kRoleMix},
+    {kParamRightGain, STR16("Right Gain"), STR16("dB"), kFormatGain,
+     ParamRange::kGainMin, ParamRange::kGainMax, ParamDefault::kRightGain, 0, true, true, kRoleGain},
+    {kParamRightDelay, STR16("Right Delay"), STR16("ms"), kFormatDelay,
+     ParamRange::kDelayMin, ParamRange::kDelayMax, ParamDefault::kRightDelay, 0, true, false, kRoleDelay},
+    {kParamMasterGain, STR16("Master Gain"), STR16("dB"), kFormatGain,
+     ParamRange::kGainMin, ParamRange::kGainMax, ParamDefault::kMasterGain, 0, true, true, kRoleMix},
+    {kParamLinkGain, STR16("Link L/R Gain"), STR16(""), kFormatToggle,
+     0.0f, 1.0f, ParamDefault::kLinkGain, 1, true, false, kRoleLink},
+    {kParamPanLaw, STR16("Pan Law"), STR16(""), kFormatList,
+     0.0f, static_cast<float>(kPanLawCount - 1), static_cast<float>(ParamDefault::kPanLaw), kPanLawCount - 1,
+     true, false, kRolePanLaw, kPanLawNames},
+    {kParamMorph, STR16("A/B Morph"), STR16("%"), kFormatPercent,
+     0.0f, 100.0f, ParamDefault::kMorph * 100.0f, 0, true, true, kRoleMorph},
+};
+
+//------------------------------------------------------------------------
+// Conversions generated from the table
+//------------------------------------------------------------------------
+
+/**
+ * @brief Plain → normalized value of a parameter
+ * @param param Parameter description
+ * @param plain Plain value (not clamped)
+ * @return Normalized value; continuous parameters are computed in float,
+ *         exactly like the per-unit helpers of parameter_utils.h
+ */
+constexpr double plainToNormalized(const ParamDescriptor& param, double plain) {
+    if (param.stepCount > 0) {
+        return (plain - param.minPlain) / param.stepCount;
+    }
+    return (static_cast<float>(plain) - param.minPlain) / (param.maxPlain - param.minPlain);
+}
+
+/**
+ * @brief Normalized → plain value of a parameter
+ * @param param Parameter description
+ * @param normalized Normalized value (0.0 - 1.0)
+ * @return Plain value; stepped parameters return their step
+ */
+constexpr double normalizedToPlain(const ParamDescriptor& param, double normalized) {
+    if (param.stepCount > 0) {
+        // VST3 stepped parameter mapping: min(stepCount, normalized * (stepCount + 1))
+        int32 step = static_cast<int32>(normalized * (param.stepCount + 1));
+        step = step < 0 ? 0 : (step > param.stepCount ? param.stepCount : step);
+        return param.minPlain + step;
+    }
+    return param.minPlain + static_cast<float>(normalized) * (param.maxPlain - param.minPlain);
+}
+
+/**
+ * @brief Default normalized value of a parameter
+ */
+constexpr double defaultNormalized(const ParamDescriptor& param) {
+    return plainToNormalized(param, param.defaultPlain);
+}
+
+/**
+ * @brief Check that every row sits at the index of its ParameterID
+ */
+constexpr bool isParamTableIndexedById() {
+    for (int32 i = 0; i < static_cast<int32>(kParamCount); ++i) {
+        if (kParamTable[i].id != static_cast<Vst::ParamID>(i))
+            return false;
+    }
+    return true;
+}
+
+static_assert(isParamTableIndexedById(), "kParamTable rows must be in ParameterID order");
+
+//------------------------------------------------------------------------
+// Parameter ID lists selected from the table at compile time
+//------------------------------------------------------------------------
+struct ParamIdList {
+    Vst::ParamID ids[kParamCount];
+    int32 count;
+
+    constexpr const Vst::ParamID* begin() const { return ids; }
+    constexpr const Vst::ParamID* end() const { return ids + count; }
+};
+
+/**
+ * @brief IDs of the rows matching a predicate, in ParameterID order
+ * @param predicate constexpr callable taking a const ParamDescriptor&
+ */
+template <typename Predicate>
+constexpr ParamIdList selectParams(Predicate predicate) {
+    ParamIdList list = {};
+    for (const ParamDescriptor& param : kParamTable) {
+        if (predicate(param))
+            list.ids[list.count++] = param.id;
+    }
+    return list;
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
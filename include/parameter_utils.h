@@ -79,6 +79,34 @@ inline float clampDelay(float delay) {
     return std::clamp(delay, ParamRange::kDelayMin, ParamRange::kDelayMax);
 }
 
+//------------------------------------------------------------------------
+// Pan Law Conversion: Normalized (0.0-1.0) ↔ PanLawType (stepped)
+//------------------------------------------------------------------------
+
+inline int normalizedToPanLaw(double normalized) {
+    // VST3 stepped parameter mapping: min(stepCount, normalized * (stepCount + 1))
+    const int kStepCount = kPanLawCount - 1;
+    return std::clamp(static_cast<int>(normalized * (kStepCount + 1)), 0, kStepCount);
+}
+
+inline double panLawToNormalized(int panLaw) {
+    return static_cast<double>(panLaw) / (kPanLawCount - 1);
+}
+
+//------------------------------------------------------------------------
+// Program Conversion: Normalized (0.0-1.0) ↔ program index (stepped)
+//------------------------------------------------------------------------
+
+inline int normalizedToProgram(double normalized, int programCount) {
+    // Same stepped mapping as the program list parameter (stepCount = programCount - 1)
+    const int kStepCount = std::max(programCount - 1, 0);
+    return std::clamp(static_cast<int>(normalized * (kStepCount + 1)), 0, kStepCount);
+}
+
+inline double programToNormalized(int program, int programCount) {
+    return programCount > 1 ? static_cast<double>(program) / (programCount - 1) : 0.0;
+}
+
 //------------------------------------------------------------------------
 // Convenience Functions
 //------------------------------------------------------------------------
@@ -25,9 +25,46 @@ enum ParameterID : Vst::ParamID {
     kParamRightDelay = 5,   // Right channel delay: 0 to 100 ms
     kParamMasterGain = 6,   // Master gain: -60 to +6 dB
     kParamLinkGain = 7,     // Link L/R gain: 0 (off) or 1 (on)
+    kParamPanLaw = 8,       // Pan law: PanLawType (stepped)
+    kParamMorph = 9,        // A/B morph: 0 (current settings) to 1 (snapshot B)
     kParamCount             // Total parameter count
 };
 
+//------------------------------------------------------------------------
+// Program Change (preset bank, not part of the component state)
+//------------------------------------------------------------------------
+constexpr Vst::ParamID kParamProgram = 100;                 // Program list parameter (stepped)
+constexpr Vst::ProgramListID kPresetListId = kParamProgram;  // ProgramList ID == its parameter ID
+
+//------------------------------------------------------------------------
+// A/B Morph Capture (momentary, not part of the component state)
+//------------------------------------------------------------------------
+constexpr Vst::ParamID kParamCaptureB = 101;  // On copies the current settings into snapshot B; process() reports it back to Off
+
+//------------------------------------------------------------------------
+// Output Meters (read-only, reported by process(), not part of the component state)
+// Values use the gain scale: normalized 0.0 = -60 dB (or below), 1.0 = +6 dBFS
+//------------------------------------------------------------------------
+enum MeterID : Vst::ParamID {
+    kParamPeakLeft = 110,   // Left output peak
+    kParamPeakRight = 111,  // Right output peak
+    kParamRmsLeft = 112,    // Left output RMS
+    kParamRmsRight = 113,   // Right output RMS
+};
+constexpr int32 kMeterCount = 4;
+constexpr double kMeterRateHz = 30.0;  // Reports per second of audio
+
+//------------------------------------------------------------------------
+// Pan Laws (kParamPanLaw steps, level of a centered signal per output)
+//------------------------------------------------------------------------
+enum PanLawType {
+    kPanLawLinear = 0,          // -6 dB linear
+    kPanLawCompromise = 1,      // -4.5 dB compromise
+    kPanLawConstantPower = 2,   // -3 dB sin/cos (constant power)
+    kPanLawBalance = 3,         // 0 dB balance
+    kPanLawCount
+};
+
 //------------------------------------------------------------------------
 // Parameter Value Ranges (Plain values, not normalized)
 //------------------------------------------------------------------------
@@ -52,6 +89,8 @@ namespace ParamDefault {
     constexpr float kRightDelay = 0.0f;   // No delay
     constexpr float kMasterGain = 0.0f;   // Unity gain (0dB)
     constexpr float kLinkGain = 0.0f;     // Off
+    constexpr int kPanLaw = kPanLawConstantPower;  // -3 dB sin/cos
+    constexpr float kMorph = 0.0f;        // Current settings only
 }
 
 //------------------------------------------------------------------------
@@ -63,6 +102,13 @@ namespace PluginInfo {
     constexpr const char* kVersion = "1.0.0";
     constexpr const char* kEmail = "info@example.com";
     constexpr const char* kUrl = "https://www.example.com";
+    constexpr const char* kPresetBankEnv = "SIMPLEPANNER_PRESET_BANK";  // Preset bank file path
+    constexpr const char* kDeadlineThresholdsEnv = "SIMPLEPANNER_DEADLINE_THRESHOLDS";  // Percent list, e.g. "10,50,100"
+    constexpr const char* kTraceEnv = "SIMPLEPANNER_TRACE";                    // Chrome trace output file path
+    constexpr const char* kStatsDirEnv = "SIMPLEPANNER_STATS_DIR";             // Workload statistics output directory
+    constexpr const char* kLogEnv = "SIMPLEPANNER_LOG";                        // Log output file path
+    constexpr const char* kCaptureDirEnv = "SIMPLEPANNER_CAPTURE_DIR";         // Session capture output directory
+    constexpr const char* kCaptureAudioEnv = "SIMPLEPANNER_CAPTURE_AUDIO";     // "1": captures include input audio
 }
 
 } // namespace SimplePanner
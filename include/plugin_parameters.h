@@ -0,0 +1,398 @@
+// plugin_parameters.h
+// Parameter classes with plain units and fast host string conversion, and
+// the preset program list that reads its names from the bank
+
+#pragma once
+
+#include "public.sdk/source/vst/vstparameters.h"
+#include "public.sdk/source/vst/vstunits.h"
+#include "pluginterfaces/base/ustring.h"
+#include "parameter_format.h"
+#include "parameter_table.h"
+#include "parameter_utils.h"
+#include "preset_bank.h"
+
+#include <algorithm>
+#include <string>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+//------------------------------------------------------------------------
+// Hosts call toString/fromString through getParamStringByValue and
+// getParamValueByString for every automation lane, tooltip and text entry.
+// These classes format with parameter_format.h straight into the
+// String128, without the printf/allocation round trip of Vst::Parameter,
+// and report plain values (pan, dB, ms) through toPlain/toNormalized.
+// createParameter builds the right class for each kParamTable row.
+//------------------------------------------------------------------------
+
+/**
+ * @brief ParameterInfo flags of a table row
+ */
+inline int32 parameterFlags(const ParamDescriptor& param) {
+    int32 flags = param.automatable ? Vst::ParameterInfo::kCanAutomate : 0;
+    if (param.format == kFormatList)
+        flags |= Vst::ParameterInfo::kIsList;
+    return flags;
+}
+
+/**
+ * @brief Pan position (-100 to +100), shown as "L50" / "C" / "R25"
+ */
+class PanParameter : public Vst::Parameter {
+public:
+    /**
+     * @param param Table row (title, ID, units and default)
+     */
+    explicit PanParameter(const ParamDescriptor& param)
+        : Vst::Parameter(param.title, param.id, param.units, defaultNormalized(param),
+                         param.stepCount, parameterFlags(param))
+    {
+    }
+
+    void toString(Vst::ParamValue valueNormalized, Vst::String128 string) const SMTG_OVERRIDE {
+        formatPanText(static_cast<float>(valueNormalized), string, 128);
+    }
+
+    bool fromString(const Vst::TChar* string, Vst::ParamValue& valueNormalized) const SMTG_OVERRIDE {
+        float normalized = 0.0f;
+        if (!string || !parsePanText(string, normalized))
+            return false;
+        valueNormalized = normalized;
+        return true;
+    }
+
+    Vst::ParamValue toPlain(Vst::ParamValue valueNormalized) const SMTG_OVERRIDE {
+        return normalizedToPan(static_cast<float>(valueNormalized));
+    }
+
+    Vst::ParamValue toNormalized(Vst::ParamValue plainValue) const SMTG_OVERRIDE {
+        return panToNormalized(clampPan(static_cast<float>(plainValue)));
+    }
+};
+
+/**
+ * @brief Gain in dB (-60 to +6), shown as "+3.0" / "-12.5" / "-∞"
+ */
+class GainParameter : public Vst::Parameter {
+public:
+    /**
+     * @param param Table row (title, ID, units and default)
+     */
+    explicit GainParameter(const ParamDescriptor& param)
+        : Vst::Parameter(param.title, param.id, param.units, defaultNormalized(param),
+                         param.stepCount, parameterFlags(param))
+    {
+    }
+
+    void toString(Vst::ParamValue valueNormalized, Vst::String128 string) const SMTG_OVERRIDE {
+        formatGainText(static_cast<float>(valueNormalized), string, 128);
+    }
+
+    bool fromString(const Vst::TChar* string, Vst::ParamValue& valueNormalized) const SMTG_OVERRIDE {
+        float normalized = 0.0f;
+        if (!string || !parseGainText(string, normalized))
+            return false;
+        valueNormalized = normalized;
+        return true;
+    }
+
+    Vst::ParamValue toPlain(Vst::ParamValue valueNormalized) const SMTG_OVERRIDE {
+        return normalizedToDb(static_cast<float>(valueNormalized));
+    }
+
+    Vst::ParamValue toNormalized(Vst::ParamValue plainValue) const SMTG_OVERRIDE {
+        return dbToNormalized(clampGain(static_cast<float>(plainValue)));
+    }
+};
+
+/**
+ * @brief Delay in ms (0 to 100), shown with one decimal
+ */
+class DelayParameter : public Vst::Parameter {
+public:
+    /**
+     * @param param Table row (title, ID, units and default)
+     */
+    explicit DelayParameter(const ParamDescriptor& param)
+        : Vst::Parameter(param.title, param.id, param.units, defaultNormalized(param),
+                         param.stepCount, parameterFlags(param))
+    {
+    }
+
+    void toString(Vst::ParamValue valueNormalized, Vst::String128 string) const SMTG_OVERRIDE {
+        formatDelayText(static_cast<float>(valueNormalized), string, 128);
+    }
+
+    bool fromString(const Vst::TChar* string, Vst::ParamValue& valueNormalized) const SMTG_OVERRIDE {
+        float normalized = 0.0f;
+        if (!string || !parseDelayText(string, normalized))
+            return false;
+        valueNormalized = normalized;
+        return true;
+    }
+
+    Vst::ParamValue toPlain(Vst::ParamValue valueNormalized) const SMTG_OVERRIDE {
+        return normalizedToDelayMs(static_cast<float>(valueNormalized));
+    }
+
+    Vst::ParamValue toNormalized(Vst::ParamValue plainValue) const SMTG_OVERRIDE {
+        return delayMsToNormalized(clampDelay(static_cast<float>(plainValue)));
+    }
+};
+
+/**
+ * @brief Continuous percentage (the row's minPlain to maxPlain), shown with one decimal
+ */
+class PercentParameter : public Vst::Parameter {
+public:
+    /**
+     * @param param Table row (title, ID, units, range and default)
+     */
+    explicit PercentParameter(const ParamDescriptor& param)
+        : Vst::Parameter(param.title, param.id, param.units, defaultNormalized(param),
+                         param.stepCount, parameterFlags(param))
+        , mMinPlain(param.minPlain)
+        , mMaxPlain(param.maxPlain)
+    {
+    }
+
+    void toString(Vst::ParamValue valueNormalized, Vst::String128 string) const SMTG_OVERRIDE {
+        formatPercentText(toPlain(valueNormalized), string, 128);
+    }
+
+    bool fromString(const Vst::TChar* string, Vst::ParamValue& valueNormalized) const SMTG_OVERRIDE {
+        double percent = 0.0;
+        if (!string || !parsePercentText(string, percent))
+            return false;
+        valueNormalized = toNormalized(percent);
+        return true;
+    }
+
+    Vst::ParamValue toPlain(Vst::ParamValue valueNormalized) const SMTG_OVERRIDE {
+        return mMinPlain + valueNormalized * (mMaxPlain - mMinPlain);
+    }
+
+    Vst::ParamValue toNormalized(Vst::ParamValue plainValue) const SMTG_OVERRIDE {
+        double normalized = (plainValue - mMinPlain) / (mMaxPlain - mMinPlain);
+        return std::min(std::max(normalized, 0.0), 1.0);
+    }
+
+private:
+    double mMinPlain;
+    double mMaxPlain;
+};
+
+/**
+ * @brief On/off switch (stepCount 1), shown as "On" / "Off"
+ */
+class ToggleParameter : public Vst::Parameter {
+public:
+    /**
+     * @param title Parameter name
+     * @param tag Parameter ID
+     * @param defaultValue Default (0.0 = off, 1.0 = on)
+     * @param flags Vst::ParameterInfo flags
+     */
+    ToggleParameter(const Vst::TChar* title, Vst::ParamID tag, double defaultValue,
+                    int32 flags = Vst::ParameterInfo::kCanAutomate)
+        : Vst::Parameter(title, tag, STR16(""), defaultValue, 1, flags)
+    {
+    }
+
+    /**
+     * @param param Table row (title, ID and default)
+     */
+    explicit ToggleParameter(const ParamDescriptor& param)
+        : ToggleParameter(param.title, param.id, defaultNormalized(param), parameterFlags(param))
+    {
+    }
+
+    void toString(Vst::ParamValue valueNormalized, Vst::String128 string) const SMTG_OVERRIDE {
+        formatToggleText(valueNormalized, string, 128);
+    }
+
+    bool fromString(const Vst::TChar* string, Vst::ParamValue& valueNormalized) const SMTG_OVERRIDE {
+        return string && parseToggleText(string, valueNormalized);
+    }
+};
+
+/**
+ * @brief Output level meter in dB (-60 to +6), read-only, shown like a gain
+ *
+ * Written only by the processor through outputParameterChanges.
+ */
+class MeterParameter : public Vst::Parameter {
+public:
+    /**
+     * @param title Parameter name
+     * @param tag Meter ID (MeterID)
+     */
+    MeterParameter(const Vst::TChar* title, Vst::ParamID tag)
+        : Vst::Parameter(title, tag, STR16("dB"), 0.0, 0, Vst::ParameterInfo::kIsReadOnly)
+    {
+    }
+
+    void toString(Vst::ParamValue valueNormalized, Vst::String128 string) const SMTG_OVERRIDE {
+        formatGainText(static_cast<float>(valueNormalized), string, 128);
+    }
+
+    bool fromString(const Vst::TChar* /*string*/, Vst::ParamValue& /*valueNormalized*/) const SMTG_OVERRIDE {
+        return false;
+    }
+
+    Vst::ParamValue toPlain(Vst::ParamValue valueNormalized) const SMTG_OVERRIDE {
+        return normalizedToDb(static_cast<float>(valueNormalized));
+    }
+
+    Vst::ParamValue toNormalized(Vst::ParamValue plainValue) const SMTG_OVERRIDE {
+        return dbToNormalized(clampGain(static_cast<float>(plainValue)));
+    }
+};
+
+//------------------------------------------------------------------------
+// Preset bank programs. Names are read from the bank when the host asks
+// for one, so a bank of any size costs nothing per preset in initialize().
+//------------------------------------------------------------------------
+
+/**
+ * @brief Display name of a program: the preset's name, "Preset N" when the
+ *        record has none, "Default" without a bank
+ */
+inline void programName(const PresetBank& bank, int32 index, Vst::String128 string) {
+    std::string name = bank.count() > 0 ? bank.name(index) : std::string("Default");
+    if (name.empty())
+        name = "Preset " + std::to_string(index + 1);
+    UString(string, 128).fromAscii(name.c_str());
+}
+
+/**
+ * @brief Program Change: stepped preset index, shown as the preset's name
+ */
+class ProgramParameter : public Vst::Parameter {
+public:
+    /**
+     * @param title Parameter name (the program list's name)
+     * @param bank Preset bank; must outlive the parameter
+     * @param numPrograms Programs in the list (at least 1)
+     */
+    ProgramParameter(const Vst::TChar* title, const PresetBank& bank, int32 numPrograms)
+        : Vst::Parameter(title, kParamProgram, STR16(""), 0.0, numPrograms - 1,
+                         Vst::ParameterInfo::kIsList | Vst::ParameterInfo::kIsProgramChange)  // Not automated
+        , mBank(bank)
+    {
+    }
+
+    void toString(Vst::ParamValue valueNormalized, Vst::String128 string) const SMTG_OVERRIDE {
+        programName(mBank, static_cast<int32>(toPlain(valueNormalized)), string);
+    }
+
+    // Programs are selected by index; names are not searched
+    bool fromString(const Vst::TChar* /*string*/, Vst::ParamValue& /*valueNormalized*/) const SMTG_OVERRIDE {
+        return false;
+    }
+
+    Vst::ParamValue toPlain(Vst::ParamValue valueNormalized) const SMTG_OVERRIDE {
+        return normalizedToProgram(valueNormalized, info.stepCount + 1);
+    }
+
+    Vst::ParamValue toNormalized(Vst::ParamValue plainValue) const SMTG_OVERRIDE {
+        return programToNormalized(static_cast<int>(plainValue), info.stepCount + 1);
+    }
+
+private:
+    const PresetBank& mBank;
+};
+
+/**
+ * @brief The "Presets" program list: one program per bank record, names
+ *        read from the bank on request instead of stored per program
+ */
+class PresetProgramList : public Vst::ProgramList {
+public:
+    /**
+     * @param title List name
+     * @param listId Program list ID
+     * @param bank Preset bank; must outlive the list
+     */
+    PresetProgramList(const Vst::TChar* title, Vst::ProgramListID listId, const PresetBank& bank)
+        : Vst::ProgramList(title, listId, Vst::kRootUnitId)
+        , mBank(bank)
+    {
+        // Without a bank: the single "Default" program
+        info.programCount = std::max(bank.count(), 1);
+    }
+
+    tresult getProgramName(int32 programIndex, Vst::String128 name) SMTG_OVERRIDE {
+        if (programIndex < 0 || programIndex >= getCount())
+            return kResultFalse;
+        programName(mBank, programIndex, name);
+        return kResultTrue;
+    }
+
+    // No per-program attributes or renaming: nothing is stored per program
+    tresult getProgramInfo(int32 /*programIndex*/, CString /*attributeId*/, Vst::String128 /*value*/) SMTG_OVERRIDE {
+        return kResultFalse;
+    }
+
+    tresult setProgramName(int32 /*programIndex*/, const Vst::String128 /*name*/) SMTG_OVERRIDE {
+        return kResultFalse;
+    }
+
+    bool setProgramInfo(int32 /*programIndex*/, CString /*attributeId*/, const Vst::String128 /*value*/) SMTG_OVERRIDE {
+        return false;
+    }
+
+    Vst::Parameter* getParameter() SMTG_OVERRIDE {
+        if (!parameter)
+            parameter = new ProgramParameter(info.name, mBank, getCount());
+        return parameter;
+    }
+
+private:
+    const PresetBank& mBank;
+};
+
+//------------------------------------------------------------------------
+// Parameter factories indexed by ParamFormat
+//------------------------------------------------------------------------
+using ParameterFactory = Vst::Parameter* (*)(const ParamDescriptor& param);
+
+template <typename ParameterT>
+Vst::Parameter* createFormattedParameter(const ParamDescriptor& param) {
+    return new ParameterT(param);
+}
+
+// Stepped list, one entry per step
+inline Vst::Parameter* createListParameter(const ParamDescriptor& param) {
+    Vst::StringListParameter* list = new Vst::StringListParameter(param.title, param.id, param.units,
+                                                                  parameterFlags(param));
+    for (int32 i = 0; i <= param.stepCount; ++i)
+        list->appendString(param.listEntries[i]);
+    list->getInfo().defaultNormalizedValue = defaultNormalized(param);
+    list->setNormalized(defaultNormalized(param));
+    return list;
+}
+
+constexpr ParameterFactory kParameterFactories[kParamFormatCount] = {
+    &createFormattedParameter<PanParameter>,      // kFormatPan
+    &createFormattedParameter<GainParameter>,     // kFormatGain
+    &createFormattedParameter<DelayParameter>,    // kFormatDelay
+    &createFormattedParameter<ToggleParameter>,   // kFormatToggle
+    &createListParameter,                         // kFormatList
+    &createFormattedParameter<PercentParameter>,  // kFormatPercent
+};
+static_assert(kFormatPan == 0 && kFormatGain == 1 && kFormatDelay == 2 && kFormatToggle == 3
+              && kFormatList == 4 && kFormatPercent == 5 && kParamFormatCount == 6,
+              "kParameterFactories must be indexed by ParamFormat");
+
+/**
+ * @brief Create the controller's Parameter object for a table row
+ */
+inline Vst::Parameter* createParameter(const ParamDescriptor& param) {
+    return kParameterFactories[param.format](param);
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
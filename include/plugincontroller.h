@@ -1,15 +1,20 @@
 #pragma once
 
 #include "public.sdk/source/vst/vsteditcontroller.h"
-#include "pluginterfaces/base/ustring.h"
+#include "state_serializer.h"
+#include "preset_bank.h"
+#include "mapped_file.h"
+#include "process_timing.h"
 
 namespace Steinberg {
 namespace SimplePanner {
 
+class SimplePannerEditor;
+
 //------------------------------------------------------------------------
 // SimplePannerController
 //------------------------------------------------------------------------
-class SimplePannerController : public Vst::EditController
+class SimplePannerController : public Vst::EditControllerEx1
 {
 public:
     SimplePannerController();
@@ -22,11 +27,45 @@ public:
     tresult PLUGIN_API setParamNormalized(Vst::ParamID tag, Vst::ParamValue value) SMTG_OVERRIDE;
     IPlugView* PLUGIN_API createView(const char* name) SMTG_OVERRIDE;
 
+    // Processor telemetry (IConnectionPoint, main thread)
+    tresult PLUGIN_API notify(Vst::IMessage* message) SMTG_OVERRIDE;
+
+    // Ask the processor for the records queued since the last request; the
+    // answer arrives through notify(). Called by the open editor's timer.
+    void requestTelemetry();
+
+    // Latest process() timing summary from the processor (blocks == 0: none yet)
+    const ProcessTimingSummary& getProcessTiming() const { return mProcessTiming; }
+
+    // Editor tracking (called by EditorView when attached to / removed from a parent)
+    void editorAttached(Vst::EditorView* editor) SMTG_OVERRIDE;
+    void editorRemoved(Vst::EditorView* editor) SMTG_OVERRIDE;
+
+    // Preset bank (memory-mapped, exposed as the "Presets" program list).
+    // initialize() maps PluginInfo::kPresetBankEnv unless a bank was loaded before.
+    bool loadPresetBank(const char* path);
+    const PresetBank& getPresetBank() const { return mPresetBank; }
+
     // Create function
     static FUnknown* createInstance(void* /*context*/)
     {
         return (Vst::IEditController*)new SimplePannerController;
     }
+
+protected:
+    // Apply a whole state: Link L/R Gain resolved once, one editor refresh
+    void applyComponentState(const PluginState& state);
+
+    // Apply preset index of the program list (bank record, or defaults without
+    // a bank), then notify the host once with kParamValuesChanged
+    void applyProgram(int32 index);
+
+private:
+    SimplePannerEditor* mEditor;  // Open editor, if any
+    MappedFile mPresetFile;       // Mapped preset bank file
+    PresetBank mPresetBank;       // View of mPresetFile
+    ProcessTimingSummary mProcessTiming;  // Last telemetry received
+    uint32 mTraceInstance;                // Object number in trace events
 };
 
 } // namespace SimplePanner
@@ -3,12 +3,50 @@
 #include "public.sdk/source/vst/vstguieditor.h"
 #include "vstgui/vstgui.h"
 #include "plugids.h"
+#include "parameter_table.h"
+#include "process_timing.h"
+#include "stereo_analyzer.h"
 
 namespace Steinberg {
 namespace SimplePanner {
 
 using namespace VSTGUI;
 
+//------------------------------------------------------------------------
+// LevelMeterView - Horizontal output meter (RMS bar, peak marker)
+//------------------------------------------------------------------------
+class LevelMeterView : public CView
+{
+public:
+    explicit LevelMeterView(const CRect& size);
+
+    // Normalized meter values (gain scale, 0.0 = -60 dB, 1.0 = +6 dB)
+    void setLevels(float peak, float rms);
+
+    void draw(CDrawContext* context) SMTG_OVERRIDE;
+
+private:
+    float mPeak;
+    float mRms;
+};
+
+//------------------------------------------------------------------------
+// StereoScopeView - Goniometer (mid up, sides across) and correlation bar
+//------------------------------------------------------------------------
+class StereoScopeView : public CView
+{
+public:
+    explicit StereoScopeView(const CRect& size);
+
+    // Show one analysis frame (copied; at most kScopePoints points)
+    void setFrame(const ScopeFrame& frame);
+
+    void draw(CDrawContext* context) SMTG_OVERRIDE;
+
+private:
+    ScopeFrame mFrame;
+};
+
 //------------------------------------------------------------------------
 // SimplePannerEditor - Custom GUI Editor
 //------------------------------------------------------------------------
@@ -27,6 +65,12 @@ public:
     void controlBeginEdit(CControl* control) SMTG_OVERRIDE;
     void controlEndEdit(CControl* control) SMTG_OVERRIDE;
 
+    //--- Controller → GUI ---------------
+    void syncAllParameters();
+    void updateProcessTiming(const ProcessTimingSummary& summary);
+    void updateMeters();
+    void updateStereoScope(const ScopeFrame& frame);
+
 protected:
     //--- GUI Creation -------------------
     bool createUI();
@@ -36,6 +80,13 @@ protected:
     std::string formatPanValue(float normalized);
     std::string formatGainValue(float normalized);
     std::string formatDelayValue(float normalized);
+    std::string formatTimingValue(const ProcessTimingSummary& summary);
+
+    // Label text formatter for one ParamFormat (nullptr: no value label)
+    using ValueFormatter = std::string (SimplePannerEditor::*)(float normalized);
+
+    // Value label formatters indexed by ParamFormat
+    static const ValueFormatter kValueFormatters[kParamFormatCount];
 
 private:
     //--- GUI Controls -------------------
@@ -56,6 +107,20 @@ private:
     CTextLabel* mLeftDelayLabel;
     CTextLabel* mRightDelayLabel;
     CTextLabel* mMasterGainLabel;
+    CTextLabel* mTimingLabel;         // process() telemetry (read-only)
+
+    //--- Output Meters (read-only) ------
+    LevelMeterView* mLeftMeter;
+    LevelMeterView* mRightMeter;
+    StereoScopeView* mStereoScope;
+
+    //--- Telemetry ----------------------
+    SharedPointer<CVSTGUITimer> mTelemetryTimer;  // Polls the processor while open
+
+    uint32 mTraceInstance;            // Object number in trace events
+
+    // Value label of each parameter, indexed by ParameterID (nullptr: none)
+    static CTextLabel* SimplePannerEditor::* const kValueLabels[kParamCount];
 };
 
 } // namespace SimplePanner
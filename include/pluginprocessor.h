@@ -3,6 +3,23 @@
 #include "public.sdk/source/vst/vstaudioeffect.h"
 #include "delay_line.h"
 #include "parameter_smoother.h"
+#include "mix_matrix.h"
+#include "state_serializer.h"
+#include "parameter_table.h"
+#include "triple_buffer.h"
+#include "parameter_snapshot.h"
+#include "process_timing.h"
+#include "spsc_ring_buffer.h"
+#include "level_meter.h"
+#include "stereo_analyzer.h"
+#include "workload_stats.h"
+#include "session_capture.h"
+#include "preset_table.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace Steinberg {
 namespace SimplePanner {
@@ -32,27 +49,228 @@ public:
         return (Vst::IAudioProcessor*)new SimplePannerProcessor;
     }
 
+    // Parameter values as of the last processed block (any thread, lock-free)
+    PluginState getParameterSnapshot() const;
+
+    // Use a preset bank as the program table (initialize() uses
+    // PluginInfo::kPresetBankEnv); the table is shared with other instances
+    // of the same bank. Only while inactive. Without a bank the table holds
+    // a single "Default" program; returns false in that case.
+    bool loadPresetTable(const char* path);
+
+    // Program table in use and the bank file it came from ("": no bank)
+    const PresetTable& getPresetTable() const { return *mPresetTable; }
+    const std::string& getPresetBankPath() const { return mPresetBankPath; }
+
+    // Blocks that came close to or missed their deadline since activation
+    // (any thread, lock-free)
+    DeadlineCounters getDeadlineCounters() const;
+
+    // Deadline thresholds as fractions of a block's audio time, ascending
+    // (initialize() uses PluginInfo::kDeadlineThresholdsEnv). Only while inactive.
+    void setDeadlineThresholds(const double thresholds[kDeadlineLevels]);
+
+    // Directory that terminate() writes the workload statistics to
+    // (initialize() uses PluginInfo::kStatsDirEnv); nullptr or "" turns
+    // collection off. Only while inactive.
+    void setWorkloadStatsDirectory(const char* directory);
+
+    // File terminate() writes: "<directory>/workload-<pid>-<instance>.json",
+    // empty while collection is off
+    std::string getWorkloadStatsPath() const;
+
+    // Record setupProcessing, setActive, recalled states and every block to
+    // a capture file for offline replay (session_replay.h). initialize()
+    // starts a capture in PluginInfo::kCaptureDirEnv, named like the workload
+    // statistics ("capture-<pid>-<instance>.spcap"); terminate() stops it.
+    // Only while inactive. Returns false if the file cannot be created.
+    bool startCapture(const char* path, bool withAudio);
+    void stopCapture();
+
+    // IConnectionPoint: answers the controller's TelemetryPoll with the
+    // queued audio thread records (host message thread)
+    tresult PLUGIN_API notify(Vst::IMessage* message) SMTG_OVERRIDE;
+
 protected:
+    // State recalled by setState, tagged with its recall generation
+    struct RecalledState {
+        PluginState state;
+        uint32 generation;
+    };
+
+    // Program change queued by process(), applied at its sample offset
+    struct ProgramChange {
+        int32 sampleOffset;
+        int32 program;
+    };
+
+    // Last Left/Right Gain change of a block, resolved against Link L/R Gain
+    struct GainChange {
+        bool changed;
+        int32 sampleOffset;
+        Vst::ParamValue value;
+    };
+
+    // Program changes kept per block (later ones replace the last entry)
+    static constexpr int32 kMaxProgramChanges = 16;
+
+    // Specialized processing kernel, selected once per segment
+    using ProcessKernel = void (SimplePannerProcessor::*)(const float* inL, const float* inR,
+                                                          float* outL, float* outR, int32 numSamples,
+                                                          const MixMatrix& target);
+
+    template <bool kDelayActive, bool kRamp, bool kDiagonal>
+    void processKernel(const float* inL, const float* inR, float* outL, float* outR, int32 numSamples,
+                       const MixMatrix& target);
+
+    // Parameter change handler for one ParamRole (last point of the block's queue)
+    using ParamHandler = void (SimplePannerProcessor::*)(Vst::ParamID id, int32 sampleOffset,
+                                                         Vst::ParamValue value);
+
+    void onSmoothedChange(Vst::ParamID id, int32 sampleOffset, Vst::ParamValue value);
+    void onGainChange(Vst::ParamID id, int32 sampleOffset, Vst::ParamValue value);
+    void onDelayChange(Vst::ParamID id, int32 sampleOffset, Vst::ParamValue value);
+    void onLinkChange(Vst::ParamID id, int32 sampleOffset, Vst::ParamValue value);
+    void onPanLawChange(Vst::ParamID id, int32 sampleOffset, Vst::ParamValue value);
+
+    // Parameter change handlers indexed by ParamRole
+    static const ParamHandler kParamHandlers[kParamRoleCount];
+
+    void processAudio(Vst::ProcessData& data);
+    void analyzeOutput(Vst::ProcessData& data);
+    void reportOutputMeters(Vst::IParameterChanges* outputChanges, int32 sampleOffset);
+    void recordProcessTiming(std::chrono::steady_clock::time_point blockStart, int32 numSamples);
+    void sendTelemetry();
+    void capturePresetBank();
+
+    // "<directory>/<prefix>-<pid>-<instance><extension>": one file per instance
+    std::string instanceFilePath(const std::string& directory, const char* prefix, const char* extension) const;
+
+    // Drain a record queue into one message to the controller (telemetry timer)
+    template <typename T, size_t kCapacity>
+    void sendRecords(FIDString messageId, SpscRingBuffer<T, kCapacity>& queue);
+    void queueProgramChanges(Vst::IParamValueQueue* queue);
+    void applyProgramChanges(int32 sampleOffset);
+    void applyProgram(int32 program);
+    void applyGainChanges(Vst::IParameterChanges* outputChanges);
+    void unshareGainSmoother();
+    bool isGainLinked() const { return mParams[kParamLinkGain] >= 0.5; }
+    void applyState(const PluginState& state);
+    bool applyPendingState();
+    PluginState currentState() const;
+    void captureSnapshotB();
+    void compileSnapshotB();
+    void updateDelayTargets();
+    void applyDelays();
+    bool isSmoothing() const;
+    bool isSmoothingLive() const;
+    MixMatrix updateMixMatrix(bool smoothing, int32 numSamples);
+    ProcessKernel selectKernel(const MixMatrix& target) const;
+
+    // Kernel dispatch table, indexed by the feature flags
+    static const ProcessKernel kProcessKernels[8];
+
+    // Mix matrix compiler for one pan law, selected when the law changes
+    using MatrixCompiler = MixMatrix (*)(float leftGain, float rightGain,
+                                         float leftPan, float rightPan, float masterGain);
+
+    // Matrix compilers indexed by PanLawType
+    static const MatrixCompiler kMatrixCompilers[kPanLawCount];
+
+    // Maximum matrix ramp length while smoothing (samples)
+    static constexpr int32 kRampLength = 32;
+
     // Delay lines
     DelayLine mDelayLeft;
     DelayLine mDelayRight;
 
-    // Parameter smoothers
-    ParameterSmoother mLeftPanSmoother;
-    ParameterSmoother mLeftGainSmoother;
-    ParameterSmoother mRightPanSmoother;
-    ParameterSmoother mRightGainSmoother;
-    ParameterSmoother mMasterGainSmoother;
-
-    // Current parameter values (normalized 0.0 - 1.0)
-    double mLeftPan;
-    double mLeftGain;
-    double mLeftDelay;
-    double mRightPan;
-    double mRightGain;
-    double mRightDelay;
-    double mMasterGain;
-    double mLinkGain;
+    // Delayed input scratch buffers (allocated in setActive)
+    std::vector<float> mScratchLeft;
+    std::vector<float> mScratchRight;
+
+    // Parameter smoothers indexed by ParameterID (used for rows with smoothed set)
+    ParameterSmoother mSmoothers[kParamCount];
+
+    // While Link L/R Gain is on and both gains have met, the Left Gain
+    // smoother drives both gains and the Right Gain smoother is idle
+    bool mGainSmootherShared;
+
+    // Left/Right Gain changes and link engagement of the current block
+    GainChange mLeftGainChange;
+    GainChange mRightGainChange;
+    bool mLinkEngaged;
+
+    // Compiled mix matrix in effect at the end of the last processed segment
+    MixMatrix mMixMatrix;
+    bool mMixMatrixDirty;
+    MatrixCompiler mCompileMixMatrix;
+
+    // A/B morph: snapshot B is compiled once and blended with the live
+    // settings (A) as compiled matrices and delay targets, so morphing never
+    // re-runs the parameter conversions
+    double mSnapshotB[kParamCount];  // Normalized values of snapshot B
+    MixMatrix mMixMatrixA;           // Compiled from the live smoothers
+    MixMatrix mMixMatrixB;           // Compiled from snapshot B
+    double mDelaySamplesA[2];        // Left/right delay targets of A (samples)
+    double mDelaySamplesB[2];        // Left/right delay targets of B (samples)
+
+    // State recalled by setState, applied by process() at block start or by
+    // setActive(true), never both at once (its only consumers)
+    TripleBuffer<RecalledState> mPendingState;
+
+    // Parameter values published by process() once per block for other threads
+    ParameterSnapshot mParameterSnapshot;
+    uint32 mAppliedGeneration;      // Last recall applied (audio thread)
+
+    // Last recall requested by setState (setState/getState thread)
+    uint32 mRecallGeneration;
+    PluginState mLastRecalled;
+
+    // process() timing: measured per block by the audio thread, summarized
+    // once per kTimingPeriodMs of audio and sent when the controller polls
+    static constexpr uint32 kTimingPeriodMs = 250;
+    ProcessTimingStats mProcessTiming;
+    DeadlineWatchdog mDeadlineWatchdog;
+    SpscRingBuffer<ProcessTimingSummary, TimingMessage::kMaxRecords> mTimingQueue;  // Audio thread → notify()
+
+    // Stereo scope: correlation and goniometer points, one frame per
+    // 1/kScopeFrameRateHz of audio
+    StereoAnalyzer mStereoAnalyzer;
+    SpscRingBuffer<ScopeFrame, ScopeMessage::kMaxRecords> mScopeQueue;  // Audio thread → notify()
+
+    // Trace events (TraceRecorder, when enabled): every call of the
+    // lifecycle methods, but only one process() block in kTraceBlockInterval
+    static constexpr uint32 kTraceBlockInterval = 16;
+    uint32 mTraceInstance;
+    uint32 mTraceBlockCount;
+
+    // Workload histograms of every block, collected while a statistics
+    // directory is set and written by terminate()
+    WorkloadStats mWorkloadStats;
+    std::string mWorkloadStatsDir;
+    bool mCollectWorkloadStats;
+
+    // Session capture, while one is running (started and stopped only while inactive)
+    std::unique_ptr<SessionCapture> mCapture;
+
+    // Output meters: peak and RMS per channel over 1/kMeterRateHz of audio,
+    // reported through outputParameterChanges when a value changes
+    LevelMeter mOutputMeters[2];
+    float mReportedMeters[kMeterCount];  // Last values reported, indexed by MeterID - kParamPeakLeft
+
+    // Program table (shared with every instance using the same bank; replaced
+    // only by loadPresetTable, never by process())
+    std::shared_ptr<const PresetTable> mPresetTable;
+    std::string mPresetBankPath;    // Recorded in session captures
+
+    // Program changes of the current block, in sample order
+    ProgramChange mProgramChanges[kMaxProgramChanges];
+    int32 mNumProgramChanges;
+    int32 mNextProgramChange;
+
+    // Current parameter values (normalized 0.0 - 1.0), indexed by ParameterID
+    double mParams[kParamCount];
+    double mCaptureB;               // Last Capture B value (captures on Off → On, then Off)
 
     // Processing state
     double mSampleRate;
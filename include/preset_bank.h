@@ -0,0 +1,179 @@
+// preset_bank.h
+// Preset bank file: fixed-size preset records that are used in place
+//
+// Header (16 bytes):
+//     char magic[4] = "SPPB", uint32 version = 1, uint32 presetCount,
+//     uint32 fieldCount (>= 8)
+// Record (32 + fieldCount * 8 bytes, presetCount times):
+//     char name[32] (ASCII, NUL padded), fieldCount parameter values in
+//     ParameterID order (same value layout as state chunk v1)
+//
+// All values are little-endian. Records have a fixed size, so preset i is
+// found by pointer arithmetic; nothing is parsed when a bank is opened.
+
+#pragma once
+
+#include "state_serializer.h"
+
+#include <cstring>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief One preset, used to build a bank
+ */
+struct PresetBankEntry {
+    std::string name;   ///< Truncated to PresetBank::kNameSize - 1 characters
+    PluginState state;  ///< Normalized parameter values
+};
+
+/**
+ * @brief Read-only view of a preset bank held in memory (typically a MappedFile)
+ *
+ * The view does not own the bank data; it must stay valid while attached.
+ */
+class PresetBank {
+public:
+    static constexpr uint32 kMagic = 0x42505053;  ///< "SPPB" read as little-endian uint32
+    static constexpr uint32 kVersion = 1;
+    static constexpr size_t kHeaderSize = 4 * sizeof(uint32);
+    static constexpr size_t kNameSize = 32;
+    static constexpr int32 kMaxPresets = 1 << 20;  ///< Upper bound accepted from a bank
+
+    PresetBank()
+        : mData(nullptr)
+        , mCount(0)
+        , mNumFields(0)
+        , mRecordSize(0)
+    {
+    }
+
+    /**
+     * @brief Attach to bank data, checking only the header and the total size
+     * @param data Bank data
+     * @param size Number of valid bytes in data
+     * @return True if data holds a complete bank; the view is detached otherwise
+     */
+    bool attach(const uint8* data, size_t size) {
+        detach();
+        if (!data || size < kHeaderSize) {
+            return false;
+        }
+        if (StateSerializer::loadUInt32(data) != kMagic
+            || StateSerializer::loadUInt32(data + 4) != kVersion) {
+            return false;
+        }
+
+        uint32 count = StateSerializer::loadUInt32(data + 8);
+        uint32 numFields = StateSerializer::loadUInt32(data + 12);
+        if (numFields < static_cast<uint32>(StateSerializer::kVersion1Fields)
+            || numFields > static_cast<uint32>(StateSerializer::kMaxFields)
+            || count > static_cast<uint32>(kMaxPresets)) {
+            return false;
+        }
+
+        size_t recordSize = recordSizeFor(static_cast<int32>(numFields));
+        if ((size - kHeaderSize) / recordSize < count) {
+            return false;
+        }
+
+        mData = data;
+        mCount = static_cast<int32>(count);
+        mNumFields = static_cast<int32>(numFields);
+        mRecordSize = recordSize;
+        return true;
+    }
+
+    /**
+     * @brief Detach from the bank data
+     */
+    void detach() {
+        mData = nullptr;
+        mCount = 0;
+        mNumFields = 0;
+        mRecordSize = 0;
+    }
+
+    bool isAttached() const { return mData != nullptr; }
+    int32 count() const { return mCount; }
+    int32 numFields() const { return mNumFields; }
+
+    /**
+     * @brief Name of a preset
+     * @param index Preset index (0 to count() - 1)
+     * @return Preset name, empty for an invalid index
+     */
+    std::string name(int32 index) const {
+        if (index < 0 || index >= mCount) {
+            return std::string();
+        }
+        const char* field = reinterpret_cast<const char*>(record(index));
+        return std::string(field, std::find(field, field + kNameSize, '\0'));
+    }
+
+    /**
+     * @brief Copy a preset's values (O(1), no allocation)
+     * @param index Preset index (0 to count() - 1)
+     * @param state Receives the parameter values; parameters the bank lacks
+     *              and snapshot B are left untouched
+     * @return False for an invalid index
+     */
+    bool load(int32 index, PluginState& state) const {
+        if (index < 0 || index >= mCount) {
+            return false;
+        }
+        const uint8* in = record(index) + kNameSize;
+        int32 numKnown = std::min(mNumFields, StateSerializer::kNumParams);
+        for (int32 i = 0; i < numKnown; ++i) {
+            state.values[i] = StateSerializer::loadDouble(in + i * sizeof(double));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Encode presets as a bank file image
+     * @param entries Presets in program order
+     * @return Bank data (written by this version: fieldCount = kParamCount)
+     */
+    static std::vector<uint8> build(const std::vector<PresetBankEntry>& entries) {
+        size_t recordSize = recordSizeFor(StateSerializer::kNumParams);
+        std::vector<uint8> data(kHeaderSize + entries.size() * recordSize, 0);
+
+        uint8* out = data.data();
+        out = StateSerializer::storeUInt32(out, kMagic);
+        out = StateSerializer::storeUInt32(out, kVersion);
+        out = StateSerializer::storeUInt32(out, static_cast<uint32>(entries.size()));
+        out = StateSerializer::storeUInt32(out, static_cast<uint32>(StateSerializer::kNumParams));
+
+        for (const PresetBankEntry& entry : entries) {
+            std::memcpy(out, entry.name.data(), std::min(entry.name.size(), kNameSize - 1));
+            out += kNameSize;
+            for (int32 i = 0; i < StateSerializer::kNumParams; ++i) {
+                out = StateSerializer::storeDouble(out, entry.state.values[i]);
+            }
+        }
+        return data;
+    }
+
+private:
+    static size_t recordSizeFor(int32 numFields) {
+        return kNameSize + static_cast<size_t>(numFields) * sizeof(double);
+    }
+
+    const uint8* record(int32 index) const {
+        return mData + kHeaderSize + static_cast<size_t>(index) * mRecordSize;
+    }
+
+    const uint8* mData;   ///< Bank data, nullptr if detached
+    int32 mCount;         ///< Number of presets
+    int32 mNumFields;     ///< Values per record
+    size_t mRecordSize;   ///< Bytes per record
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,120 @@
+// preset_table.h
+// Preset bank values copied into memory once per module and shared by every
+// processor instance that loads the same bank
+
+#pragma once
+
+#include "preset_bank.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief Immutable program table: one PluginState per preset of a bank
+ *
+ * The values are copied out of the file mapping, so the audio thread never
+ * page-faults on it. Tables are handed out as shared_ptr<const PresetTable>;
+ * instances loading the same bank path share one copy, which is freed when
+ * the last of them lets go.
+ */
+class PresetTable {
+public:
+    /**
+     * @brief Table with the single "Default" program (all defaults)
+     */
+    PresetTable()
+        : mPrograms(1, PluginState::defaults())
+        , mNumFields(StateSerializer::kNumParams)
+        , mChecksum(0)
+    {
+    }
+
+    /**
+     * @brief Copy every preset of a bank
+     * @param bank Attached bank with at least one preset
+     * @param checksum StateSerializer::checksum() of the whole bank file
+     */
+    PresetTable(const PresetBank& bank, uint32 checksum)
+        : mPrograms(static_cast<size_t>(bank.count()), PluginState::defaults())
+        , mNumFields(std::min(bank.numFields(), StateSerializer::kNumParams))
+        , mChecksum(checksum)
+    {
+        for (int32 i = 0; i < bank.count(); ++i) {
+            bank.load(i, mPrograms[i]);
+        }
+    }
+
+    int32 count() const { return static_cast<int32>(mPrograms.size()); }
+
+    /// Leading fields a program sets; later ones keep their current values
+    int32 numFields() const { return mNumFields; }
+
+    /// FNV-1a of the bank file the table was copied from (0: no bank)
+    uint32 checksum() const { return mChecksum; }
+
+    /**
+     * @brief Values of a program (O(1), no allocation)
+     * @param index Program index (0 to count() - 1)
+     */
+    const PluginState& program(int32 index) const { return mPrograms[index]; }
+
+    /**
+     * @brief The shared single-program table used without a bank
+     */
+    static std::shared_ptr<const PresetTable> defaults() {
+        static const std::shared_ptr<const PresetTable> table = std::make_shared<const PresetTable>();
+        return table;
+    }
+
+    /**
+     * @brief Table of a bank file, copied on the first request for its path
+     *        while no other instance holds it (any thread except the audio thread)
+     * @param path Bank file path (UTF-8)
+     * @return nullptr if the file cannot be mapped or holds no preset
+     */
+    static std::shared_ptr<const PresetTable> share(const char* path) {
+        if (!path || !*path) {
+            return nullptr;
+        }
+
+        static std::mutex mutex;
+        static std::map<std::string, std::weak_ptr<const PresetTable>> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<const PresetTable> table = tables[path].lock();
+        if (table) {
+            return table;
+        }
+
+        MappedFile file;
+        PresetBank bank;
+        if (file.open(path) && bank.attach(file.data(), file.size()) && bank.count() > 0) {
+            table = std::make_shared<const PresetTable>(bank, StateSerializer::checksum(file.data(), file.size()));
+        }
+
+        // Forget banks nobody holds any more
+        for (auto it = tables.begin(); it != tables.end();) {
+            it = it->second.expired() ? tables.erase(it) : std::next(it);
+        }
+        if (table) {
+            tables[path] = table;
+        }
+        return table;
+    }
+
+private:
+    std::vector<PluginState> mPrograms;  ///< Values per program, in program order
+    int32 mNumFields;                    ///< Leading fields a program sets
+    uint32 mChecksum;                    ///< Identifies the bank file (0: no bank)
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
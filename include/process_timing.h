@@ -0,0 +1,315 @@
+// process_timing.h
+// Per-block process() timing statistics and their telemetry message
+//
+// The audio thread adds one duration per block to ProcessTimingStats and
+// DeadlineWatchdog and, once per period, queues a ProcessTimingSummary
+// (min/mean/p99/max, load and deadline use). The processor sends the queued
+// summaries to the controller as an IMessage from a main-thread timer,
+// never from process().
+
+#pragma once
+
+#include "pluginterfaces/base/ftypes.h"
+#include "decimal_text.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+// Deadline thresholds counted by DeadlineWatchdog
+constexpr int32 kDeadlineLevels = 3;
+
+// Default thresholds, as fractions of a block's deadline
+constexpr double kDefaultDeadlineThresholds[kDeadlineLevels] = {0.1, 0.5, 1.0};
+
+//------------------------------------------------------------------------
+// Summary of one measurement period
+//------------------------------------------------------------------------
+struct ProcessTimingSummary {
+    int64 blocks;         ///< process() calls measured (0 = no data)
+    double minMicros;     ///< Fastest block
+    double meanMicros;    ///< Mean block time
+    double p99Micros;     ///< 99th percentile (upper bound, within 1/8 octave)
+    double maxMicros;     ///< Slowest block
+    double load;          ///< Processing time / audio time (1.0 = real time)
+    double maxDeadlineUse;                    ///< Slowest block time / its deadline
+    int64 deadlineExceeded[kDeadlineLevels];  ///< Blocks over each threshold since activation
+};
+
+//------------------------------------------------------------------------
+// Deadline counters since activation
+//------------------------------------------------------------------------
+struct DeadlineCounters {
+    int64 blocks;                           ///< Blocks with audio
+    int64 exceeded[kDeadlineLevels];        ///< Blocks over each threshold
+    double thresholds[kDeadlineLevels];     ///< Fractions of the deadline, ascending
+    double worstUse;                        ///< Slowest block time / its deadline
+};
+
+/**
+ * @brief Accumulates process() durations of one measurement period
+ *
+ * add() is O(1) and never allocates: durations go into a fixed log-linear
+ * histogram (8 buckets per octave of nanoseconds, exact below 16 ns), from
+ * which summarize() takes the 99th percentile. Only the audio thread
+ * touches it; summaries reach other threads through an SpscRingBuffer.
+ */
+class ProcessTimingStats {
+public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kNumBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;  // Every uint64
+
+    ProcessTimingStats() { clear(); }
+
+    /**
+     * @brief Start a new period
+     */
+    void clear() {
+        mBlocks = 0;
+        mSamples = 0;
+        mTotalNanos = 0;
+        mMinNanos = ~uint64(0);
+        mMaxNanos = 0;
+        std::memset(mBuckets, 0, sizeof(mBuckets));
+    }
+
+    /**
+     * @brief Add one block
+     * @param nanos Time spent in process() (ns)
+     * @param numSamples Samples the block processed
+     */
+    void add(uint64 nanos, int32 numSamples) {
+        ++mBlocks;
+        mSamples += std::max<int32>(numSamples, 0);
+        mTotalNanos += nanos;
+        mMinNanos = std::min(mMinNanos, nanos);
+        mMaxNanos = std::max(mMaxNanos, nanos);
+        ++mBuckets[bucketOf(nanos)];
+    }
+
+    int64 numBlocks() const { return mBlocks; }
+    int64 numSamples() const { return mSamples; }
+
+    /**
+     * @brief Statistics of the period so far
+     * @param sampleRate Sample rate the blocks were processed at (for load)
+     */
+    ProcessTimingSummary summarize(double sampleRate) const {
+        ProcessTimingSummary summary = {};
+        if (mBlocks == 0)
+            return summary;
+
+        // Smallest bucket holding at least 99% of the blocks
+        int64 rank = mBlocks - mBlocks / 100;
+        int64 count = 0;
+        int bucket = 0;
+        for (; bucket < kNumBuckets - 1; ++bucket) {
+            count += mBuckets[bucket];
+            if (count >= rank)
+                break;
+        }
+
+        summary.blocks = mBlocks;
+        summary.minMicros = mMinNanos * 1.0e-3;
+        summary.meanMicros = static_cast<double>(mTotalNanos) / mBlocks * 1.0e-3;
+        summary.p99Micros = std::min(bucketUpperBound(bucket), mMaxNanos) * 1.0e-3;
+        summary.maxMicros = mMaxNanos * 1.0e-3;
+        if (mSamples > 0 && sampleRate > 0.0)
+            summary.load = mTotalNanos * 1.0e-9 / (mSamples / sampleRate);
+        return summary;
+    }
+
+    /**
+     * @brief Histogram bucket of a duration
+     */
+    static int bucketOf(uint64 nanos) {
+        if (nanos < kSubBuckets)
+            return static_cast<int>(nanos);
+
+        int msb = highestBit(nanos);
+        int shift = msb - kSubBucketBits;
+        int subBucket = static_cast<int>(nanos >> shift) & (kSubBuckets - 1);
+        return (shift + 1) * kSubBuckets + subBucket;
+    }
+
+    /**
+     * @brief Largest duration falling into a bucket
+     */
+    static uint64 bucketUpperBound(int bucket) {
+        if (bucket < kSubBuckets)
+            return static_cast<uint64>(bucket);
+
+        int shift = bucket / kSubBuckets - 1;
+        uint64 lower = static_cast<uint64>(kSubBuckets + bucket % kSubBuckets) << shift;
+        return lower + ((uint64(1) << shift) - 1);
+    }
+
+private:
+    // Index of the highest set bit (value > 0)
+    static int highestBit(uint64 value) {
+        int bit = 0;
+        for (int step = 32; step > 0; step /= 2) {
+            if (value >> step) {
+                value >>= step;
+                bit += step;
+            }
+        }
+        return bit;
+    }
+
+    int64 mBlocks;
+    int64 mSamples;
+    uint64 mTotalNanos;
+    uint64 mMinNanos;
+    uint64 mMaxNanos;
+    uint32 mBuckets[kNumBuckets];
+};
+
+/**
+ * @brief Counts blocks whose process() time comes close to their deadline
+ *
+ * A block's deadline is the audio time it covers (numSamples / sampleRate);
+ * a block that takes longer drops out. Blocks over each threshold are
+ * counted since reset(). Only the audio thread calls add(); the counters
+ * are atomics it alone writes, so counters() may be called from any thread
+ * without locking (fields may be a block apart from each other).
+ */
+class DeadlineWatchdog {
+public:
+    DeadlineWatchdog()
+        : mPeriodMaxUse(0.0)
+        , mBlocks(0)
+        , mWorstUse(0.0)
+    {
+        setThresholds(kDefaultDeadlineThresholds);
+        reset();
+    }
+
+    /**
+     * @brief Set the thresholds (only while add() is not running)
+     * @param thresholds Fractions of the deadline, ascending
+     */
+    void setThresholds(const double thresholds[kDeadlineLevels]) {
+        for (int32 level = 0; level < kDeadlineLevels; ++level)
+            mThresholds[level] = thresholds[level];
+    }
+
+    /**
+     * @brief Start counting from zero
+     */
+    void reset() {
+        mPeriodMaxUse = 0.0;
+        mBlocks.store(0, std::memory_order_relaxed);
+        for (int32 level = 0; level < kDeadlineLevels; ++level)
+            mExceeded[level].store(0, std::memory_order_relaxed);
+        mWorstUse.store(0.0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add one block
+     * @param nanos Time spent in process() (ns)
+     * @param numSamples Samples the block processed (blocks without audio
+     *        have no deadline and are ignored)
+     * @param sampleRate Sample rate in Hz
+     * @return Time / deadline of the block (0.0 if ignored)
+     */
+    double add(uint64 nanos, int32 numSamples, double sampleRate) {
+        if (numSamples <= 0 || sampleRate <= 0.0)
+            return 0.0;
+
+        double deadlineNanos = numSamples / sampleRate * 1.0e9;
+        double use = nanos / deadlineNanos;
+
+        mBlocks.store(mBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        for (int32 level = 0; level < kDeadlineLevels && use > mThresholds[level]; ++level)
+            mExceeded[level].store(mExceeded[level].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        mPeriodMaxUse = std::max(mPeriodMaxUse, use);
+        if (use > mWorstUse.load(std::memory_order_relaxed))
+            mWorstUse.store(use, std::memory_order_relaxed);
+        return use;
+    }
+
+    /**
+     * @brief Copy the deadline figures into a period's summary and start
+     *        the next period (audio thread)
+     */
+    void summarize(ProcessTimingSummary& summary) {
+        summary.maxDeadlineUse = mPeriodMaxUse;
+        for (int32 level = 0; level < kDeadlineLevels; ++level)
+            summary.deadlineExceeded[level] = mExceeded[level].load(std::memory_order_relaxed);
+        mPeriodMaxUse = 0.0;
+    }
+
+    /**
+     * @brief Counters since reset() (any thread)
+     */
+    DeadlineCounters counters() const {
+        DeadlineCounters counters;
+        counters.blocks = mBlocks.load(std::memory_order_relaxed);
+        for (int32 level = 0; level < kDeadlineLevels; ++level) {
+            counters.exceeded[level] = mExceeded[level].load(std::memory_order_relaxed);
+            counters.thresholds[level] = mThresholds[level];
+        }
+        counters.worstUse = mWorstUse.load(std::memory_order_relaxed);
+        return counters;
+    }
+
+private:
+    double mThresholds[kDeadlineLevels];
+    double mPeriodMaxUse;     // Audio thread only
+    std::atomic<int64> mBlocks;
+    std::atomic<int64> mExceeded[kDeadlineLevels];
+    std::atomic<double> mWorstUse;
+};
+
+/**
+ * @brief Parse deadline thresholds given in percent, e.g. "10,50,100"
+ * @param text kDeadlineLevels comma separated percentages, ascending and > 0
+ *        (nullptr allowed)
+ * @param thresholds Receives the fractions; unchanged on failure
+ * @return false if text is missing or malformed
+ */
+inline bool parseDeadlineThresholds(const char* text, double thresholds[kDeadlineLevels]) {
+    if (!text)
+        return false;
+
+    double parsed[kDeadlineLevels];
+    for (int32 level = 0; level < kDeadlineLevels; ++level) {
+        // Decimal point whatever the host's locale (strtod follows LC_NUMERIC)
+        double percent = 0.0;
+        if (!DecimalText::parseDecimal(text, percent) || !(percent > 0.0)
+            || (level > 0 && percent / 100.0 <= parsed[level - 1]))
+            return false;
+
+        parsed[level] = percent / 100.0;
+        if (level < kDeadlineLevels - 1) {
+            if (*text != ',')
+                return false;
+            ++text;
+        }
+    }
+    if (*text != '\0')
+        return false;
+
+    for (int32 level = 0; level < kDeadlineLevels; ++level)
+        thresholds[level] = parsed[level];
+    return true;
+}
+
+//------------------------------------------------------------------------
+// Telemetry message (processor → controller, IConnectionPoint): a batch of
+// ProcessTimingSummary records (record_message.h)
+//------------------------------------------------------------------------
+namespace TimingMessage {
+    constexpr const char* kId = "ProcessTiming";
+    constexpr size_t kMaxRecords = 16;  // Summaries per message (processor queue capacity)
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,54 @@
+// realtime_check.h
+// Real-time safety check of the audio thread
+//
+// process() runs inside a RealtimeScope. In builds with
+// SIMPLEPANNER_REALTIME_CHECK, source/realtime_check.cpp interposes the C
+// library's allocation, lock and blocking system call functions, and every
+// call made by a thread inside a RealtimeScope is counted as a violation.
+// In all other builds RealtimeScope is empty and costs nothing.
+
+#pragma once
+
+#include <cstddef>
+
+namespace Steinberg {
+namespace SimplePanner {
+namespace RealtimeCheck {
+
+#if SIMPLEPANNER_REALTIME_CHECK
+
+// Mark the calling thread as inside / outside a real-time section (nestable)
+void enter();
+void leave();
+
+// Violations since the last reset, on any thread
+size_t violationCount();
+
+// Name of the first function called in a real-time section since the last
+// reset, or nullptr
+const char* firstViolation();
+
+void resetViolations();
+
+#else
+
+inline void enter() {}
+inline void leave() {}
+
+#endif
+
+/**
+ * @brief Marks the current thread as real-time for its lifetime
+ */
+class RealtimeScope {
+public:
+    RealtimeScope() { enter(); }
+    ~RealtimeScope() { leave(); }
+
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+};
+
+} // namespace RealtimeCheck
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,80 @@
+// record_message.h
+// Batches of fixed-size records carried by an IMessage (processor → controller)
+//
+// Records drained from an SpscRingBuffer on a non-audio thread travel as
+// one binary attribute, so a whole batch costs one message. Processor and
+// controller are built from the same sources, so records are copied as
+// bytes; the record size is sent along and checked on receipt.
+
+#pragma once
+
+#include "pluginterfaces/base/ftypes.h"
+#include "pluginterfaces/vst/ivstattributes.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+namespace RecordMessage {
+    constexpr const char* kRecords = "Records";        // Binary: count * record size bytes
+    constexpr const char* kRecordSize = "RecordSize";  // Int: sizeof(record)
+}
+
+//------------------------------------------------------------------------
+// Telemetry poll (controller → processor): the processor answers on the
+// receiving thread with one batch message per record type. The editor polls
+// from its VSTGUI timer, so records only travel on the host's UI thread
+// (the SDK's Timer is not available on every platform, e.g. Linux).
+//------------------------------------------------------------------------
+namespace TelemetryPoll {
+    constexpr const char* kId = "TelemetryPoll";
+    constexpr uint32 kIntervalMs = 33;  // Editor poll interval, about once per frame
+}
+
+/**
+ * @brief Store a batch of records in a message's attributes
+ * @param attributes Attributes of the message to send
+ * @param records First record
+ * @param count Number of records
+ */
+template <typename T>
+void writeRecords(Vst::IAttributeList* attributes, const T* records, size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value, "Records are sent as bytes");
+    if (!attributes)
+        return;
+    attributes->setInt(RecordMessage::kRecordSize, static_cast<int64>(sizeof(T)));
+    attributes->setBinary(RecordMessage::kRecords, records, static_cast<uint32>(count * sizeof(T)));
+}
+
+/**
+ * @brief Read a batch of records from a message's attributes
+ * @param attributes Attributes of the received message
+ * @param records Receives up to maxCount records (the oldest ones)
+ * @param maxCount Capacity of records
+ * @return Number of records read; 0 if the message holds no records of type T
+ */
+template <typename T>
+size_t readRecords(Vst::IAttributeList* attributes, T* records, size_t maxCount) {
+    static_assert(std::is_trivially_copyable<T>::value, "Records are sent as bytes");
+    if (!attributes)
+        return 0;
+
+    int64 recordSize = 0;
+    const void* data = nullptr;
+    uint32 size = 0;
+    if (attributes->getInt(RecordMessage::kRecordSize, recordSize) != kResultTrue
+        || recordSize != static_cast<int64>(sizeof(T))
+        || attributes->getBinary(RecordMessage::kRecords, data, size) != kResultTrue
+        || !data || size % sizeof(T) != 0)
+        return 0;
+
+    size_t count = std::min(static_cast<size_t>(size / sizeof(T)), maxCount);
+    std::memcpy(records, data, count * sizeof(T));
+    return count;
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,279 @@
+// session_capture.h
+// Recording of the host calls a processor receives, for offline replay
+//
+// A capture file holds the calls that decide what process() computes:
+// setupProcessing, setActive, recalled states, the preset bank program
+// changes refer to and every block with its parameter queues and,
+// optionally, its input audio. SessionReplay
+// (session_replay.h) feeds them to a fresh processor, so a session from a
+// real host can be profiled and bisected offline.
+//
+// File layout (host byte order, checked by kCaptureByteOrder):
+//
+//     CaptureFileHeader
+//     { uint32 type, uint32 size, size bytes of payload } ...
+//
+// Payloads by CaptureRecordType:
+//     kCaptureSetup   CaptureSetup
+//     kCaptureActive  int32 state
+//     kCaptureState   StateSerializer chunk, as setState reads it
+//     kCaptureBlock   CaptureBlockHeader
+//                     per queue: uint32 id, int32 numPoints, numPoints x CapturePoint
+//                     audioChannels x numSamples float (input bus 0, channel by channel)
+//     kCaptureEnd     uint64 records dropped because the queue was full
+//     kCapturePresetBank  CapturePresetBank, pathSize bytes of path (UTF-8, no NUL)
+
+#pragma once
+
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+#include "background_writer.h"
+#include "spsc_byte_queue.h"
+#include "state_serializer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+constexpr uint32 kCaptureMagic = 0x50414353;      // "SCAP"
+constexpr uint32 kCaptureVersion = 1;
+constexpr uint32 kCaptureByteOrder = 0x01020304;
+constexpr uint32 kCaptureFlagAudio = 1u << 0;     // Blocks carry input audio
+constexpr int32 kMaxCaptureChannels = 2;          // Input channels recorded per block
+
+enum CaptureRecordType : uint32 {
+    kCaptureSetup = 1,
+    kCaptureActive,
+    kCaptureState,
+    kCaptureBlock,
+    kCaptureEnd,
+    kCapturePresetBank      ///< Program table in use from here on (older readers skip it)
+};
+
+struct CaptureFileHeader {
+    uint32 magic;
+    uint32 version;
+    uint32 byteOrder;
+    uint32 flags;
+};
+
+struct CaptureRecordHeader {
+    uint32 type;
+    uint32 size;        ///< Payload bytes that follow
+};
+
+struct CaptureSetup {
+    int32 processMode;
+    int32 symbolicSampleSize;
+    int32 maxSamplesPerBlock;
+    int32 reserved;
+    double sampleRate;
+};
+
+struct CaptureBlockHeader {
+    int32 numSamples;
+    int32 processMode;
+    uint64 silenceFlags;    ///< Input bus 0
+    int32 inputChannels;    ///< Channels of input bus 0 (0: no input bus)
+    int32 outputChannels;   ///< Channels of output bus 0 (0: no output bus)
+    int32 numQueues;
+    int32 audioChannels;    ///< Channels of input audio that follow the queues
+};
+
+struct CapturePresetBank {
+    int32 count;            ///< Programs (1 without a bank: "Default")
+    int32 numFields;        ///< Leading fields a program sets
+    uint32 checksum;        ///< FNV-1a of the bank file (0: no bank)
+    uint32 pathSize;        ///< Bytes of path that follow (0: no bank)
+};
+
+struct CapturePoint {
+    int32 sampleOffset;
+    int32 reserved;
+    double value;
+};
+
+/**
+ * @brief Writes a capture file from a processor's calls
+ *
+ * Records are queued in an SpscByteQueue and written to the file by a
+ * background thread every kWriteIntervalMs. recordBlock() and recordState()
+ * never allocate, lock or do I/O, so process() may call them. A record that
+ * does not fit in the queue is dropped and counted; the count ends the file
+ * (kCaptureEnd), and a replay with drops is not exact.
+ *
+ * There is one producer at a time: the main thread records setup,
+ * activation and states while processing is stopped, the audio thread
+ * records blocks while it runs. The host's setActive / setProcessing calls
+ * order the two.
+ */
+class SessionCapture {
+public:
+    static constexpr size_t kQueueBytes = size_t(1) << 22;  // About 10 s of stereo audio at 48 kHz
+    static constexpr int kWriteIntervalMs = 20;
+
+    /**
+     * @brief Create a capture file and start the writer thread
+     * @param path File to (over)write; check isOpen()
+     * @param withAudio Record the input audio of every block
+     */
+    SessionCapture(const char* path, bool withAudio)
+        : mFile(path ? std::fopen(path, "wb") : nullptr)
+        , mWithAudio(withAudio)
+        , mQueue(kQueueBytes)
+        , mNumDropped(0)
+    {
+        if (!mFile)
+            return;
+
+        CaptureFileHeader header = {kCaptureMagic, kCaptureVersion, kCaptureByteOrder,
+                                    withAudio ? kCaptureFlagAudio : 0u};
+        std::fwrite(&header, sizeof(header), 1, mFile);
+        mWriter.start(kWriteIntervalMs, [this] { writeQueued(); });
+    }
+
+    /**
+     * @brief Write what is queued, end the file and close it
+     */
+    ~SessionCapture() {
+        if (!mFile)
+            return;
+
+        mWriter.stop();
+
+        writeQueued();
+        CaptureRecordHeader header = {kCaptureEnd, sizeof(uint64)};
+        uint64 dropped = numDropped();
+        std::fwrite(&header, sizeof(header), 1, mFile);
+        std::fwrite(&dropped, sizeof(dropped), 1, mFile);
+        std::fclose(mFile);
+    }
+
+    SessionCapture(const SessionCapture&) = delete;
+    SessionCapture& operator=(const SessionCapture&) = delete;
+
+    bool isOpen() const { return mFile != nullptr; }
+    bool withAudio() const { return mWithAudio; }
+    uint64 numDropped() const { return mNumDropped.load(std::memory_order_relaxed); }
+
+    void recordSetup(const Vst::ProcessSetup& setup) {
+        CaptureSetup payload = {setup.processMode, setup.symbolicSampleSize, setup.maxSamplesPerBlock, 0,
+                                setup.sampleRate};
+        if (!beginRecord(kCaptureSetup, sizeof(payload)))
+            return;
+        mQueue.append(&payload, sizeof(payload));
+        mQueue.commit();
+    }
+
+    void recordActive(bool state) {
+        int32 payload = state ? 1 : 0;
+        if (!beginRecord(kCaptureActive, sizeof(payload)))
+            return;
+        mQueue.append(&payload, sizeof(payload));
+        mQueue.commit();
+    }
+
+    void recordState(const PluginState& state) {
+        uint8 chunk[StateSerializer::kMaxChunkSize];
+        size_t size = StateSerializer::encode(state, chunk);
+        if (!beginRecord(kCaptureState, size))
+            return;
+        mQueue.append(chunk, size);
+        mQueue.commit();
+    }
+
+    /**
+     * @brief Record which preset bank kParamProgram changes select from
+     * @param path Bank file (nullptr or "": no bank)
+     */
+    void recordPresetBank(const char* path, int32 count, int32 numFields, uint32 checksum) {
+        size_t pathSize = path ? std::strlen(path) : 0;
+        CapturePresetBank payload = {count, numFields, checksum, static_cast<uint32>(pathSize)};
+        if (!beginRecord(kCapturePresetBank, sizeof(payload) + pathSize))
+            return;
+        mQueue.append(&payload, sizeof(payload));
+        if (pathSize > 0)
+            mQueue.append(path, pathSize);
+        mQueue.commit();
+    }
+
+    /**
+     * @brief Record a block as process() receives it (before processing,
+     *        since hosts may pass the same buffers for input and output)
+     */
+    void recordBlock(Vst::ProcessData& data) {
+        CaptureBlockHeader header = {};
+        header.numSamples = std::max<int32>(data.numSamples, 0);
+        header.processMode = data.processMode;
+        if (data.numInputs > 0 && data.inputs) {
+            header.silenceFlags = data.inputs[0].silenceFlags;
+            header.inputChannels = data.inputs[0].numChannels;
+        }
+        if (data.numOutputs > 0 && data.outputs)
+            header.outputChannels = data.outputs[0].numChannels;
+        header.numQueues = data.inputParameterChanges ? data.inputParameterChanges->getParameterCount() : 0;
+        if (mWithAudio && header.inputChannels > 0 && data.symbolicSampleSize == Vst::kSample32
+            && data.inputs[0].channelBuffers32)
+            header.audioChannels = std::min(header.inputChannels, kMaxCaptureChannels);
+
+        size_t size = sizeof(header)
+                    + sizeof(float) * static_cast<size_t>(header.audioChannels) * header.numSamples;
+        for (int32 i = 0; i < header.numQueues; ++i) {
+            Vst::IParamValueQueue* queue = data.inputParameterChanges->getParameterData(i);
+            int32 numPoints = queue ? queue->getPointCount() : 0;
+            size += sizeof(uint32) + sizeof(int32) + sizeof(CapturePoint) * static_cast<size_t>(numPoints);
+        }
+        if (!beginRecord(kCaptureBlock, size))
+            return;
+
+        mQueue.append(&header, sizeof(header));
+        for (int32 i = 0; i < header.numQueues; ++i) {
+            Vst::IParamValueQueue* queue = data.inputParameterChanges->getParameterData(i);
+            uint32 id = queue ? queue->getParameterId() : 0;
+            int32 numPoints = queue ? queue->getPointCount() : 0;
+            mQueue.append(&id, sizeof(id));
+            mQueue.append(&numPoints, sizeof(numPoints));
+            for (int32 p = 0; p < numPoints; ++p) {
+                CapturePoint point = {0, 0, 0.0};
+                queue->getPoint(p, point.sampleOffset, point.value);
+                mQueue.append(&point, sizeof(point));
+            }
+        }
+        for (int32 c = 0; c < header.audioChannels; ++c)
+            mQueue.append(data.inputs[0].channelBuffers32[c], sizeof(float) * static_cast<size_t>(header.numSamples));
+        mQueue.commit();
+    }
+
+private:
+    bool beginRecord(CaptureRecordType type, size_t size) {
+        if (!mQueue.reserve(sizeof(CaptureRecordHeader) + size)) {
+            mNumDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        CaptureRecordHeader header = {type, static_cast<uint32>(size)};
+        mQueue.append(&header, sizeof(header));
+        return true;
+    }
+
+    // Append the queued bytes (consumer thread only)
+    void writeQueued() {
+        unsigned char bytes[65536];
+        size_t count;
+        while ((count = mQueue.read(bytes, sizeof(bytes))) > 0)
+            std::fwrite(bytes, 1, count, mFile);
+        std::fflush(mFile);
+    }
+
+    std::FILE* mFile;
+    bool mWithAudio;
+    SpscByteQueue mQueue;
+    std::atomic<uint64> mNumDropped;
+    BackgroundWriter mWriter;
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
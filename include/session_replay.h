@@ -0,0 +1,422 @@
+// session_replay.h
+// Offline replay of a capture file (session_capture.h) into a processor
+//
+// Used by the simplepanner_replay tool and the tests. Replay runs on one
+// thread and allocates freely; it is not meant for a real-time context.
+
+#pragma once
+
+#include "session_capture.h"
+#include "public.sdk/source/common/memorystream.h"
+#include "public.sdk/source/vst/vstaudioeffect.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+//------------------------------------------------------------------------
+// Parameter queue rebuilt from a recorded block (or filled by the processor)
+//------------------------------------------------------------------------
+class ReplayParamValueQueue : public Vst::IParamValueQueue {
+public:
+    explicit ReplayParamValueQueue(Vst::ParamID id) : mId(id) {}
+    virtual ~ReplayParamValueQueue() = default;
+
+    Vst::ParamID PLUGIN_API getParameterId() override { return mId; }
+    int32 PLUGIN_API getPointCount() override { return static_cast<int32>(mPoints.size()); }
+
+    tresult PLUGIN_API getPoint(int32 index, int32& sampleOffset, Vst::ParamValue& value) override {
+        if (index < 0 || index >= getPointCount())
+            return kResultFalse;
+        sampleOffset = mPoints[index].sampleOffset;
+        value = mPoints[index].value;
+        return kResultTrue;
+    }
+
+    tresult PLUGIN_API addPoint(int32 sampleOffset, Vst::ParamValue value, int32& index) override {
+        mPoints.push_back({sampleOffset, 0, value});
+        index = getPointCount() - 1;
+        return kResultTrue;
+    }
+
+    tresult PLUGIN_API queryInterface(const TUID, void** obj) override {
+        *obj = nullptr;
+        return kNoInterface;
+    }
+    uint32 PLUGIN_API addRef() override { return 1; }
+    uint32 PLUGIN_API release() override { return 1; }
+
+private:
+    Vst::ParamID mId;
+    std::vector<CapturePoint> mPoints;
+};
+
+class ReplayParameterChanges : public Vst::IParameterChanges {
+public:
+    virtual ~ReplayParameterChanges() = default;
+
+    int32 PLUGIN_API getParameterCount() override { return static_cast<int32>(mQueues.size()); }
+
+    Vst::IParamValueQueue* PLUGIN_API getParameterData(int32 index) override {
+        if (index < 0 || index >= getParameterCount())
+            return nullptr;
+        return mQueues[index].get();
+    }
+
+    // Recorded queues keep their order, so no lookup by id
+    Vst::IParamValueQueue* PLUGIN_API addParameterData(const Vst::ParamID& id, int32& index) override {
+        mQueues.emplace_back(new ReplayParamValueQueue(id));
+        index = getParameterCount() - 1;
+        return mQueues.back().get();
+    }
+
+    void clear() { mQueues.clear(); }
+
+    tresult PLUGIN_API queryInterface(const TUID, void** obj) override {
+        *obj = nullptr;
+        return kNoInterface;
+    }
+    uint32 PLUGIN_API addRef() override { return 1; }
+    uint32 PLUGIN_API release() override { return 1; }
+
+private:
+    std::vector<std::unique_ptr<ReplayParamValueQueue>> mQueues;
+};
+
+//------------------------------------------------------------------------
+// What a replay did, and how long process() took
+//------------------------------------------------------------------------
+struct ReplayStats {
+    int64 blocks;
+    int64 samples;
+    int32 setups;
+    int32 activations;
+    int32 states;
+    int32 presetBanks;          ///< Bank records; more than one means the bank changed mid-session
+    uint64 droppedRecords;      ///< Lost during capture (kCaptureEnd); replay is not exact if nonzero
+    bool complete;              ///< The capture was closed properly (kCaptureEnd present)
+    double audioSeconds;        ///< Audio time of the replayed blocks
+    double processSeconds;      ///< Time spent in process()
+    double maxBlockSeconds;     ///< Slowest process() call
+};
+
+//------------------------------------------------------------------------
+// Preset bank the captured program changes refer to
+//------------------------------------------------------------------------
+struct ReplayPresetBank {
+    bool recorded = false;      ///< False for captures without a bank record
+    std::string path;           ///< Bank file ("": no bank)
+    int32 count = 0;
+    int32 numFields = 0;
+    uint32 checksum = 0;        ///< FNV-1a of the bank file (0: no bank)
+};
+
+/**
+ * @brief Reads a capture file and feeds it to a processor
+ *
+ * Blocks are rebuilt as recorded: block size, process mode, bus channel
+ * counts, silence flags and parameter queues. Input audio comes from the
+ * file when it was captured and is silence otherwise.
+ */
+class SessionReplay {
+public:
+    static constexpr int32 kMaxChannels = 64;   // Per bus, rejects corrupt blocks
+
+    // Called after each process(), e.g. to check or save the output
+    using BlockCallback = std::function<void(int64 blockIndex, Vst::ProcessData& data)>;
+
+    /**
+     * @brief Load a capture file
+     * @return False if it cannot be read or is not a capture; see error()
+     */
+    bool open(const char* path) {
+        mBytes.clear();
+        mError = nullptr;
+        mPresetBank = ReplayPresetBank();
+
+        std::FILE* file = path ? std::fopen(path, "rb") : nullptr;
+        if (!file)
+            return fail("cannot open the file");
+        unsigned char chunk[65536];
+        size_t count;
+        while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            mBytes.insert(mBytes.end(), chunk, chunk + count);
+        std::fclose(file);
+
+        if (mBytes.size() < sizeof(CaptureFileHeader))
+            return fail("file too short");
+        std::memcpy(&mHeader, mBytes.data(), sizeof(mHeader));
+        if (mHeader.magic != kCaptureMagic)
+            return fail("not a capture file");
+        if (mHeader.byteOrder != kCaptureByteOrder)
+            return fail("captured on a machine with another byte order");
+        if (mHeader.version != kCaptureVersion)
+            return fail("unsupported capture version");
+
+        findPresetBank();
+        return true;
+    }
+
+    const char* error() const { return mError ? mError : ""; }
+    bool hasAudio() const { return (mHeader.flags & kCaptureFlagAudio) != 0; }
+
+    /**
+     * @brief First preset bank recorded in the capture. The processor must
+     *        use the same bank, or program changes recall other values.
+     */
+    const ReplayPresetBank& presetBank() const { return mPresetBank; }
+
+    /**
+     * @brief Replay the capture
+     * @param processor Initialized and inactive; left inactive
+     * @param stats Receives what was replayed
+     * @param maxBlocks Stop after this many blocks (negative: all), for bisecting
+     * @param onBlock Optional callback after each process()
+     * @return False if a record is malformed (stats cover the records before it)
+     */
+    bool run(Vst::AudioEffect& processor, ReplayStats& stats, int64 maxBlocks = -1,
+             const BlockCallback& onBlock = nullptr) {
+        stats = ReplayStats();
+        mError = nullptr;
+        bool active = false;
+        double sampleRate = 44100.0;
+        bool ok = true;
+
+        size_t offset = sizeof(CaptureFileHeader);
+        while (ok && offset < mBytes.size() && (maxBlocks < 0 || stats.blocks < maxBlocks)) {
+            CaptureRecordHeader header;
+            if (mBytes.size() - offset < sizeof(header)) {
+                ok = fail("truncated record header");
+                break;
+            }
+            std::memcpy(&header, mBytes.data() + offset, sizeof(header));
+            offset += sizeof(header);
+            if (mBytes.size() - offset < header.size) {
+                ok = fail("truncated record");
+                break;
+            }
+            const unsigned char* payload = mBytes.data() + offset;
+            offset += header.size;
+
+            switch (header.type) {
+                case kCaptureSetup: {
+                    CaptureSetup recorded;
+                    if (header.size != sizeof(recorded)) {
+                        ok = fail("malformed setup record");
+                        break;
+                    }
+                    std::memcpy(&recorded, payload, sizeof(recorded));
+                    Vst::ProcessSetup setup;
+                    setup.processMode = recorded.processMode;
+                    setup.symbolicSampleSize = recorded.symbolicSampleSize;
+                    setup.maxSamplesPerBlock = recorded.maxSamplesPerBlock;
+                    setup.sampleRate = recorded.sampleRate;
+                    processor.setupProcessing(setup);
+                    sampleRate = recorded.sampleRate;
+                    ++stats.setups;
+                    break;
+                }
+                case kCaptureActive: {
+                    int32 state;
+                    if (header.size != sizeof(state)) {
+                        ok = fail("malformed activation record");
+                        break;
+                    }
+                    std::memcpy(&state, payload, sizeof(state));
+                    processor.setActive(state != 0);
+                    active = (state != 0);
+                    ++stats.activations;
+                    break;
+                }
+                case kCaptureState: {
+                    MemoryStream stream;
+                    int32 numWritten = 0;
+                    stream.write(const_cast<unsigned char*>(payload), static_cast<int32>(header.size), &numWritten);
+                    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+                    processor.setState(&stream);
+                    ++stats.states;
+                    break;
+                }
+                case kCaptureBlock:
+                    ok = replayBlock(processor, payload, header.size, stats, sampleRate, onBlock);
+                    break;
+                case kCapturePresetBank:
+                    // The processor's bank is fixed for the replay; the caller
+                    // compares it with presetBank() before run()
+                    if (!readPresetBank(payload, header.size, nullptr)) {
+                        ok = fail("malformed preset bank record");
+                        break;
+                    }
+                    ++stats.presetBanks;
+                    break;
+                case kCaptureEnd:
+                    if (header.size == sizeof(uint64))
+                        std::memcpy(&stats.droppedRecords, payload, sizeof(uint64));
+                    stats.complete = true;
+                    break;
+                default:
+                    // Unknown record types are skipped
+                    break;
+            }
+        }
+
+        if (active)
+            processor.setActive(false);
+        return ok;
+    }
+
+private:
+    bool fail(const char* error) {
+        mError = error;
+        return false;
+    }
+
+    // Record headers only; malformed records are reported by run()
+    void findPresetBank() {
+        size_t offset = sizeof(CaptureFileHeader);
+        CaptureRecordHeader header;
+        while (mBytes.size() - offset >= sizeof(header)) {
+            std::memcpy(&header, mBytes.data() + offset, sizeof(header));
+            offset += sizeof(header);
+            if (mBytes.size() - offset < header.size)
+                return;
+            if (header.type == kCapturePresetBank) {
+                readPresetBank(mBytes.data() + offset, header.size, &mPresetBank);
+                return;
+            }
+            offset += header.size;
+        }
+    }
+
+    static bool readPresetBank(const unsigned char* payload, size_t size, ReplayPresetBank* bank) {
+        CapturePresetBank recorded;
+        if (size < sizeof(recorded))
+            return false;
+        std::memcpy(&recorded, payload, sizeof(recorded));
+        if (size - sizeof(recorded) != recorded.pathSize)
+            return false;
+        if (bank) {
+            const char* path = reinterpret_cast<const char*>(payload + sizeof(recorded));
+            bank->recorded = true;
+            bank->path.assign(path, recorded.pathSize);
+            bank->count = recorded.count;
+            bank->numFields = recorded.numFields;
+            bank->checksum = recorded.checksum;
+        }
+        return true;
+    }
+
+    bool replayBlock(Vst::AudioEffect& processor, const unsigned char* payload, size_t size,
+                     ReplayStats& stats, double sampleRate, const BlockCallback& onBlock) {
+        CaptureBlockHeader header;
+        if (size < sizeof(header))
+            return fail("malformed block record");
+        std::memcpy(&header, payload, sizeof(header));
+        if (header.numSamples < 0 || header.numQueues < 0 || header.audioChannels < 0
+            || header.inputChannels < 0 || header.inputChannels > kMaxChannels
+            || header.outputChannels < 0 || header.outputChannels > kMaxChannels
+            || header.audioChannels > header.inputChannels)
+            return fail("malformed block record");
+
+        // Parameter queues
+        size_t offset = sizeof(header);
+        mInputChanges.clear();
+        for (int32 i = 0; i < header.numQueues; ++i) {
+            uint32 id;
+            int32 numPoints;
+            if (size - offset < sizeof(id) + sizeof(numPoints))
+                return fail("malformed block record");
+            std::memcpy(&id, payload + offset, sizeof(id));
+            std::memcpy(&numPoints, payload + offset + sizeof(id), sizeof(numPoints));
+            offset += sizeof(id) + sizeof(numPoints);
+            if (numPoints < 0 || (size - offset) / sizeof(CapturePoint) < static_cast<size_t>(numPoints))
+                return fail("malformed block record");
+
+            int32 index = 0;
+            Vst::IParamValueQueue* queue = mInputChanges.addParameterData(id, index);
+            for (int32 p = 0; p < numPoints; ++p) {
+                CapturePoint point;
+                std::memcpy(&point, payload + offset, sizeof(point));
+                offset += sizeof(point);
+                queue->addPoint(point.sampleOffset, point.value, index);
+            }
+        }
+
+        // Input audio as recorded, silence for channels without audio
+        size_t numSamples = static_cast<size_t>(header.numSamples);
+        if (size - offset != sizeof(float) * numSamples * static_cast<size_t>(header.audioChannels))
+            return fail("malformed block record");
+        prepareBus(mInputs, mInputPointers, header.inputChannels, numSamples);
+        prepareBus(mOutputs, mOutputPointers, header.outputChannels, numSamples);
+        for (int32 c = 0; c < header.audioChannels; ++c) {
+            std::memcpy(mInputs[c].data(), payload + offset, sizeof(float) * numSamples);
+            offset += sizeof(float) * numSamples;
+        }
+
+        Vst::AudioBusBuffers inputBus;
+        inputBus.numChannels = header.inputChannels;
+        inputBus.silenceFlags = header.silenceFlags;
+        inputBus.channelBuffers32 = mInputPointers.data();
+        Vst::AudioBusBuffers outputBus;
+        outputBus.numChannels = header.outputChannels;
+        outputBus.channelBuffers32 = mOutputPointers.data();
+
+        mOutputChanges.clear();
+        Vst::ProcessData data;
+        data.processMode = header.processMode;
+        data.symbolicSampleSize = Vst::kSample32;
+        data.numSamples = header.numSamples;
+        data.numInputs = header.inputChannels > 0 ? 1 : 0;
+        data.numOutputs = header.outputChannels > 0 ? 1 : 0;
+        data.inputs = &inputBus;
+        data.outputs = &outputBus;
+        data.inputParameterChanges = header.numQueues > 0 ? &mInputChanges : nullptr;
+        data.outputParameterChanges = &mOutputChanges;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        processor.process(data);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        stats.processSeconds += seconds;
+        stats.maxBlockSeconds = std::max(stats.maxBlockSeconds, seconds);
+        stats.samples += header.numSamples;
+        if (sampleRate > 0.0)
+            stats.audioSeconds += header.numSamples / sampleRate;
+        if (onBlock)
+            onBlock(stats.blocks, data);
+        ++stats.blocks;
+        return true;
+    }
+
+    static void prepareBus(std::vector<std::vector<float>>& channels, std::vector<float*>& pointers,
+                           int32 numChannels, size_t numSamples) {
+        channels.resize(static_cast<size_t>(numChannels));
+        pointers.resize(static_cast<size_t>(std::max(numChannels, 1)), nullptr);
+        for (int32 c = 0; c < numChannels; ++c) {
+            channels[c].assign(numSamples, 0.0f);
+            pointers[c] = channels[c].data();
+        }
+    }
+
+    std::vector<unsigned char> mBytes;
+    CaptureFileHeader mHeader = {};
+    const char* mError = nullptr;
+    ReplayPresetBank mPresetBank;
+
+    ReplayParameterChanges mInputChanges;
+    ReplayParameterChanges mOutputChanges;
+    std::vector<std::vector<float>> mInputs;
+    std::vector<std::vector<float>> mOutputs;
+    std::vector<float*> mInputPointers;
+    std::vector<float*> mOutputPointers;
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
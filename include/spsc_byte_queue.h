@@ -0,0 +1,129 @@
+// spsc_byte_queue.h
+// Lock-free single producer / single consumer byte stream (audio thread → writer thread)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief Ring buffer of variable-size records, stored as bytes
+ *
+ * The byte counterpart of SpscRingBuffer, for records whose size is only
+ * known when they are written (e.g. a block with its parameter queues).
+ * The producer reserves the whole record, appends it in pieces and
+ * publishes it with commit(), so the consumer never sees half a record;
+ * reserve() fails instead of waiting when the record does not fit.
+ *
+ * The storage is allocated by the constructor and never resized. Exactly
+ * one producer thread and one consumer thread may use it at a time.
+ */
+class SpscByteQueue {
+public:
+    /**
+     * @param capacity Size in bytes (power of two)
+     */
+    explicit SpscByteQueue(size_t capacity)
+        : mHead(0)
+        , mCachedTail(0)
+        , mWrite(0)
+        , mReserved(0)
+        , mTail(0)
+        , mCachedHead(0)
+        , mBuffer(capacity)
+        , mMask(capacity - 1)
+    {
+    }
+
+    SpscByteQueue(const SpscByteQueue&) = delete;
+    SpscByteQueue& operator=(const SpscByteQueue&) = delete;
+
+    size_t capacity() const { return mBuffer.size(); }
+
+    //--------------------------------------------------------------------
+    // Producer side
+    //--------------------------------------------------------------------
+
+    /**
+     * @brief Reserve space for a record of size bytes (wait-free)
+     * @return False if the consumer has not freed enough space; nothing
+     *         may be appended then
+     */
+    bool reserve(size_t size) {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (capacity() - (head - mCachedTail) < size) {
+            mCachedTail = mTail.load(std::memory_order_acquire);
+            if (capacity() - (head - mCachedTail) < size)
+                return false;
+        }
+        mWrite = head;
+        mReserved = head + size;
+        return true;
+    }
+
+    /**
+     * @brief Copy part of the reserved record
+     */
+    void append(const void* data, size_t size) {
+        size = std::min(size, mReserved - mWrite);
+        size_t offset = mWrite & mMask;
+        size_t first = std::min(size, capacity() - offset);
+        std::memcpy(mBuffer.data() + offset, data, first);
+        std::memcpy(mBuffer.data(), static_cast<const unsigned char*>(data) + first, size - first);
+        mWrite += size;
+    }
+
+    /**
+     * @brief Publish the record appended since reserve()
+     */
+    void commit() {
+        mHead.store(mWrite, std::memory_order_release);
+    }
+
+    //--------------------------------------------------------------------
+    // Consumer side
+    //--------------------------------------------------------------------
+
+    /**
+     * @brief Take the oldest published bytes, in write order
+     * @param data Receives up to maxSize bytes
+     * @param maxSize Capacity of data
+     * @return Number of bytes taken
+     */
+    size_t read(void* data, size_t maxSize) {
+        size_t tail = mTail.load(std::memory_order_relaxed);
+        if (mCachedHead - tail < maxSize)
+            mCachedHead = mHead.load(std::memory_order_acquire);
+        size_t size = std::min(mCachedHead - tail, maxSize);
+
+        size_t offset = tail & mMask;
+        size_t first = std::min(size, capacity() - offset);
+        std::memcpy(data, mBuffer.data() + offset, first);
+        std::memcpy(static_cast<unsigned char*>(data) + first, mBuffer.data(), size - first);
+        mTail.store(tail + size, std::memory_order_release);
+        return size;
+    }
+
+private:
+    // Producer line: published end, last tail seen, record being written
+    alignas(64) std::atomic<size_t> mHead;
+    size_t mCachedTail;
+    size_t mWrite;
+    size_t mReserved;
+
+    // Consumer line: next byte to read, last head seen
+    alignas(64) std::atomic<size_t> mTail;
+    size_t mCachedHead;
+
+    alignas(64) std::vector<unsigned char> mBuffer;
+    size_t mMask;
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,124 @@
+// spsc_ring_buffer.h
+// Lock-free single producer / single consumer record queue (audio thread → UI)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief Fixed-capacity ring buffer for streaming records out of process()
+ *
+ * Unlike TripleBuffer, which keeps only the latest value, every record is
+ * delivered in order until the buffer is full. The producer's push() is
+ * wait-free: one acquire load at most, a copy and a release store, and it
+ * fails instead of waiting when the consumer has fallen behind. The
+ * consumer takes all available records in one batch with pop().
+ *
+ * Storage is part of the object, so nothing is allocated after
+ * construction. The producer and consumer indices live on separate cache
+ * lines, each next to its side's cached copy of the other index, so the two
+ * threads only share a line when one of them has to refresh that copy.
+ *
+ * Exactly one producer thread and one consumer thread may use it at a time.
+ *
+ * @tparam T Record type (trivially copyable)
+ * @tparam kCapacity Number of slots (power of two)
+ */
+template <typename T, size_t kCapacity>
+class alignas(64) SpscRingBuffer {
+public:
+    static_assert(kCapacity >= 2 && (kCapacity & (kCapacity - 1)) == 0,
+                  "SpscRingBuffer capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SpscRingBuffer records must be trivially copyable");
+    static_assert(std::atomic<size_t>::is_always_lock_free,
+                  "SpscRingBuffer requires a lock-free atomic size_t");
+
+    SpscRingBuffer()
+        : mHead(0)
+        , mCachedTail(0)
+        , mTail(0)
+        , mCachedHead(0)
+        , mSlots()
+    {
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    static constexpr size_t capacity() { return kCapacity; }
+
+    //--------------------------------------------------------------------
+    // Producer side
+    //--------------------------------------------------------------------
+
+    /**
+     * @brief Append a record (wait-free)
+     * @param record Record to copy into the buffer
+     * @return False if the buffer is full; the record is dropped
+     */
+    bool push(const T& record) {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mCachedTail == kCapacity) {
+            mCachedTail = mTail.load(std::memory_order_acquire);
+            if (head - mCachedTail == kCapacity)
+                return false;
+        }
+
+        mSlots[head & kMask] = record;
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //--------------------------------------------------------------------
+    // Consumer side
+    //--------------------------------------------------------------------
+
+    /**
+     * @brief Take the oldest records, in push order
+     * @param records Receives up to maxCount records
+     * @param maxCount Capacity of records
+     * @return Number of records taken
+     */
+    size_t pop(T* records, size_t maxCount) {
+        size_t tail = mTail.load(std::memory_order_relaxed);
+        if (mCachedHead - tail < maxCount)
+            mCachedHead = mHead.load(std::memory_order_acquire);
+
+        size_t count = std::min(mCachedHead - tail, maxCount);
+        for (size_t i = 0; i < count; ++i)
+            records[i] = mSlots[(tail + i) & kMask];
+
+        mTail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Records waiting (exact on the consumer thread, a snapshot elsewhere)
+     */
+    size_t size() const {
+        return mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t kMask = kCapacity - 1;
+
+    // Producer line: next slot to write, last tail seen
+    alignas(64) std::atomic<size_t> mHead;
+    size_t mCachedTail;
+
+    // Consumer line: next slot to read, last head seen
+    alignas(64) std::atomic<size_t> mTail;
+    size_t mCachedHead;
+
+    alignas(64) T mSlots[kCapacity];
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
@@ -0,0 +1,243 @@
+// state_serializer.h
+// Component state format shared by processor (setState/getState) and
+// controller (setComponentState)
+//
+// v1: int32 version = 1, then one double per parameter in ParameterID
+//     (= kParamTable) order: exactly the 8 original parameters
+// v2: int32 version = 2, int32 field count, field count doubles (the
+//     parameters in ParameterID order, then snapshot B of the A/B morph),
+//     uint32 FNV-1a checksum of all preceding bytes
+//
+// All values are little-endian. The whole chunk is moved with a single
+// IBStream read or write; fields missing from older chunks keep their
+// defaults and fields unknown to this version are skipped.
+
+#pragma once
+
+#include "plugids.h"
+#include "parameter_table.h"
+#include "parameter_utils.h"
+#include "pluginterfaces/base/ibstream.h"
+
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+//------------------------------------------------------------------------
+// State Fields: the parameters, then the A/B morph snapshot B holding one
+// value per parameter (its Morph value is unused)
+//------------------------------------------------------------------------
+constexpr int32 kStateSnapshotB = static_cast<int32>(kParamCount);        // First field of snapshot B
+constexpr int32 kStateFieldCount = 2 * static_cast<int32>(kParamCount);   // Total field count
+
+/**
+ * @brief Normalized parameter values stored in the component state
+ */
+struct PluginState {
+    double values[kStateFieldCount];  ///< Parameters indexed by ParameterID, then snapshot B
+
+    /**
+     * @brief State holding the default value of every parameter
+     */
+    static PluginState defaults() {
+        PluginState state;
+        for (const ParamDescriptor& param : kParamTable) {
+            state.values[param.id] = defaultNormalized(param);
+        }
+
+        // Snapshot B starts out equal to the defaults
+        std::copy_n(state.values, kParamCount, state.values + kStateSnapshotB);
+        return state;
+    }
+};
+
+/**
+ * @brief Encoder/decoder for the component state chunk
+ */
+class StateSerializer {
+public:
+    static constexpr int32 kVersion1 = 1;
+    static constexpr int32 kVersion2 = 2;
+    static constexpr int32 kCurrentVersion = kVersion2;
+
+    static constexpr int32 kNumFields = kStateFieldCount;                 ///< Fields written by this version
+    static constexpr int32 kNumParams = static_cast<int32>(kParamCount);  ///< Leading fields holding parameters
+    static constexpr int32 kVersion1Fields = 8;          ///< Parameters stored by v1
+    static constexpr int32 kMaxFields = 64;              ///< Upper bound accepted from a chunk
+    static constexpr size_t kHeaderSize = 2 * sizeof(int32);
+    static constexpr size_t kChecksumSize = sizeof(uint32);
+    static constexpr size_t kMaxChunkSize = kHeaderSize + kMaxFields * sizeof(double) + kChecksumSize;
+
+    /**
+     * @brief Encode a state as a v2 chunk
+     * @param state State to encode
+     * @param buffer Output buffer of at least kMaxChunkSize bytes
+     * @return Number of bytes written to buffer
+     */
+    static size_t encode(const PluginState& state, uint8* buffer) {
+        uint8* out = buffer;
+        out = storeUInt32(out, static_cast<uint32>(kCurrentVersion));
+        out = storeUInt32(out, static_cast<uint32>(kNumFields));
+        for (int32 i = 0; i < kNumFields; ++i) {
+            out = storeDouble(out, state.values[i]);
+        }
+        out = storeUInt32(out, checksum(buffer, static_cast<size_t>(out - buffer)));
+        return static_cast<size_t>(out - buffer);
+    }
+
+    /**
+     * @brief Decode a v1 or v2 chunk
+     * @param buffer Chunk data
+     * @param size Number of valid bytes in buffer (may extend past the chunk)
+     * @param state Receives the decoded values; untouched on failure
+     * @return Number of bytes belonging to the chunk, 0 if it is invalid
+     */
+    static size_t decode(const uint8* buffer, size_t size, PluginState& state) {
+        if (size < sizeof(int32)) {
+            return 0;
+        }
+
+        PluginState decoded = state;
+        int32 version = static_cast<int32>(loadUInt32(buffer));
+        const uint8* in = buffer + sizeof(int32);
+
+        if (version == kVersion1) {
+            // v1 has no field count and always holds the 8 original
+            // parameters; data following them belongs to the host
+            if (size < sizeof(int32) + kVersion1Fields * sizeof(double)) {
+                return 0;
+            }
+            for (int32 i = 0; i < kVersion1Fields; ++i) {
+                decoded.values[i] = loadDouble(in);
+                in += sizeof(double);
+            }
+        } else if (version == kVersion2) {
+            if (size < kHeaderSize) {
+                return 0;
+            }
+            int32 numFields = static_cast<int32>(loadUInt32(in));
+            in += sizeof(int32);
+            if (numFields < 0 || numFields > kMaxFields) {
+                return 0;
+            }
+
+            size_t chunkSize = kHeaderSize + numFields * sizeof(double) + kChecksumSize;
+            if (size < chunkSize) {
+                return 0;
+            }
+            if (loadUInt32(buffer + chunkSize - kChecksumSize) != checksum(buffer, chunkSize - kChecksumSize)) {
+                return 0;
+            }
+
+            int32 numKnown = std::min(numFields, kNumFields);
+            for (int32 i = 0; i < numKnown; ++i) {
+                decoded.values[i] = loadDouble(in);
+                in += sizeof(double);
+            }
+            in = buffer + chunkSize;
+        } else {
+            return 0;
+        }
+
+        state = decoded;
+        return static_cast<size_t>(in - buffer);
+    }
+
+    /**
+     * @brief Write a state to a stream with a single write call
+     * @return True if the whole chunk was written
+     */
+    static bool write(IBStream* stream, const PluginState& state) {
+        if (!stream) {
+            return false;
+        }
+        uint8 buffer[kMaxChunkSize];
+        int32 size = static_cast<int32>(encode(state, buffer));
+        int32 numWritten = 0;
+        return stream->write(buffer, size, &numWritten) == kResultOk && numWritten == size;
+    }
+
+    /**
+     * @brief Read a state from a stream with a single read call
+     * @param stream Stream positioned at the start of the chunk
+     * @param state Receives the decoded values; untouched on failure
+     * @return True if a valid v1 or v2 chunk was read
+     *
+     * The stream is left positioned right after the chunk.
+     */
+    static bool read(IBStream* stream, PluginState& state) {
+        if (!stream) {
+            return false;
+        }
+        uint8 buffer[kMaxChunkSize];
+        int32 numRead = 0;
+        if (stream->read(buffer, static_cast<int32>(sizeof(buffer)), &numRead) != kResultOk || numRead <= 0) {
+            return false;
+        }
+
+        size_t chunkSize = decode(buffer, static_cast<size_t>(numRead), state);
+        if (chunkSize == 0) {
+            return false;
+        }
+        if (chunkSize < static_cast<size_t>(numRead)) {
+            stream->seek(static_cast<int64>(chunkSize) - numRead, IBStream::kIBSeekCur, nullptr);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 32-bit FNV-1a hash
+     */
+    static uint32 checksum(const uint8* data, size_t size) {
+        uint32 hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    //--------------------------------------------------------------------
+    // Little-endian field access (also used by PresetBank)
+    //--------------------------------------------------------------------
+
+    static uint8* storeUInt32(uint8* out, uint32 value) {
+        for (size_t i = 0; i < sizeof(uint32); ++i) {
+            out[i] = static_cast<uint8>(value >> (8 * i));
+        }
+        return out + sizeof(uint32);
+    }
+
+    static uint8* storeDouble(uint8* out, double value) {
+        uint64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (size_t i = 0; i < sizeof(uint64); ++i) {
+            out[i] = static_cast<uint8>(bits >> (8 * i));
+        }
+        return out + sizeof(uint64);
+    }
+
+    static uint32 loadUInt32(const uint8* in) {
+        uint32 value = 0;
+        for (size_t i = 0; i < sizeof(uint32); ++i) {
+            value |= static_cast<uint32>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    static double loadDouble(const uint8* in) {
+        uint64 bits = 0;
+        for (size_t i = 0; i < sizeof(uint64); ++i) {
+            bits |= static_cast<uint64>(in[i]) << (8 * i);
+        }
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
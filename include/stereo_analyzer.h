@@ -0,0 +1,183 @@
+// stereo_analyzer.h
+// Phase correlation and goniometer points of the output, per display frame
+//
+// The audio thread adds each output block to StereoAnalyzer. Correlation
+// sums are updated per block with the same lane-parallel reduction as
+// level_meter.h; goniometer points are a decimated copy of the samples,
+// spaced so that one frame never holds more than kScopePoints of them.
+// Once per frame (1/kScopeFrameRateHz of audio) the analyzer hands a
+// ScopeFrame to a sink, normally an SpscRingBuffer the telemetry timer
+// drains into a message for the editor.
+
+#pragma once
+
+#include "level_meter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+// Goniometer points per frame (drawing budget of one editor frame)
+constexpr int32 kScopePoints = 256;
+
+// Frames per second of audio
+constexpr double kScopeFrameRateHz = 30.0;
+
+/**
+ * @brief One display frame of the stereo analysis
+ */
+struct ScopeFrame {
+    float correlation;            ///< -1 (out of phase) to +1 (mono); 0 for silence
+    int32 numPoints;              ///< Valid entries of left/right
+    float left[kScopePoints];     ///< Decimated left samples
+    float right[kScopePoints];    ///< Decimated right samples
+};
+
+/**
+ * @brief Phase correlation from the sums of a frame
+ * @param sumLR Sum of left * right
+ * @param sumLL Sum of left²
+ * @param sumRR Sum of right²
+ * @return sumLR / sqrt(sumLL * sumRR), clamped to -1 - +1; 0.0 when either
+ *         channel is silent
+ */
+inline float phaseCorrelation(double sumLR, double sumLL, double sumRR) {
+    const double kEnergyFloor = 1.0e-10;  // Sum of squares counted as silence
+    double energy = sumLL * sumRR;
+    if (!(sumLL > kEnergyFloor && sumRR > kEnergyFloor))
+        return 0.0f;
+
+    double correlation = sumLR / std::sqrt(energy);
+    return static_cast<float>(std::min(std::max(correlation, -1.0), 1.0));
+}
+
+/**
+ * @brief Stereo correlation and goniometer analysis of one output
+ *
+ * add() never allocates. Per sample it costs three multiply-adds in
+ * kMeterLanes-wide vector lanes plus, for every decimation-th sample, one
+ * point copy.
+ */
+class StereoAnalyzer {
+public:
+    StereoAnalyzer()
+        : mFrameLength(1600)   // 48 kHz until setSampleRate()
+        , mDecimation(7)
+        , mFrameSamples(0)
+        , mSumLR(0.0)
+        , mSumLL(0.0)
+        , mSumRR(0.0)
+        , mFrame()
+    {
+    }
+
+    /**
+     * @brief Set the sample rate (starts a new frame)
+     * @param sampleRate Sample rate in Hz
+     */
+    void setSampleRate(double sampleRate) {
+        mFrameLength = std::max<int32>(static_cast<int32>(sampleRate / kScopeFrameRateHz), 1);
+        mDecimation = (mFrameLength + kScopePoints - 1) / kScopePoints;
+        reset();
+    }
+
+    /**
+     * @brief Start a new, empty frame
+     */
+    void reset() {
+        mFrameSamples = 0;
+        mSumLR = 0.0;
+        mSumLL = 0.0;
+        mSumRR = 0.0;
+        mFrame.correlation = 0.0f;
+        mFrame.numPoints = 0;
+    }
+
+    int32 frameLength() const { return mFrameLength; }
+    int32 decimation() const { return mDecimation; }
+
+    /**
+     * @brief Add one block; completed frames go to the sink
+     * @param left Left output samples
+     * @param right Right output samples
+     * @param numSamples Block length
+     * @param sink Callable taking const ScopeFrame& (called on the audio thread)
+     */
+    template <typename Sink>
+    void add(const float* left, const float* right, int32 numSamples, Sink&& sink) {
+        int32 offset = 0;
+        while (offset < numSamples) {
+            int32 count = std::min(numSamples - offset, mFrameLength - mFrameSamples);
+            addSegment(left + offset, right + offset, count);
+            offset += count;
+
+            if (mFrameSamples == mFrameLength) {
+                mFrame.correlation = phaseCorrelation(mSumLR, mSumLL, mSumRR);
+                sink(mFrame);
+                reset();
+            }
+        }
+    }
+
+private:
+    // Correlation sums and goniometer points of a segment within one frame
+    void addSegment(const float* left, const float* right, int32 numSamples) {
+        float sumLR[kMeterLanes] = {};
+        float sumLL[kMeterLanes] = {};
+        float sumRR[kMeterLanes] = {};
+
+        int32 i = 0;
+        for (; i + kMeterLanes <= numSamples; i += kMeterLanes) {
+            for (int32 lane = 0; lane < kMeterLanes; ++lane) {
+                float l = left[i + lane];
+                float r = right[i + lane];
+                sumLR[lane] += l * r;
+                sumLL[lane] += l * l;
+                sumRR[lane] += r * r;
+            }
+        }
+        for (int32 lane = 0; i < numSamples; ++i, ++lane) {
+            sumLR[lane] += left[i] * right[i];
+            sumLL[lane] += left[i] * left[i];
+            sumRR[lane] += right[i] * right[i];
+        }
+        for (int32 lane = 0; lane < kMeterLanes; ++lane) {
+            mSumLR += sumLR[lane];
+            mSumLL += sumLL[lane];
+            mSumRR += sumRR[lane];
+        }
+
+        // Every mDecimation-th sample of the frame becomes a point
+        int32 first = (mDecimation - mFrameSamples % mDecimation) % mDecimation;
+        for (int32 j = first; j < numSamples && mFrame.numPoints < kScopePoints; j += mDecimation) {
+            mFrame.left[mFrame.numPoints] = left[j];
+            mFrame.right[mFrame.numPoints] = right[j];
+            ++mFrame.numPoints;
+        }
+
+        mFrameSamples += numSamples;
+    }
+
+    int32 mFrameLength;   // Samples per frame
+    int32 mDecimation;    // Samples per goniometer point
+    int32 mFrameSamples;  // Samples of the current frame so far
+    double mSumLR;
+    double mSumLL;
+    double mSumRR;
+    ScopeFrame mFrame;
+};
+
+//------------------------------------------------------------------------
+// Scope message (processor → controller): a batch of ScopeFrame records
+// (record_message.h)
+//------------------------------------------------------------------------
+namespace ScopeMessage {
+    constexpr const char* kId = "StereoScope";
+    constexpr size_t kMaxRecords = 8;  // Frames per message (processor queue capacity)
+}
+
+} // namespace SimplePanner
+} // namespace Steinberg
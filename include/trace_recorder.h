@@ -0,0 +1,237 @@
+// trace_recorder.h
+// Optional Chrome trace of lifecycle calls and sampled process() blocks
+//
+// With PluginInfo::kTraceEnv (SIMPLEPANNER_TRACE) set to a file path, the
+// TraceScope objects in the processor, controller and editor record one
+// complete event each into a lock-free MpscRingBuffer, and a background
+// thread writes them to the file in the Chrome trace event format (open it
+// in chrome://tracing or ui.perfetto.dev). Without the variable
+// TraceRecorder::get() returns nullptr and a TraceScope costs one branch.
+
+#pragma once
+
+#include "plugids.h"
+#include "background_writer.h"
+#include "mpsc_ring_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+//------------------------------------------------------------------------
+// One complete ("X") trace event
+//------------------------------------------------------------------------
+struct TraceEvent {
+    const char* category;   ///< String literal
+    const char* name;       ///< String literal
+    uint32 instance;        ///< Object number (TraceRecorder::nextInstance())
+    uint64 thread;          ///< Recording thread
+    int64 startNanos;       ///< Since the recorder was created
+    int64 durationNanos;
+};
+
+/**
+ * @brief Collects trace events from any thread and writes them to a file
+ *
+ * record() never allocates, locks or does I/O, so it may run on the audio
+ * thread: it reads the clock and pushes one TraceEvent. The writer thread
+ * wakes every kWriteIntervalMs and appends the queued events to the file;
+ * events arriving while the buffer is full are counted and dropped. The
+ * destructor writes what is left and closes the JSON array.
+ */
+class TraceRecorder {
+public:
+    static constexpr size_t kCapacity = 4096;       // Events buffered between writes
+    static constexpr int kWriteIntervalMs = 50;
+
+    /**
+     * @brief Recorder of this module, created on first use
+     * @return nullptr unless PluginInfo::kTraceEnv names a writable file,
+     *         and after shutdown()
+     */
+    static TraceRecorder* get() {
+        return current().load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Write what is queued, close the file and stop the writer thread
+     *
+     * Called when the module is unloaded (ModuleTerminator in
+     * pluginfactory.cpp), while no traced object is left. The recorder is
+     * not a static object: its destructor joins the writer thread, which
+     * must not happen in static destruction (under the loader lock on
+     * Windows).
+     */
+    static void shutdown() {
+        delete current().exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Number for a new traced object (any thread)
+     */
+    static uint32 nextInstance() {
+        static std::atomic<uint32> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Open a trace file and start the writer thread
+     * @param path File to (over)write; check isOpen()
+     */
+    explicit TraceRecorder(const char* path)
+        : mFile(path ? std::fopen(path, "w") : nullptr)
+        , mStart(std::chrono::steady_clock::now())
+        , mNumWritten(0)
+        , mNumDropped(0)
+    {
+        if (!mFile)
+            return;
+
+        std::fputs("[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"", mFile);
+        std::fputs(PluginInfo::kName, mFile);
+        std::fputs("\"}}", mFile);
+        mWriter.start(kWriteIntervalMs, [this] { writeEvents(); });
+    }
+
+    ~TraceRecorder() {
+        if (!mFile)
+            return;
+
+        mWriter.stop();
+
+        writeEvents();
+        std::fprintf(mFile, ",\n{\"name\":\"dropped events\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,"
+                            "\"ts\":%lld,\"args\":{\"count\":%llu}}\n]\n",
+                     static_cast<long long>(now() / 1000),
+                     static_cast<unsigned long long>(mNumDropped.load(std::memory_order_relaxed)));
+        std::fclose(mFile);
+    }
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    bool isOpen() const { return mFile != nullptr; }
+
+    /**
+     * @brief Nanoseconds since the recorder was created
+     */
+    int64 now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - mStart).count();
+    }
+
+    /**
+     * @brief Queue a complete event (any thread, lock-free)
+     * @param category String literal
+     * @param name String literal
+     * @param instance Object number
+     * @param startNanos now() at the start
+     * @param endNanos now() at the end
+     */
+    void record(const char* category, const char* name, uint32 instance, int64 startNanos, int64 endNanos) {
+        TraceEvent event;
+        event.category = category;
+        event.name = name;
+        event.instance = instance;
+        event.thread = static_cast<uint64>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        event.startNanos = startNanos;
+        event.durationNanos = endNanos - startNanos;
+        if (!mEvents.push(event))
+            mNumDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64 numWritten() const { return mNumWritten.load(std::memory_order_relaxed); }
+    uint64 numDropped() const { return mNumDropped.load(std::memory_order_relaxed); }
+
+private:
+    static std::atomic<TraceRecorder*>& current() {
+        static std::atomic<TraceRecorder*> recorder{create(std::getenv(PluginInfo::kTraceEnv)).release()};
+        return recorder;
+    }
+
+    static std::unique_ptr<TraceRecorder> create(const char* path) {
+        if (!path || !*path)
+            return nullptr;
+
+        std::unique_ptr<TraceRecorder> recorder(new TraceRecorder(path));
+        if (!recorder->isOpen())
+            return nullptr;
+        return recorder;
+    }
+
+    // Append the queued events (consumer thread only)
+    void writeEvents() {
+        TraceEvent events[256];
+        size_t count;
+        while ((count = mEvents.pop(events, 256)) > 0) {
+            for (size_t i = 0; i < count; ++i)
+                writeEvent(events[i]);
+            mNumWritten.fetch_add(count, std::memory_order_relaxed);
+        }
+        std::fflush(mFile);
+    }
+
+    // Times in microseconds with three decimals, independent of the C locale
+    void writeEvent(const TraceEvent& event) {
+        std::fprintf(mFile,
+                     ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,"
+                     "\"ts\":%lld.%03lld,\"dur\":%lld.%03lld,\"args\":{\"instance\":%u}}",
+                     event.name, event.category,
+                     static_cast<unsigned long long>(event.thread),
+                     static_cast<long long>(event.startNanos / 1000),
+                     static_cast<long long>(event.startNanos % 1000),
+                     static_cast<long long>(event.durationNanos / 1000),
+                     static_cast<long long>(event.durationNanos % 1000),
+                     static_cast<unsigned>(event.instance));
+    }
+
+    std::FILE* mFile;
+    std::chrono::steady_clock::time_point mStart;
+    MpscRingBuffer<TraceEvent, kCapacity> mEvents;
+    std::atomic<uint64> mNumWritten;
+    std::atomic<uint64> mNumDropped;
+    BackgroundWriter mWriter;
+};
+
+/**
+ * @brief Records the lifetime of a scope as a trace event
+ *
+ * Does nothing when tracing is off or enabled is false (e.g. process()
+ * blocks that are not sampled).
+ */
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name, uint32 instance, bool enabled = true)
+        : mRecorder(enabled ? TraceRecorder::get() : nullptr)
+        , mCategory(category)
+        , mName(name)
+        , mInstance(instance)
+        , mStartNanos(mRecorder ? mRecorder->now() : 0)
+    {
+    }
+
+    ~TraceScope() {
+        if (mRecorder)
+            mRecorder->record(mCategory, mName, mInstance, mStartNanos, mRecorder->now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    TraceRecorder* mRecorder;
+    const char* mCategory;
+    const char* mName;
+    uint32 mInstance;
+    int64 mStartNanos;
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
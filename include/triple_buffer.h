@@ -0,0 +1,82 @@
+// triple_buffer.h
+// Lock-free, wait-free single producer / single consumer value handoff
+
+#pragma once
+
+#include <atomic>
+
+namespace Steinberg {
+namespace SimplePanner {
+
+/**
+ * @brief Triple buffer for passing the latest value between two threads
+ *
+ * The producer fills its private slot and publishes it by exchanging it with
+ * the shared middle slot; the consumer takes the middle slot the same way.
+ * Both sides do one atomic exchange and never wait, and all three slots are
+ * preallocated, so the consumer side is safe on the audio thread.
+ * Intermediate values published before the consumer looks are dropped.
+ *
+ * Exactly one producer thread and one consumer thread may use it at a time.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer()
+        : mSlots()
+        , mWriteIndex(0)
+        , mMiddle(1)
+        , mReadIndex(2)
+    {
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    //--------------------------------------------------------------------
+    // Producer side
+    //--------------------------------------------------------------------
+
+    /**
+     * @brief Publish a value, replacing any value not yet consumed
+     * @param value Value to hand to the consumer
+     */
+    void publish(const T& value) {
+        mSlots[mWriteIndex] = value;
+        int previous = mMiddle.exchange(mWriteIndex | kNewDataFlag, std::memory_order_acq_rel);
+        mWriteIndex = previous & kIndexMask;
+    }
+
+    //--------------------------------------------------------------------
+    // Consumer side
+    //--------------------------------------------------------------------
+
+    /**
+     * @brief Take the most recently published value, if any
+     * @param value Receives the value; untouched if nothing new was published
+     * @return True if a new value was taken
+     */
+    bool consume(T& value) {
+        if ((mMiddle.load(std::memory_order_relaxed) & kNewDataFlag) == 0) {
+            return false;
+        }
+        int previous = mMiddle.exchange(mReadIndex, std::memory_order_acq_rel);
+        mReadIndex = previous & kIndexMask;
+        value = mSlots[mReadIndex];
+        return true;
+    }
+
+private:
+    static constexpr int kIndexMask = 0x3;
+    static constexpr int kNewDataFlag = 0x4;
+
+    static_assert(std::atomic<int>::is_always_lock_free, "TripleBuffer requires a lock-free atomic int");
+
+    T mSlots[3];                 ///< Preallocated value slots
+    int mWriteIndex;             ///< Producer's private slot
+    std::atomic<int> mMiddle;    ///< Shared slot index | kNewDataFlag
+    int mReadIndex;              ///< Consumer's private slot
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
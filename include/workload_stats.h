@@ -0,0 +1,254 @@
+// workload_stats.h
+// Histograms of the work hosts feed process(), for performance work
+//
+// The audio thread adds every block to WorkloadStats: block size,
+// parameter queues and points, input silence flags, process mode and the
+// sample rate the block ran at. Everything is counted into fixed arrays;
+// write() turns the totals into a JSON file when the processor terminates
+// (PluginInfo::kStatsDirEnv).
+
+#pragma once
+
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Steinberg {
+namespace SimplePanner {
+
+// Power-of-two buckets: 0, 1, 2-3, 4-7, ..., 32768 and above
+constexpr int32 kWorkloadBuckets = 17;
+
+/**
+ * @brief Bucket of a count: 0 for zero, otherwise floor(log2(value)) + 1
+ */
+inline int32 workloadBucket(int64 value) {
+    int32 bucket = 0;
+    for (; value > 0 && bucket < kWorkloadBuckets - 1; value >>= 1)
+        ++bucket;
+    return bucket;
+}
+
+/**
+ * @brief Smallest value of a bucket
+ */
+inline int64 workloadBucketLow(int32 bucket) {
+    return bucket == 0 ? 0 : int64(1) << (bucket - 1);
+}
+
+/**
+ * @brief ID of this process, for output file names
+ */
+inline int64 currentProcessId() {
+#if defined(_WIN32)
+    return static_cast<int64>(_getpid());
+#else
+    return static_cast<int64>(getpid());
+#endif
+}
+
+//------------------------------------------------------------------------
+// Histogram of one per-block quantity
+//------------------------------------------------------------------------
+struct WorkloadHistogram {
+    int64 counts[kWorkloadBuckets];  ///< Blocks per bucket
+    int64 min;                       ///< Smallest value (valid if any block)
+    int64 max;                       ///< Largest value
+    int64 total;                     ///< Sum of the values
+
+    void clear() {
+        std::memset(counts, 0, sizeof(counts));
+        min = 0;
+        max = 0;
+        total = 0;
+    }
+
+    // blocks: blocks added before this one (first block sets min / max)
+    void add(int64 value, int64 blocks) {
+        ++counts[workloadBucket(value)];
+        min = (blocks == 0) ? value : std::min(min, value);
+        max = (blocks == 0) ? value : std::max(max, value);
+        total += value;
+    }
+};
+
+/**
+ * @brief Workload histograms of one processor instance
+ *
+ * add() is O(number of parameter queues) and never allocates; only the
+ * audio thread calls it. setSampleRate() and write() run on the thread
+ * calling setupProcessing / terminate, while the audio thread is stopped.
+ */
+class WorkloadStats {
+public:
+    static constexpr int32 kMaxSampleRates = 8;   // Distinct rates tracked; more share the last row
+    static constexpr int32 kProcessModes = 3;     // Vst::ProcessModes: realtime, prefetch, offline
+
+    WorkloadStats() { clear(); }
+
+    void clear() {
+        mBlocks = 0;
+        mBlockSizes.clear();
+        mNonPowerOfTwoBlocks = 0;
+        mParameterQueues.clear();
+        mParameterPoints.clear();
+        mSilentBlocks = 0;
+        mPartlySilentBlocks = 0;
+        std::fill_n(mModeBlocks, kProcessModes, int64(0));
+        mNumSampleRates = 0;
+        mSampleRateIndex = -1;
+    }
+
+    /**
+     * @brief Set the sample rate of the blocks that follow
+     */
+    void setSampleRate(double sampleRate) {
+        for (mSampleRateIndex = 0; mSampleRateIndex < mNumSampleRates; ++mSampleRateIndex) {
+            if (mSampleRates[mSampleRateIndex].sampleRate == sampleRate)
+                return;
+        }
+        if (mNumSampleRates == kMaxSampleRates) {
+            mSampleRateIndex = kMaxSampleRates - 1;
+            return;
+        }
+        mSampleRates[mNumSampleRates].sampleRate = sampleRate;
+        mSampleRates[mNumSampleRates].blocks = 0;
+        ++mNumSampleRates;
+    }
+
+    /**
+     * @brief Add one process() call
+     */
+    void add(Vst::ProcessData& data) {
+        int32 numSamples = std::max<int32>(data.numSamples, 0);
+        mBlockSizes.add(numSamples, mBlocks);
+        if (numSamples > 0 && (numSamples & (numSamples - 1)) != 0)
+            ++mNonPowerOfTwoBlocks;
+
+        int32 numQueues = data.inputParameterChanges ? data.inputParameterChanges->getParameterCount() : 0;
+        int32 numPoints = 0;
+        for (int32 i = 0; i < numQueues; ++i) {
+            Vst::IParamValueQueue* queue = data.inputParameterChanges->getParameterData(i);
+            if (queue)
+                numPoints += queue->getPointCount();
+        }
+        mParameterQueues.add(numQueues, mBlocks);
+        mParameterPoints.add(numPoints, mBlocks);
+
+        if (data.numInputs > 0 && data.inputs[0].numChannels > 0) {
+            int32 numChannels = std::min<int32>(data.inputs[0].numChannels, 64);
+            uint64 allChannels = (numChannels == 64) ? ~uint64(0) : (uint64(1) << numChannels) - 1;
+            uint64 silent = data.inputs[0].silenceFlags & allChannels;
+            if (silent == allChannels)
+                ++mSilentBlocks;
+            else if (silent != 0)
+                ++mPartlySilentBlocks;
+        }
+
+        if (data.processMode >= 0 && data.processMode < kProcessModes)
+            ++mModeBlocks[data.processMode];
+        if (mSampleRateIndex >= 0)
+            ++mSampleRates[mSampleRateIndex].blocks;
+
+        ++mBlocks;
+    }
+
+    int64 numBlocks() const { return mBlocks; }
+    const WorkloadHistogram& blockSizes() const { return mBlockSizes; }
+    const WorkloadHistogram& parameterQueues() const { return mParameterQueues; }
+    const WorkloadHistogram& parameterPoints() const { return mParameterPoints; }
+    int64 nonPowerOfTwoBlocks() const { return mNonPowerOfTwoBlocks; }
+    int64 silentBlocks() const { return mSilentBlocks; }
+    int64 partlySilentBlocks() const { return mPartlySilentBlocks; }
+    int64 modeBlocks(int32 mode) const { return mModeBlocks[mode]; }
+    int32 numSampleRates() const { return mNumSampleRates; }
+    double sampleRate(int32 index) const { return mSampleRates[index].sampleRate; }
+    int64 sampleRateBlocks(int32 index) const { return mSampleRates[index].blocks; }
+
+    /**
+     * @brief Write the statistics as JSON
+     * @param path File to (over)write
+     * @return false if the file could not be written
+     */
+    bool write(const char* path) const {
+        std::FILE* file = std::fopen(path, "w");
+        if (!file)
+            return false;
+
+        // Integers only, so the output does not depend on the C locale
+        std::fprintf(file, "{\n  \"blocks\": %lld,\n", static_cast<long long>(mBlocks));
+        writeHistogram(file, "blockSize", mBlockSizes);
+        std::fprintf(file, "  \"nonPowerOfTwoBlocks\": %lld,\n", static_cast<long long>(mNonPowerOfTwoBlocks));
+        writeHistogram(file, "parameterQueues", mParameterQueues);
+        writeHistogram(file, "parameterPoints", mParameterPoints);
+        std::fprintf(file, "  \"silentInputBlocks\": %lld,\n  \"partlySilentInputBlocks\": %lld,\n",
+                     static_cast<long long>(mSilentBlocks), static_cast<long long>(mPartlySilentBlocks));
+        std::fprintf(file, "  \"processMode\": {\"realtime\": %lld, \"prefetch\": %lld, \"offline\": %lld},\n",
+                     static_cast<long long>(mModeBlocks[Vst::kRealtime]),
+                     static_cast<long long>(mModeBlocks[Vst::kPrefetch]),
+                     static_cast<long long>(mModeBlocks[Vst::kOffline]));
+        std::fputs("  \"sampleRates\": [", file);
+        bool first = true;
+        for (int32 i = 0; i < mNumSampleRates; ++i) {
+            if (mSampleRates[i].blocks == 0)
+                continue;
+            std::fprintf(file, "%s{\"hz\": %lld, \"blocks\": %lld}", first ? "" : ", ",
+                         static_cast<long long>(std::llround(mSampleRates[i].sampleRate)),
+                         static_cast<long long>(mSampleRates[i].blocks));
+            first = false;
+        }
+        std::fputs("]\n}\n", file);
+
+        bool written = !std::ferror(file);
+        return std::fclose(file) == 0 && written;
+    }
+
+private:
+    struct SampleRateBlocks {
+        double sampleRate;
+        int64 blocks;
+    };
+
+    // "name": {"min": .., "max": .., "mean": .., "buckets": [{"from": .., "blocks": ..}, ...]}
+    // (empty buckets left out; mean rounded down)
+    void writeHistogram(std::FILE* file, const char* name, const WorkloadHistogram& histogram) const {
+        std::fprintf(file, "  \"%s\": {\"min\": %lld, \"max\": %lld, \"mean\": %lld, \"buckets\": [",
+                     name, static_cast<long long>(histogram.min), static_cast<long long>(histogram.max),
+                     static_cast<long long>(mBlocks > 0 ? histogram.total / mBlocks : 0));
+        bool first = true;
+        for (int32 bucket = 0; bucket < kWorkloadBuckets; ++bucket) {
+            if (histogram.counts[bucket] == 0)
+                continue;
+            std::fprintf(file, "%s{\"from\": %lld, \"blocks\": %lld}", first ? "" : ", ",
+                         static_cast<long long>(workloadBucketLow(bucket)),
+                         static_cast<long long>(histogram.counts[bucket]));
+            first = false;
+        }
+        std::fputs("]},\n", file);
+    }
+
+    int64 mBlocks;
+    WorkloadHistogram mBlockSizes;
+    int64 mNonPowerOfTwoBlocks;
+    WorkloadHistogram mParameterQueues;
+    WorkloadHistogram mParameterPoints;
+    int64 mSilentBlocks;         // Every input channel flagged silent
+    int64 mPartlySilentBlocks;   // Some but not all
+    int64 mModeBlocks[kProcessModes];
+    SampleRateBlocks mSampleRates[kMaxSampleRates];
+    int32 mNumSampleRates;
+    int32 mSampleRateIndex;      // Row of the current sample rate (-1: none yet)
+};
+
+} // namespace SimplePanner
+} // namespace Steinberg
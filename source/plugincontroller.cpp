@@ -2,10 +2,17 @@
 #include "plugineditor.h"
 #include "plugids.h"
 #include "parameter_utils.h"
+#include "state_serializer.h"
+#include "plugin_parameters.h"
+#include "record_message.h"
+#include "stereo_analyzer.h"
+#include "trace_recorder.h"
 
-#include "base/source/fstreamer.h"
 #include "pluginterfaces/base/ibstream.h"
 #include "pluginterfaces/vst/ivstparameterchanges.h"
+#include "pluginterfaces/vst/ivstmessage.h"
+
+#include <cstdlib>
 
 namespace Steinberg {
 namespace SimplePanner {
@@ -14,6 +21,9 @@ namespace SimplePanner {
 // SimplePannerController
 //------------------------------------------------------------------------
 SimplePannerController::SimplePannerController()
+    : mEditor(nullptr)
+    , mProcessTiming()
+    , mTraceInstance(TraceRecorder::nextInstance())
 {
 }
 
@@ -25,74 +35,41 @@ SimplePannerController::~SimplePannerController()
 //------------------------------------------------------------------------
 tresult PLUGIN_API SimplePannerController::initialize(FUnknown* context)
 {
-    tresult result = EditController::initialize(context);
+    TraceScope trace("lifecycle", "Controller::initialize", mTraceInstance);
+
+    tresult result = EditControllerEx1::initialize(context);
     if (result != kResultOk)
         return result;
 
-    // Register parameters
-    // Left Pan: -100 to +100
-    parameters.addParameter(STR16("Left Pan"),
-                           STR16(""),
-                           0,  // stepCount (0 = continuous)
-                           panToNormalized(ParamDefault::kLeftPan),
-                           Vst::ParameterInfo::kCanAutomate,
-                           kParamLeftPan);
-
-    // Left Gain: -60dB to +6dB
-    parameters.addParameter(STR16("Left Gain"),
-                           STR16("dB"),
-                           0,
-                           dbToNormalized(ParamDefault::kLeftGain),
-                           Vst::ParameterInfo::kCanAutomate,
-                           kParamLeftGain);
-
-    // Left Delay: 0ms to 100ms
-    parameters.addParameter(STR16("Left Delay"),
-                           STR16("ms"),
-                           0,
-                           delayMsToNormalized(ParamDefault::kLeftDelay),
-                           Vst::ParameterInfo::kCanAutomate,
-                           kParamLeftDelay);
-
-    // Right Pan: -100 to +100
-    parameters.addParameter(STR16("Right Pan"),
-                           STR16(""),
-                           0,
-                           panToNormalized(ParamDefault::kRightPan),
-                           Vst::ParameterInfo::kCanAutomate,
-                           kParamRightPan);
-
-    // Right Gain: -60dB to +6dB
-    parameters.addParameter(STR16("Right Gain"),
-                           STR16("dB"),
-                           0,
-                           dbToNormalized(ParamDefault::kRightGain),
-                           Vst::ParameterInfo::kCanAutomate,
-                           kParamRightGain);
-
-    // Right Delay: 0ms to 100ms
-    parameters.addParameter(STR16("Right Delay"),
-                           STR16("ms"),
-                           0,
-                           delayMsToNormalized(ParamDefault::kRightDelay),
-                           Vst::ParameterInfo::kCanAutomate,
-                           kParamRightDelay);
-
-    // Master Gain: -60dB to +6dB
-    parameters.addParameter(STR16("Master Gain"),
-                           STR16("dB"),
-                           0,
-                           dbToNormalized(ParamDefault::kMasterGain),
-                           Vst::ParameterInfo::kCanAutomate,
-                           kParamMasterGain);
-
-    // Link L/R Gain: On/Off
-    parameters.addParameter(STR16("Link L/R Gain"),
-                           STR16(""),
-                           1,  // stepCount (1 = on/off toggle)
-                           ParamDefault::kLinkGain,
-                           Vst::ParameterInfo::kCanAutomate,
-                           kParamLinkGain);
+    // Register parameters from kParamTable (plugin_parameters.h: plain
+    // units, fast host strings)
+    for (const ParamDescriptor& param : kParamTable)
+        parameters.addParameter(createParameter(param));
+
+    // Capture B: On copies the current settings into snapshot B; the
+    // processor reports it back to Off through outputParameterChanges
+    parameters.addParameter(new ToggleParameter(STR16("Capture B"), kParamCaptureB, 0.0,
+                                                0));  // Momentary action, not automated
+
+    // Output meters: read-only, written by the processor's outputParameterChanges
+    parameters.addParameter(new MeterParameter(STR16("Peak L"), kParamPeakLeft));
+    parameters.addParameter(new MeterParameter(STR16("Peak R"), kParamPeakRight));
+    parameters.addParameter(new MeterParameter(STR16("RMS L"), kParamRmsLeft));
+    parameters.addParameter(new MeterParameter(STR16("RMS R"), kParamRmsRight));
+
+    // Presets: one program list on the root unit, one program per bank record
+    if (!mPresetBank.isAttached())
+        loadPresetBank(std::getenv(PluginInfo::kPresetBankEnv));
+
+    // Nothing is read per preset here: names come from the mapped bank when
+    // the host asks for them
+    Vst::ProgramList* programList = new PresetProgramList(STR16("Presets"), kPresetListId, mPresetBank);
+
+    addUnit(new Vst::Unit(STR16("Root"), Vst::kRootUnitId, Vst::kNoParentUnitId, kPresetListId));
+    addProgramList(programList);
+
+    // Program Change: selected by the host, not automated
+    parameters.addParameter(programList->getParameter());
 
     return kResultTrue;
 }
@@ -100,59 +77,123 @@ tresult PLUGIN_API SimplePannerController::initialize(FUnknown* context)
 //------------------------------------------------------------------------
 tresult PLUGIN_API SimplePannerController::terminate()
 {
-    return EditController::terminate();
+    mPresetBank.detach();
+    mPresetFile.close();
+
+    return EditControllerEx1::terminate();
 }
 
 //------------------------------------------------------------------------
-tresult PLUGIN_API SimplePannerController::setComponentState(IBStream* state)
+bool SimplePannerController::loadPresetBank(const char* path)
 {
-    if (!state)
-        return kResultFalse;
+    // Only the header is checked; names and records are read in place when
+    // the host asks for a name or selects a program
+    mPresetBank.detach();
+    if (!mPresetFile.open(path))
+        return false;
 
-    IBStreamer streamer(state, kLittleEndian);
+    if (!mPresetBank.attach(mPresetFile.data(), mPresetFile.size()))
+    {
+        mPresetFile.close();
+        return false;
+    }
+    return true;
+}
 
-    // Read version
-    int32 version = 0;
-    if (!streamer.readInt32(version))
-        return kResultFalse;
+//------------------------------------------------------------------------
+tresult PLUGIN_API SimplePannerController::setComponentState(IBStream* state)
+{
+    TraceScope trace("lifecycle", "Controller::setComponentState", mTraceInstance);
 
-    if (version != 1)
+    // Same format as the processor's getState; missing fields keep their defaults
+    PluginState loaded = PluginState::defaults();
+    if (!StateSerializer::read(state, loaded))
         return kResultFalse;
 
-    // Read 8 parameter values (normalized)
-    double leftPan, leftGain, leftDelay;
-    double rightPan, rightGain, rightDelay;
-    double masterGain, linkGain;
-
-    if (!streamer.readDouble(leftPan)) return kResultFalse;
-    if (!streamer.readDouble(leftGain)) return kResultFalse;
-    if (!streamer.readDouble(leftDelay)) return kResultFalse;
-    if (!streamer.readDouble(rightPan)) return kResultFalse;
-    if (!streamer.readDouble(rightGain)) return kResultFalse;
-    if (!streamer.readDouble(rightDelay)) return kResultFalse;
-    if (!streamer.readDouble(masterGain)) return kResultFalse;
-    if (!streamer.readDouble(linkGain)) return kResultFalse;
-
-    // Set parameter values
-    setParamNormalized(kParamLeftPan, leftPan);
-    setParamNormalized(kParamLeftGain, leftGain);
-    setParamNormalized(kParamLeftDelay, leftDelay);
-    setParamNormalized(kParamRightPan, rightPan);
-    setParamNormalized(kParamRightGain, rightGain);
-    setParamNormalized(kParamRightDelay, rightDelay);
-    setParamNormalized(kParamMasterGain, masterGain);
-    setParamNormalized(kParamLinkGain, linkGain);
+    applyComponentState(loaded);
 
     return kResultOk;
 }
 
+//------------------------------------------------------------------------
+void SimplePannerController::applyComponentState(const PluginState& state)
+{
+    PluginState resolved = state;
+
+    // Resolve Link L/R Gain once for the whole state instead of per value:
+    // linked gains follow Left Gain
+    if (resolved.values[kParamLinkGain] >= 0.5)
+        resolved.values[kParamRightGain] = resolved.values[kParamLeftGain];
+
+    // Bypass the per-value link handling of setParamNormalized
+    for (int32 i = 0; i < StateSerializer::kNumParams; ++i)
+        EditController::setParamNormalized(static_cast<Vst::ParamID>(i), resolved.values[i]);
+
+    // One refresh for all values instead of one per parameter. The host
+    // re-reads the values itself after setComponentState, so no host
+    // notification here
+    if (mEditor)
+        mEditor->syncAllParameters();
+}
+
+//------------------------------------------------------------------------
+void SimplePannerController::applyProgram(int32 index)
+{
+    // Without a bank the single "Default" program recalls the defaults
+    PluginState state = PluginState::defaults();
+    if (mPresetBank.count() > 0)
+    {
+        // Fields the bank does not store keep their current values
+        for (int32 i = 0; i < StateSerializer::kNumParams; ++i)
+            state.values[i] = getParamNormalized(static_cast<Vst::ParamID>(i));
+
+        if (!mPresetBank.load(index, state))
+            return;
+    }
+
+    // The processor receives the same program change and applies the record
+    // from its own copy of the bank at the change's sample offset
+    applyComponentState(state);
+
+    // The host did not load a state, so tell it once that all values changed
+    if (componentHandler)
+        componentHandler->restartComponent(Vst::kParamValuesChanged);
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API SimplePannerController::setParamNormalized(Vst::ParamID tag, Vst::ParamValue value)
 {
+    // Program Change: look the preset up in the bank
+    if (tag == kParamProgram)
+    {
+        tresult result = EditControllerEx1::setParamNormalized(tag, value);
+        if (result == kResultOk)
+        {
+            Vst::Parameter* program = getParameterObject(kParamProgram);
+            applyProgram(static_cast<int32>(program->toPlain(value)));
+        }
+        return result;
+    }
+
+    // Output meters: the host forwards the processor's reports ~30 times a second
+    if (tag >= kParamPeakLeft && tag <= kParamRmsRight)
+    {
+        tresult result = EditController::setParamNormalized(tag, value);
+        if (result == kResultOk && mEditor)
+            mEditor->updateMeters();
+        return result;
+    }
+
     // Handle Link Gain feature
     Vst::ParamValue linkGain = getParamNormalized(kParamLinkGain);
     bool isLinkEnabled = (linkGain >= 0.5);
 
+    // Engaging the link: Right Gain follows Left Gain, as in the processor
+    if (tag == kParamLinkGain && value >= 0.5 && !isLinkEnabled)
+    {
+        EditController::setParamNormalized(kParamRightGain, getParamNormalized(kParamLeftGain));
+    }
+
     if (isLinkEnabled)
     {
         // If Link is enabled and Left Gain changes, also change Right Gain
@@ -171,6 +212,51 @@ tresult PLUGIN_API SimplePannerController::setParamNormalized(Vst::ParamID tag,
     return EditController::setParamNormalized(tag, value);
 }
 
+//------------------------------------------------------------------------
+tresult PLUGIN_API SimplePannerController::notify(Vst::IMessage* message)
+{
+    if (message && message->getMessageID() && strcmp(message->getMessageID(), TimingMessage::kId) == 0)
+    {
+        // One summary per measurement period since the last message; show the latest
+        ProcessTimingSummary summaries[TimingMessage::kMaxRecords];
+        size_t count = readRecords(message->getAttributes(), summaries, TimingMessage::kMaxRecords);
+        if (count == 0)
+            return kResultFalse;
+
+        mProcessTiming = summaries[count - 1];
+        if (mEditor)
+            mEditor->updateProcessTiming(mProcessTiming);
+        return kResultOk;
+    }
+
+    if (message && message->getMessageID() && strcmp(message->getMessageID(), ScopeMessage::kId) == 0)
+    {
+        // Frames since the last message; the scope shows the latest one
+        ScopeFrame frames[ScopeMessage::kMaxRecords];
+        size_t count = readRecords(message->getAttributes(), frames, ScopeMessage::kMaxRecords);
+        if (count == 0)
+            return kResultFalse;
+
+        if (mEditor)
+            mEditor->updateStereoScope(frames[count - 1]);
+        return kResultOk;
+    }
+
+    return EditControllerEx1::notify(message);
+}
+
+//------------------------------------------------------------------------
+void SimplePannerController::requestTelemetry()
+{
+    // Hosts without message support return no message: no telemetry
+    IPtr<Vst::IMessage> message = owned(allocateMessage());
+    if (!message)
+        return;
+
+    message->setMessageID(TelemetryPoll::kId);
+    sendMessage(message);
+}
+
 //------------------------------------------------------------------------
 IPlugView* PLUGIN_API SimplePannerController::createView(const char* name)
 {
@@ -183,5 +269,22 @@ IPlugView* PLUGIN_API SimplePannerController::createView(const char* name)
     return nullptr;
 }
 
+//------------------------------------------------------------------------
+void SimplePannerController::editorAttached(Vst::EditorView* editor)
+{
+    mEditor = dynamic_cast<SimplePannerEditor*>(editor);
+
+    // The editor opens before it is attached; show the last telemetry right away
+    if (mEditor)
+        mEditor->updateProcessTiming(mProcessTiming);
+}
+
+//------------------------------------------------------------------------
+void SimplePannerController::editorRemoved(Vst::EditorView* editor)
+{
+    if (mEditor == editor)
+        mEditor = nullptr;
+}
+
 } // namespace SimplePanner
 } // namespace Steinberg
@@ -1,7 +1,11 @@
 #include "plugineditor.h"
+#include "plugincontroller.h"
 #include "parameter_utils.h"
-#include <sstream>
-#include <iomanip>
+#include "parameter_format.h"
+#include "record_message.h"
+#include "trace_recorder.h"
+
+#include <algorithm>
 
 namespace Steinberg {
 namespace SimplePanner {
@@ -32,6 +36,11 @@ SimplePannerEditor::SimplePannerEditor(void* controller)
 , mLeftDelayLabel(nullptr)
 , mRightDelayLabel(nullptr)
 , mMasterGainLabel(nullptr)
+, mTimingLabel(nullptr)
+, mLeftMeter(nullptr)
+, mRightMeter(nullptr)
+, mStereoScope(nullptr)
+, mTraceInstance(TraceRecorder::nextInstance())
 {
     // Set editor size
     ViewRect viewRect(0, 0, kEditorWidth, kEditorHeight);
@@ -51,6 +60,8 @@ SimplePannerEditor::~SimplePannerEditor()
 //------------------------------------------------------------------------
 bool PLUGIN_API SimplePannerEditor::open(void* parent, const PlatformType& platformType)
 {
+    TraceScope trace("ui", "Editor::open", mTraceInstance);
+
     // Create CFrame (main window)
     CRect frameSize(0, 0, kEditorWidth, kEditorHeight);
     CFrame* newFrame = new CFrame(frameSize, this);
@@ -75,6 +86,15 @@ bool PLUGIN_API SimplePannerEditor::open(void* parent, const PlatformType& platf
         return false;
     }
 
+    // Timing and scope records reach the controller only when asked for.
+    // VSTGUI timers run on the UI thread on every platform (the host's
+    // IRunLoop on Linux), so the processor's queues have one consumer.
+    if (auto* controller = dynamic_cast<SimplePannerController*>(getController()))
+    {
+        mTelemetryTimer = makeOwned<CVSTGUITimer>(
+            [controller](CVSTGUITimer*) { controller->requestTelemetry(); }, TelemetryPoll::kIntervalMs);
+    }
+
     return true;
 }
 
@@ -83,6 +103,13 @@ bool PLUGIN_API SimplePannerEditor::open(void* parent, const PlatformType& platf
 //------------------------------------------------------------------------
 void PLUGIN_API SimplePannerEditor::close()
 {
+    // No more polls once the labels and the scope are gone
+    if (mTelemetryTimer)
+    {
+        mTelemetryTimer->stop();
+        mTelemetryTimer = nullptr;
+    }
+
     // Clear control pointers (CFrame will handle deletion)
     mLeftPanSlider = nullptr;
     mRightPanSlider = nullptr;
@@ -99,6 +126,10 @@ void PLUGIN_API SimplePannerEditor::close()
     mLeftDelayLabel = nullptr;
     mRightDelayLabel = nullptr;
     mMasterGainLabel = nullptr;
+    mTimingLabel = nullptr;
+    mLeftMeter = nullptr;
+    mRightMeter = nullptr;
+    mStereoScope = nullptr;
 
     // Close and release the frame
     if (frame)
@@ -114,6 +145,8 @@ void PLUGIN_API SimplePannerEditor::close()
 //------------------------------------------------------------------------
 bool SimplePannerEditor::createUI()
 {
+    TraceScope trace("ui", "Editor::createUI", mTraceInstance);
+
     CFrame* frm = getFrame();
     if (!frm)
         return false;
@@ -469,6 +502,44 @@ bool SimplePannerEditor::createUI()
         mLinkToggle->setValue(linkValue);
     }
 
+    // === Output Meters (read-only, peak and RMS from the processor) ===
+    const char* meterNames[2] = {"L", "R"};
+    LevelMeterView** meters[2] = {&mLeftMeter, &mRightMeter};
+    for (int32 i = 0; i < 2; ++i)
+    {
+        CRect meterLabelRect(15, 50 + i * 22, 25, 62 + i * 22);
+        CTextLabel* meterLabel = new CTextLabel(meterLabelRect, meterNames[i]);
+        meterLabel->setFont(kNormalFontSmall);
+        meterLabel->setFontColor(CColor(176, 176, 176, 255)); // #B0B0B0 - Light gray
+        meterLabel->setBackColor(CColor(80, 80, 80, 0)); // Transparent
+        meterLabel->setFrameColor(CColor(0, 0, 0, 0));
+        meterLabel->setStyle(CTextLabel::kNoDrawStyle);
+        meterLabel->setHoriAlign(CHoriTxtAlign::kCenterText);
+        masterGroup->addView(meterLabel);
+
+        CRect meterRect(30, 50 + i * 22, 220, 62 + i * 22);
+        *meters[i] = new LevelMeterView(meterRect);
+        masterGroup->addView(*meters[i]);
+    }
+    updateMeters();
+
+    // === Stereo Scope (read-only, goniometer and correlation from the processor) ===
+    CRect stereoScopeRect(460, 8, 550, 112);
+    mStereoScope = new StereoScopeView(stereoScopeRect);
+    masterGroup->addView(mStereoScope);
+
+    // === Telemetry (read-only, filled by the controller) ===
+    CRect timingLabelRect(20, 370, 580, 390);
+    mTimingLabel = new CTextLabel(timingLabelRect, formatTimingValue({}).c_str());
+    mTimingLabel->setFont(kNormalFontSmall);
+    mTimingLabel->setFontColor(CColor(176, 176, 176, 255)); // #B0B0B0 - Light gray
+    mTimingLabel->setBackColor(CColor(60, 60, 60, 0)); // Transparent
+    mTimingLabel->setFrameColor(CColor(0, 0, 0, 0));
+    mTimingLabel->setStyle(CTextLabel::kNoDrawStyle);
+    mTimingLabel->setHoriAlign(CHoriTxtAlign::kLeftText);
+    mTimingLabel->setMouseEnabled(false);
+    frm->addView(mTimingLabel);
+
     return true;
 }
 
@@ -537,123 +608,307 @@ void SimplePannerEditor::controlEndEdit(CControl* control)
     }
 }
 
+//------------------------------------------------------------------------
+// syncAllParameters
+//------------------------------------------------------------------------
+void SimplePannerEditor::syncAllParameters()
+{
+    if (!getController())
+        return;
+
+    // Refresh every control and label from the controller in one pass
+    // (used after a whole state was loaded)
+    struct ControlBinding {
+        CControl* control;
+        Vst::ParamID tag;
+    };
+    const ControlBinding bindings[] = {
+        {mLeftPanSlider, kParamLeftPan},
+        {mLeftGainKnob, kParamLeftGain},
+        {mLeftDelayKnob, kParamLeftDelay},
+        {mRightPanSlider, kParamRightPan},
+        {mRightGainKnob, kParamRightGain},
+        {mRightDelayKnob, kParamRightDelay},
+        {mMasterGainKnob, kParamMasterGain},
+        {mLinkToggle, kParamLinkGain},
+    };
+
+    for (const ControlBinding& binding : bindings)
+    {
+        if (!binding.control)
+            continue;
+
+        binding.control->setValue(static_cast<float>(getController()->getParamNormalized(binding.tag)));
+        binding.control->invalid();
+        updateValueDisplay(binding.tag);
+    }
+}
+
+//------------------------------------------------------------------------
+// updateProcessTiming
+//------------------------------------------------------------------------
+void SimplePannerEditor::updateProcessTiming(const ProcessTimingSummary& summary)
+{
+    if (mTimingLabel)
+        mTimingLabel->setText(formatTimingValue(summary).c_str());
+}
+
+//------------------------------------------------------------------------
+// updateMeters
+//------------------------------------------------------------------------
+void SimplePannerEditor::updateMeters()
+{
+    if (!getController())
+        return;
+
+    if (mLeftMeter)
+        mLeftMeter->setLevels(static_cast<float>(getController()->getParamNormalized(kParamPeakLeft)),
+                              static_cast<float>(getController()->getParamNormalized(kParamRmsLeft)));
+    if (mRightMeter)
+        mRightMeter->setLevels(static_cast<float>(getController()->getParamNormalized(kParamPeakRight)),
+                               static_cast<float>(getController()->getParamNormalized(kParamRmsRight)));
+}
+
+//------------------------------------------------------------------------
+// updateStereoScope
+//------------------------------------------------------------------------
+void SimplePannerEditor::updateStereoScope(const ScopeFrame& frame)
+{
+    if (mStereoScope)
+        mStereoScope->setFrame(frame);
+}
+
 //------------------------------------------------------------------------
 // updateValueDisplay
 //------------------------------------------------------------------------
 void SimplePannerEditor::updateValueDisplay(Vst::ParamID tag)
 {
-    if (!getController())
+    if (!getController() || tag >= kParamCount)
+        return;
+
+    // Label and formatter come from the parameter's row, without a switch over IDs
+    CTextLabel* SimplePannerEditor::* label = kValueLabels[tag];
+    ValueFormatter format = kValueFormatters[kParamTable[tag].format];
+    if (!label || !(this->*label) || !format)
         return;
 
     float normalized = getController()->getParamNormalized(tag);
-    std::string text;
+    std::string text = (this->*format)(normalized);
+    (this->*label)->setText(text.c_str());
+}
 
-    // TODO: Update specific labels based on tag
+//------------------------------------------------------------------------
+// Value label table (indexed by ParameterID)
+//------------------------------------------------------------------------
+CTextLabel* SimplePannerEditor::* const SimplePannerEditor::kValueLabels[kParamCount] = {
+    &SimplePannerEditor::mLeftPanLabel,      // kParamLeftPan
+    &SimplePannerEditor::mLeftGainLabel,     // kParamLeftGain
+    &SimplePannerEditor::mLeftDelayLabel,    // kParamLeftDelay
+    &SimplePannerEditor::mRightPanLabel,     // kParamRightPan
+    &SimplePannerEditor::mRightGainLabel,    // kParamRightGain
+    &SimplePannerEditor::mRightDelayLabel,   // kParamRightDelay
+    &SimplePannerEditor::mMasterGainLabel,   // kParamMasterGain
+    nullptr,                                 // kParamLinkGain (button title)
+    nullptr,                                 // kParamPanLaw
+    nullptr,                                 // kParamMorph
+};
 
-    switch (tag)
-    {
-        case kParamLeftPan:
-            text = formatPanValue(normalized);
-            if (mLeftPanLabel)
-                mLeftPanLabel->setText(text.c_str());
-            break;
-
-        case kParamRightPan:
-            text = formatPanValue(normalized);
-            if (mRightPanLabel)
-                mRightPanLabel->setText(text.c_str());
-            break;
-
-        case kParamLeftGain:
-            text = formatGainValue(normalized);
-            if (mLeftGainLabel)
-                mLeftGainLabel->setText(text.c_str());
-            break;
-
-        case kParamRightGain:
-            text = formatGainValue(normalized);
-            if (mRightGainLabel)
-                mRightGainLabel->setText(text.c_str());
-            break;
-
-        case kParamLeftDelay:
-            text = formatDelayValue(normalized);
-            if (mLeftDelayLabel)
-                mLeftDelayLabel->setText(text.c_str());
-            break;
-
-        case kParamRightDelay:
-            text = formatDelayValue(normalized);
-            if (mRightDelayLabel)
-                mRightDelayLabel->setText(text.c_str());
-            break;
-
-        case kParamMasterGain:
-            text = formatGainValue(normalized);
-            if (mMasterGainLabel)
-                mMasterGainLabel->setText(text.c_str());
-            break;
-
-        default:
-            break;
-    }
-}
+//------------------------------------------------------------------------
+// Value formatter table (indexed by ParamFormat)
+//------------------------------------------------------------------------
+const SimplePannerEditor::ValueFormatter SimplePannerEditor::kValueFormatters[kParamFormatCount] = {
+    &SimplePannerEditor::formatPanValue,     // kFormatPan
+    &SimplePannerEditor::formatGainValue,    // kFormatGain
+    &SimplePannerEditor::formatDelayValue,   // kFormatDelay
+    nullptr,                                 // kFormatToggle
+    nullptr,                                 // kFormatList
+    nullptr,                                 // kFormatPercent
+};
 
 //------------------------------------------------------------------------
 // formatPanValue
 //------------------------------------------------------------------------
 std::string SimplePannerEditor::formatPanValue(float normalized)
 {
-    float pan = normalizedToPan(normalized);
+    // Same text as the host sees (PanParameter)
+    char text[kMaxValueTextLength];
+    int length = formatPanText(normalized, text, kMaxValueTextLength);
+    return std::string(text, length);
+}
 
-    if (std::abs(pan) < 0.5f)
-    {
-        return "C";  // Center
-    }
-    else if (pan < 0)
-    {
-        int value = static_cast<int>(std::abs(pan) + 0.5f);
-        return "L" + std::to_string(value);
-    }
-    else
+//------------------------------------------------------------------------
+// formatGainValue
+//------------------------------------------------------------------------
+std::string SimplePannerEditor::formatGainValue(float normalized)
+{
+    char text[kMaxValueTextLength];
+    int length = formatGainText(normalized, text, kMaxValueTextLength);
+    return std::string(text, length) + " dB";
+}
+
+//------------------------------------------------------------------------
+// formatDelayValue
+//------------------------------------------------------------------------
+std::string SimplePannerEditor::formatDelayValue(float normalized)
+{
+    char text[kMaxValueTextLength];
+    int length = formatDelayText(normalized, text, kMaxValueTextLength);
+    return std::string(text, length) + " ms";
+}
+
+//------------------------------------------------------------------------
+// formatTimingValue
+//------------------------------------------------------------------------
+std::string SimplePannerEditor::formatTimingValue(const ProcessTimingSummary& summary)
+{
+    if (summary.blocks == 0)
+        return "DSP  --";
+
+    // "DSP  avg 12.3 µs   p99 20.1 µs   max 35.0 µs   load 0.4 %   deadline 1.2 %   over 3 / 0 / 0"
+    char text[160];
+    ValueTextWriter<char> out(text, static_cast<int>(sizeof(text)));
+    out.append("DSP  avg ");
+    out.appendTenths(summary.meanMicros);
+    out.append(" \xC2\xB5s   p99 ");
+    out.appendTenths(summary.p99Micros);
+    out.append(" \xC2\xB5s   max ");
+    out.appendTenths(summary.maxMicros);
+    out.append(" \xC2\xB5s   load ");
+    out.appendTenths(summary.load * 100.0);
+    out.append(" %   deadline ");
+    out.appendTenths(summary.maxDeadlineUse * 100.0);
+    out.append(" %   over ");
+    for (int32 level = 0; level < kDeadlineLevels; ++level)
     {
-        int value = static_cast<int>(pan + 0.5f);
-        return "R" + std::to_string(value);
+        if (level > 0)
+            out.append(" / ");
+        out.appendInteger(static_cast<long>(summary.deadlineExceeded[level]));
     }
+    return std::string(text, out.length());
 }
 
 //------------------------------------------------------------------------
-// formatGainValue
+// LevelMeterView
 //------------------------------------------------------------------------
-std::string SimplePannerEditor::formatGainValue(float normalized)
+LevelMeterView::LevelMeterView(const CRect& size)
+: CView(size)
+, mPeak(0.0f)
+, mRms(0.0f)
+{
+    setMouseEnabled(false);
+}
+
+//------------------------------------------------------------------------
+void LevelMeterView::setLevels(float peak, float rms)
 {
-    float db = normalizedToDb(normalized);
+    if (peak == mPeak && rms == mRms)
+        return;
 
-    if (db <= -60.0f)
+    mPeak = peak;
+    mRms = rms;
+    invalid();
+}
+
+//------------------------------------------------------------------------
+void LevelMeterView::draw(CDrawContext* context)
+{
+    const CRect& bounds = getViewSize();
+    const CCoord width = bounds.getWidth();
+    const CCoord clipX = bounds.left + width * dbToNormalized(0.0f); // 0 dBFS
+
+    // Track
+    context->setFillColor(CColor(30, 30, 30, 255)); // Same as the slider tracks
+    context->drawRect(bounds, kDrawFilled);
+
+    // RMS bar, red past 0 dBFS
+    CRect rmsRect(bounds.left, bounds.top, bounds.left + width * mRms, bounds.bottom);
+    context->setFillColor(CColor(76, 175, 80, 255)); // #4CAF50 Green (as LINKED)
+    context->drawRect(rmsRect, kDrawFilled);
+    if (rmsRect.right > clipX)
     {
-        return "-∞ dB";
+        context->setFillColor(CColor(244, 67, 54, 255)); // #F44336 Red
+        context->drawRect(CRect(clipX, bounds.top, rmsRect.right, bounds.bottom), kDrawFilled);
     }
-    else
+
+    // Peak marker and 0 dBFS tick
+    context->setFrameColor(CColor(160, 160, 160, 255));
+    context->setLineWidth(1.0);
+    context->drawLine(CPoint(clipX, bounds.top), CPoint(clipX, bounds.bottom));
+    if (mPeak > 0.0f)
     {
-        std::ostringstream oss;
-        oss << std::fixed << std::setprecision(1);
-        if (db >= 0)
-            oss << "+";
-        oss << db << " dB";
-        return oss.str();
+        CCoord peakX = bounds.left + width * mPeak;
+        context->setFrameColor(mPeak > dbToNormalized(0.0f) ? CColor(244, 67, 54, 255) : CColor(255, 255, 255, 255));
+        context->setLineWidth(2.0);
+        context->drawLine(CPoint(peakX - 1.0, bounds.top), CPoint(peakX - 1.0, bounds.bottom));
     }
+
+    setDirty(false);
 }
 
 //------------------------------------------------------------------------
-// formatDelayValue
+// StereoScopeView
 //------------------------------------------------------------------------
-std::string SimplePannerEditor::formatDelayValue(float normalized)
+StereoScopeView::StereoScopeView(const CRect& size)
+: CView(size)
+, mFrame()
+{
+    setMouseEnabled(false);
+}
+
+//------------------------------------------------------------------------
+void StereoScopeView::setFrame(const ScopeFrame& frame)
 {
-    float ms = normalizedToDelayMs(normalized);
+    mFrame.correlation = frame.correlation;
+    mFrame.numPoints = std::min(std::max(frame.numPoints, 0), kScopePoints);
+    std::copy_n(frame.left, mFrame.numPoints, mFrame.left);
+    std::copy_n(frame.right, mFrame.numPoints, mFrame.right);
+    invalid();
+}
+
+//------------------------------------------------------------------------
+void StereoScopeView::draw(CDrawContext* context)
+{
+    const CRect& bounds = getViewSize();
+    const CCoord size = bounds.getWidth();
+    const CColor kAxisColor(90, 90, 90, 255);
+
+    // Goniometer: square at the top, L / M / R axes
+    CRect scope(bounds.left, bounds.top, bounds.left + size, bounds.top + size);
+    CPoint center = scope.getCenter();
+    context->setFillColor(CColor(30, 30, 30, 255)); // Same as the slider tracks
+    context->drawRect(scope, kDrawFilled);
+    context->setFrameColor(kAxisColor);
+    context->setLineWidth(1.0);
+    context->drawLine(CPoint(center.x, scope.top), CPoint(center.x, scope.bottom));   // M (mono)
+    context->drawLine(CPoint(scope.left, scope.top), CPoint(scope.right, scope.bottom)); // L (upper left)
+    context->drawLine(CPoint(scope.right, scope.top), CPoint(scope.left, scope.bottom)); // R (upper right)
+
+    // x = side, y = mid; a full-scale mono signal reaches the top edge
+    const CCoord half = size * 0.5;
+    context->setFillColor(CColor(76, 175, 80, 255)); // #4CAF50 Green (as LINKED)
+    for (int32 i = 0; i < mFrame.numPoints; ++i)
+    {
+        float side = std::min(std::max((mFrame.right[i] - mFrame.left[i]) * 0.5f, -1.0f), 1.0f);
+        float mid = std::min(std::max((mFrame.left[i] + mFrame.right[i]) * 0.5f, -1.0f), 1.0f);
+        CCoord x = center.x + side * half;
+        CCoord y = center.y - mid * half;
+        context->drawRect(CRect(x - 0.75, y - 0.75, x + 0.75, y + 0.75), kDrawFilled);
+    }
 
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(1) << ms << " ms";
-    return oss.str();
+    // Correlation: bar from the center (0) towards -1 (left) or +1 (right)
+    CRect bar(bounds.left, scope.bottom + 4.0, bounds.right, bounds.bottom);
+    CCoord barCenter = bar.left + bar.getWidth() * 0.5;
+    CCoord barEnd = barCenter + mFrame.correlation * bar.getWidth() * 0.5;
+    context->setFillColor(CColor(30, 30, 30, 255));
+    context->drawRect(bar, kDrawFilled);
+    context->setFillColor(mFrame.correlation < 0.0f ? CColor(244, 67, 54, 255)  // #F44336 Red: mono cancels
+                                                    : CColor(76, 175, 80, 255));
+    context->drawRect(CRect(std::min(barCenter, barEnd), bar.top, std::max(barCenter, barEnd), bar.bottom),
+                      kDrawFilled);
+    context->setFrameColor(kAxisColor);
+    context->drawLine(CPoint(barCenter, bar.top), CPoint(barCenter, bar.bottom));
+
+    setDirty(false);
 }
 
 } // namespace SimplePanner
@@ -1,7 +1,10 @@
 #include "public.sdk/source/main/pluginfactory.h"
+#include "public.sdk/source/main/moduleinit.h"
 #include "pluginprocessor.h"
 #include "plugincontroller.h"
 #include "plugids.h"
+#include "audio_logger.h"
+#include "trace_recorder.h"
 
 #define PLUGIN_NAME "SimplePanner"
 #define PLUGIN_VENDOR "Example Company"
@@ -37,3 +40,12 @@ END_FACTORY
 //------------------------------------------------------------------------
 // Note: InitModule() and DeinitModule() are now provided by moduleinit.cpp
 // which is required for VSTGUI module initialization
+
+//------------------------------------------------------------------------
+// Background writer threads are stopped when the host unloads the module
+// (ExitDll / ModuleExit / bundleExit), not in static destructors, which run
+// under the loader lock on Windows and would deadlock on the join
+static Steinberg::ModuleTerminator stopWriterThreads([] {
+    Steinberg::SimplePanner::TraceRecorder::shutdown();
+    Steinberg::SimplePanner::AudioLogger::shutdown();
+});
@@ -1,32 +1,88 @@
 #include "pluginprocessor.h"
 #include "plugids.h"
 #include "parameter_utils.h"
-#include "pan_calculator.h"
+#include "state_serializer.h"
+#include "record_message.h"
+#include "realtime_check.h"
+#include "trace_recorder.h"
+#include "audio_logger.h"
 
-#include "base/source/fstreamer.h"
 #include "pluginterfaces/vst/ivstparameterchanges.h"
+#include "pluginterfaces/vst/ivstmessage.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 
 namespace Steinberg {
 namespace SimplePanner {
 
+namespace {
+
+// Append one point to a parameter's output queue (hosts may pass no list)
+void reportParameterChange(Vst::IParameterChanges* changes, Vst::ParamID id,
+                           int32 sampleOffset, Vst::ParamValue value)
+{
+    if (!changes)
+        return;
+
+    int32 index = 0;
+    Vst::IParamValueQueue* queue = changes->addParameterData(id, index);
+    if (queue)
+        queue->addPoint(sampleOffset, value, index);
+}
+
+// Parameters glided by a ParameterSmoother
+constexpr ParamIdList kSmoothedParams = selectParams(
+    [](const ParamDescriptor& param) { return param.smoothed; });
+
+// Smoothed inputs of the live mix matrix (the morph only blends compiled matrices)
+constexpr ParamIdList kLiveSmoothedParams = selectParams(
+    [](const ParamDescriptor& param) { return param.smoothed && param.role != kRoleMorph; });
+
+} // namespace
+
 //------------------------------------------------------------------------
 // SimplePannerProcessor
 //------------------------------------------------------------------------
 SimplePannerProcessor::SimplePannerProcessor()
-    : mSampleRate(48000.0)
+    : mGainSmootherShared(false)
+    , mLeftGainChange{false, 0, 0.0}
+    , mRightGainChange{false, 0, 0.0}
+    , mLinkEngaged(false)
+    , mMixMatrix{1.0f, 0.0f, 0.0f, 1.0f}
+    , mMixMatrixDirty(true)
+    , mCompileMixMatrix(kMatrixCompilers[ParamDefault::kPanLaw])
+    , mMixMatrixA{1.0f, 0.0f, 0.0f, 1.0f}
+    , mMixMatrixB{1.0f, 0.0f, 0.0f, 1.0f}
+    , mDelaySamplesA{0.0, 0.0}
+    , mDelaySamplesB{0.0, 0.0}
+    , mAppliedGeneration(0)
+    , mRecallGeneration(0)
+    , mLastRecalled(PluginState::defaults())
+    , mTraceInstance(TraceRecorder::nextInstance())
+    , mTraceBlockCount(0)
+    , mCollectWorkloadStats(false)
+    , mReportedMeters{0.0f, 0.0f, 0.0f, 0.0f}
+    , mPresetTable(PresetTable::defaults())
+    , mProgramChanges()
+    , mNumProgramChanges(0)
+    , mNextProgramChange(0)
+    , mSampleRate(48000.0)
     , mIsActive(false)
 {
     setControllerClass(ControllerUID);
 
-    // Initialize parameter values to defaults (normalized 0.0 - 1.0)
-    mLeftPan = panToNormalized(ParamDefault::kLeftPan);
-    mLeftGain = dbToNormalized(ParamDefault::kLeftGain);
-    mLeftDelay = delayMsToNormalized(ParamDefault::kLeftDelay);
-    mRightPan = panToNormalized(ParamDefault::kRightPan);
-    mRightGain = dbToNormalized(ParamDefault::kRightGain);
-    mRightDelay = delayMsToNormalized(ParamDefault::kRightDelay);
-    mMasterGain = dbToNormalized(ParamDefault::kMasterGain);
-    mLinkGain = ParamDefault::kLinkGain;
+    // Initialize parameter values to defaults (normalized 0.0 - 1.0);
+    // snapshot B starts out equal to the defaults
+    PluginState defaults = PluginState::defaults();
+    std::copy_n(defaults.values, kParamCount, mParams);
+    std::copy_n(defaults.values + kStateSnapshotB, kParamCount, mSnapshotB);
+    mCaptureB = 0.0;
+
+    compileSnapshotB();
+    updateDelayTargets();
 }
 
 //------------------------------------------------------------------------
@@ -37,6 +93,11 @@ SimplePannerProcessor::~SimplePannerProcessor()
 //------------------------------------------------------------------------
 tresult PLUGIN_API SimplePannerProcessor::initialize(FUnknown* context)
 {
+    TraceScope trace("lifecycle", "Processor::initialize", mTraceInstance);
+
+    // Created here so process() never opens the log file
+    AudioLogger::get();
+
     tresult result = AudioEffect::initialize(context);
     if (result != kResultOk)
         return result;
@@ -45,45 +106,182 @@ tresult PLUGIN_API SimplePannerProcessor::initialize(FUnknown* context)
     addAudioInput(STR16("Stereo In"), Vst::SpeakerArr::kStereo);
     addAudioOutput(STR16("Stereo Out"), Vst::SpeakerArr::kStereo);
 
+    // Same bank as the controller's program list
+    loadPresetTable(std::getenv(PluginInfo::kPresetBankEnv));
+
+    // Deadline thresholds of this rig, if configured
+    double thresholds[kDeadlineLevels];
+    if (parseDeadlineThresholds(std::getenv(PluginInfo::kDeadlineThresholdsEnv), thresholds))
+        setDeadlineThresholds(thresholds);
+
+    setWorkloadStatsDirectory(std::getenv(PluginInfo::kStatsDirEnv));
+
+    const char* captureDir = std::getenv(PluginInfo::kCaptureDirEnv);
+    if (captureDir && *captureDir)
+    {
+        const char* captureAudio = std::getenv(PluginInfo::kCaptureAudioEnv);
+        std::string path = instanceFilePath(captureDir, "capture", ".spcap");
+        if (!startCapture(path.c_str(), captureAudio && std::strcmp(captureAudio, "1") == 0))
+            logWarning(mTraceInstance, "session capture file could not be created");
+    }
+
+    logInfo(mTraceInstance, "initialized with {} programs", mPresetTable->count());
     return kResultOk;
 }
 
+//------------------------------------------------------------------------
+bool SimplePannerProcessor::loadPresetTable(const char* path)
+{
+    // Copied once per module so process() never page-faults on the file
+    // mapping; other instances of the same bank reuse the copy
+    std::shared_ptr<const PresetTable> table = PresetTable::share(path);
+    bool loaded = (table != nullptr);
+    if (!loaded && path && *path)
+        logWarning(mTraceInstance, "preset bank could not be loaded; using the default program");
+
+    mPresetTable = loaded ? std::move(table) : PresetTable::defaults();
+    mPresetBankPath = loaded ? path : "";
+    capturePresetBank();
+    return loaded;
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API SimplePannerProcessor::terminate()
 {
+    stopCapture();
+
+    // Instances that never processed a block (plugin scans) leave no file
+    if (mCollectWorkloadStats && mWorkloadStats.numBlocks() > 0)
+        mWorkloadStats.write(getWorkloadStatsPath().c_str());
+    mWorkloadStats.clear();
+
     return AudioEffect::terminate();
 }
 
+//------------------------------------------------------------------------
+void SimplePannerProcessor::setWorkloadStatsDirectory(const char* directory)
+{
+    mWorkloadStatsDir = directory ? directory : "";
+    mCollectWorkloadStats = !mWorkloadStatsDir.empty();
+    mWorkloadStats.clear();
+    mWorkloadStats.setSampleRate(mSampleRate);
+}
+
+//------------------------------------------------------------------------
+std::string SimplePannerProcessor::getWorkloadStatsPath() const
+{
+    if (!mCollectWorkloadStats)
+        return std::string();
+    return instanceFilePath(mWorkloadStatsDir, "workload", ".json");
+}
+
+//------------------------------------------------------------------------
+std::string SimplePannerProcessor::instanceFilePath(const std::string& directory, const char* prefix,
+                                                    const char* extension) const
+{
+    std::string path = directory;
+    if (!path.empty() && path.back() != '/' && path.back() != '\\')
+        path += '/';
+    path += std::string(prefix) + "-" + std::to_string(currentProcessId()) + "-" + std::to_string(mTraceInstance)
+          + extension;
+    return path;
+}
+
+//------------------------------------------------------------------------
+bool SimplePannerProcessor::startCapture(const char* path, bool withAudio)
+{
+    stopCapture();
+
+    std::unique_ptr<SessionCapture> capture(new SessionCapture(path, withAudio));
+    if (!capture->isOpen())
+        return false;
+
+    // The replay starts from this instance's current setup and state
+    capture->recordSetup(processSetup);
+    capture->recordState(currentState());
+    mCapture = std::move(capture);
+    capturePresetBank();
+    logInfo(mTraceInstance, "session capture started");
+    return true;
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::capturePresetBank()
+{
+    // Program changes in the capture select from this table; the replay
+    // tool checks that it replays with the same bank
+    if (mCapture)
+        mCapture->recordPresetBank(mPresetBankPath.c_str(), mPresetTable->count(), mPresetTable->numFields(),
+                                   mPresetTable->checksum());
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::stopCapture()
+{
+    if (!mCapture)
+        return;
+
+    if (mCapture->numDropped() > 0)
+        logWarning(mTraceInstance, "session capture lost {} records; its replay is not exact",
+                   mCapture->numDropped());
+    mCapture.reset();
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API SimplePannerProcessor::setActive(TBool state)
 {
+    TraceScope trace("lifecycle", state ? "Processor::setActive(true)" : "Processor::setActive(false)",
+                     mTraceInstance);
+
     if (state)
     {
-        // Activate: allocate delay line buffers
+        // A state recalled while inactive takes effect before the smoothers
+        // are reset (the audio thread is not running during setActive)
+        applyPendingState();
+
+        // Activate: allocate delay line and scratch buffers
         // Calculate max delay samples: 100ms at current sample rate
+        // One block of headroom keeps block-based delay reads contiguous at max delay
         size_t maxDelaySamples = static_cast<size_t>(0.1 * mSampleRate);  // 100ms
-        mDelayLeft.resize(maxDelaySamples + 1);
-        mDelayRight.resize(maxDelaySamples + 1);
+        size_t maxBlockSize = static_cast<size_t>(std::max<int32>(processSetup.maxSamplesPerBlock, 1));
+        mDelayLeft.resize(maxDelaySamples + maxBlockSize + 1);
+        mDelayRight.resize(maxDelaySamples + maxBlockSize + 1);
+        mScratchLeft.assign(maxBlockSize, 0.0f);
+        mScratchRight.assign(maxBlockSize, 0.0f);
 
         // Reset delay lines to zero
         mDelayLeft.reset();
         mDelayRight.reset();
 
-        // Initialize parameter smoothers with current sample rate
-        mLeftPanSmoother.setSampleRate(mSampleRate);
-        mLeftGainSmoother.setSampleRate(mSampleRate);
-        mRightPanSmoother.setSampleRate(mSampleRate);
-        mRightGainSmoother.setSampleRate(mSampleRate);
-        mMasterGainSmoother.setSampleRate(mSampleRate);
+        // Initialize parameter smoothers with current sample rate and
+        // reset them to the current parameter values
+        for (Vst::ParamID id : kSmoothedParams)
+        {
+            mSmoothers[id].setSampleRate(mSampleRate);
+            mSmoothers[id].reset(static_cast<float>(mParams[id]));
+        }
+        mGainSmootherShared = isGainLinked();
 
-        // Reset smoothers to current parameter values
-        mLeftPanSmoother.reset(static_cast<float>(mLeftPan));
-        mLeftGainSmoother.reset(static_cast<float>(mLeftGain));
-        mRightPanSmoother.reset(static_cast<float>(mRightPan));
-        mRightGainSmoother.reset(static_cast<float>(mRightGain));
-        mMasterGainSmoother.reset(static_cast<float>(mMasterGain));
+        // Compile the initial mix matrix
+        mMixMatrixA = mCompileMixMatrix(static_cast<float>(mParams[kParamLeftGain]),
+                                        static_cast<float>(mParams[kParamRightGain]),
+                                        static_cast<float>(mParams[kParamLeftPan]),
+                                        static_cast<float>(mParams[kParamRightPan]),
+                                        static_cast<float>(mParams[kParamMasterGain]));
+        mMixMatrix = morphMixMatrix(mMixMatrixA, mMixMatrixB, mSmoothers[kParamMorph].getCurrentValue());
+        mMixMatrixDirty = false;
 
         mIsActive = true;
+        applyDelays();
+
+        // A new period starts with the new setup
+        mProcessTiming.clear();
+        mDeadlineWatchdog.reset();
+        mOutputMeters[0].reset();
+        mOutputMeters[1].reset();
+        mStereoAnalyzer.reset();
+
+        logInfo(mTraceInstance, "activated at {} Hz, up to {} samples per block", mSampleRate, maxBlockSize);
     }
     else
     {
@@ -91,78 +289,241 @@ tresult PLUGIN_API SimplePannerProcessor::setActive(TBool state)
         mIsActive = false;
     }
 
+    if (mCapture)
+        mCapture->recordActive(state != 0);
+
     return AudioEffect::setActive(state);
 }
 
 //------------------------------------------------------------------------
 tresult PLUGIN_API SimplePannerProcessor::process(Vst::ProcessData& data)
 {
+    // No allocation, locks or blocking calls from here on (checked in
+    // SIMPLEPANNER_REALTIME_CHECK builds)
+    RealtimeCheck::RealtimeScope realtimeScope;
+    TraceScope trace("audio", "Processor::process", mTraceInstance,
+                     mTraceBlockCount++ % kTraceBlockInterval == 0);
+
+    std::chrono::steady_clock::time_point blockStart = std::chrono::steady_clock::now();
+
+    if (mCollectWorkloadStats)
+        mWorkloadStats.add(data);
+
+    // Apply a state recalled since the last block; parameter changes in
+    // this block are applied on top of it
+    applyPendingState();
+
+    // Captured as received, before the outputs (maybe the same buffers) are written
+    if (mCapture)
+        mCapture->recordBlock(data);
+
     // Process parameter changes
+    mLeftGainChange.changed = false;
+    mRightGainChange.changed = false;
+    mLinkEngaged = false;
     if (data.inputParameterChanges)
     {
         int32 numParamsChanged = data.inputParameterChanges->getParameterCount();
         for (int32 i = 0; i < numParamsChanged; i++)
         {
             Vst::IParamValueQueue* paramQueue = data.inputParameterChanges->getParameterData(i);
-            if (paramQueue)
+            if (paramQueue && paramQueue->getParameterId() == kParamProgram)
+            {
+                // Every program change is kept and applied at its sample offset
+                queueProgramChanges(paramQueue);
+            }
+            else if (paramQueue)
             {
                 Vst::ParamValue value;
                 int32 sampleOffset;
                 int32 numPoints = paramQueue->getPointCount();
 
-                // Get last point and update smoothers
+                // Get last point and dispatch it by the parameter's role
                 if (numPoints > 0 && paramQueue->getPoint(numPoints - 1, sampleOffset, value) == kResultTrue)
                 {
-                    switch (paramQueue->getParameterId())
+                    Vst::ParamID id = paramQueue->getParameterId();
+                    if (id < kParamCount)
                     {
-                        case kParamLeftPan:
-                            mLeftPan = value;
-                            mLeftPanSmoother.setTarget(static_cast<float>(value));
-                            break;
-                        case kParamLeftGain:
-                            mLeftGain = value;
-                            mLeftGainSmoother.setTarget(static_cast<float>(value));
-                            break;
-                        case kParamLeftDelay:
-                            mLeftDelay = value;
-                            if (mIsActive)
-                            {
-                                size_t delaySamples = delayMsToSamples(normalizedToDelayMs(value), mSampleRate);
-                                mDelayLeft.setDelay(delaySamples);
-                            }
-                            break;
-                        case kParamRightPan:
-                            mRightPan = value;
-                            mRightPanSmoother.setTarget(static_cast<float>(value));
-                            break;
-                        case kParamRightGain:
-                            mRightGain = value;
-                            mRightGainSmoother.setTarget(static_cast<float>(value));
-                            break;
-                        case kParamRightDelay:
-                            mRightDelay = value;
-                            if (mIsActive)
-                            {
-                                size_t delaySamples = delayMsToSamples(normalizedToDelayMs(value), mSampleRate);
-                                mDelayRight.setDelay(delaySamples);
-                            }
-                            break;
-                        case kParamMasterGain:
-                            mMasterGain = value;
-                            mMasterGainSmoother.setTarget(static_cast<float>(value));
-                            break;
-                        case kParamLinkGain:
-                            mLinkGain = value;
-                            break;
+                        (this->*kParamHandlers[kParamTable[id].role])(id, sampleOffset, value);
+                    }
+                    else if (id == kParamCaptureB)
+                    {
+                        // Momentary: report the switch back to Off, so the
+                        // next press captures again
+                        if (value >= 0.5 && mCaptureB < 0.5)
+                        {
+                            captureSnapshotB();
+                            reportParameterChange(data.outputParameterChanges, kParamCaptureB, sampleOffset, 0.0);
+                            value = 0.0;
+                        }
+                        mCaptureB = value;
                     }
                 }
             }
         }
     }
 
+    // Gains are resolved after Link L/R Gain, whatever the queue order
+    applyGainChanges(data.outputParameterChanges);
+
+    processAudio(data);
+    analyzeOutput(data);
+
+    // Program changes past the processed samples (or in blocks without
+    // audio) still take effect in this block
+    applyProgramChanges(std::numeric_limits<int32>::max());
+    mNumProgramChanges = 0;
+    mNextProgramChange = 0;
+
+    // Publish this block's parameter values for getState and diagnostics
+    mParameterSnapshot.publish(currentState(), mAppliedGeneration);
+
+    recordProcessTiming(blockStart, data.numSamples);
+
+    return kResultOk;
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::recordProcessTiming(std::chrono::steady_clock::time_point blockStart,
+                                                int32 numSamples)
+{
+    std::chrono::nanoseconds elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - blockStart);
+    uint64 nanos = static_cast<uint64>(elapsed.count());
+    mProcessTiming.add(nanos, numSamples);
+    double deadlineUse = mDeadlineWatchdog.add(nanos, numSamples, mSampleRate);
+    if (deadlineUse > 1.0)
+        logWarning(mTraceInstance, "block of {} samples missed its deadline: {} us ({} %)",
+                   numSamples, nanos / 1000, static_cast<int64>(deadlineUse * 100.0));
+
+    // One summary per period of audio; dropped if nobody polls (editor
+    // closed) and the queue is full (deadline counts are totals, so the
+    // next summary still has them)
+    if (mProcessTiming.numSamples() >= static_cast<int64>(mSampleRate * kTimingPeriodMs / 1000.0))
+    {
+        ProcessTimingSummary summary = mProcessTiming.summarize(mSampleRate);
+        mDeadlineWatchdog.summarize(summary);
+        mTimingQueue.push(summary);
+        mProcessTiming.clear();
+    }
+}
+
+//------------------------------------------------------------------------
+DeadlineCounters SimplePannerProcessor::getDeadlineCounters() const
+{
+    return mDeadlineWatchdog.counters();
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::setDeadlineThresholds(const double thresholds[kDeadlineLevels])
+{
+    mDeadlineWatchdog.setThresholds(thresholds);
+}
+
+//------------------------------------------------------------------------
+tresult PLUGIN_API SimplePannerProcessor::notify(Vst::IMessage* message)
+{
+    // Polled by the controller from the UI thread: messages are never
+    // allocated or sent from process()
+    if (message && message->getMessageID() && std::strcmp(message->getMessageID(), TelemetryPoll::kId) == 0)
+    {
+        sendTelemetry();
+        return kResultOk;
+    }
+
+    return AudioEffect::notify(message);
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::sendTelemetry()
+{
+    sendRecords(TimingMessage::kId, mTimingQueue);
+    sendRecords(ScopeMessage::kId, mScopeQueue);
+}
+
+//------------------------------------------------------------------------
+template <typename T, size_t kCapacity>
+void SimplePannerProcessor::sendRecords(FIDString messageId, SpscRingBuffer<T, kCapacity>& queue)
+{
+    // Everything queued since the last poll goes out as one batch
+    T records[kCapacity];
+    size_t count = queue.pop(records, kCapacity);
+    if (count == 0)
+        return;
+
+    // Hosts without message support return no message; the batch is dropped
+    IPtr<Vst::IMessage> message = owned(allocateMessage());
+    if (!message)
+        return;
+
+    message->setMessageID(messageId);
+    writeRecords(message->getAttributes(), records, count);
+    sendMessage(message);
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::onSmoothedChange(Vst::ParamID id, int32 /*sampleOffset*/, Vst::ParamValue value)
+{
+    mParams[id] = value;
+    mSmoothers[id].setTarget(static_cast<float>(value));
+    mMixMatrixDirty = true;
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::onGainChange(Vst::ParamID id, int32 sampleOffset, Vst::ParamValue value)
+{
+    // Resolved by applyGainChanges once Link L/R Gain is known
+    GainChange& change = (id == kParamLeftGain) ? mLeftGainChange : mRightGainChange;
+    change = {true, sampleOffset, value};
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::onDelayChange(Vst::ParamID id, int32 /*sampleOffset*/, Vst::ParamValue value)
+{
+    mParams[id] = value;
+    updateDelayTargets();
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::onLinkChange(Vst::ParamID id, int32 /*sampleOffset*/, Vst::ParamValue value)
+{
+    mLinkEngaged = (value >= 0.5 && !isGainLinked());
+    mParams[id] = value;
+    if (!isGainLinked())
+        unshareGainSmoother();
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::onPanLawChange(Vst::ParamID id, int32 /*sampleOffset*/, Vst::ParamValue value)
+{
+    mParams[id] = value;
+    mCompileMixMatrix = kMatrixCompilers[normalizedToPanLaw(value)];
+    mMixMatrixDirty = true;
+}
+
+//------------------------------------------------------------------------
+// Parameter change handler table
+// kParamTable gives each parameter its role, so process() dispatches every
+// change with one indexed call instead of a switch over parameter IDs
+//------------------------------------------------------------------------
+const SimplePannerProcessor::ParamHandler SimplePannerProcessor::kParamHandlers[kParamRoleCount] = {
+    &SimplePannerProcessor::onSmoothedChange,   // kRoleMix
+    &SimplePannerProcessor::onGainChange,       // kRoleGain
+    &SimplePannerProcessor::onDelayChange,      // kRoleDelay
+    &SimplePannerProcessor::onLinkChange,       // kRoleLink
+    &SimplePannerProcessor::onPanLawChange,     // kRolePanLaw
+    &SimplePannerProcessor::onSmoothedChange,   // kRoleMorph
+};
+static_assert(kRoleMix == 0 && kRoleGain == 1 && kRoleDelay == 2 && kRoleLink == 3
+              && kRolePanLaw == 4 && kRoleMorph == 5 && kParamRoleCount == 6,
+              "kParamHandlers must be indexed by ParamRole");
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::processAudio(Vst::ProcessData& data)
+{
     // Check for valid I/O
     if (data.numInputs == 0 || data.numOutputs == 0)
-        return kResultOk;
+        return;
 
     Vst::AudioBusBuffers& inputBus = data.inputs[0];
     Vst::AudioBusBuffers& outputBus = data.outputs[0];
@@ -175,84 +536,429 @@ tresult PLUGIN_API SimplePannerProcessor::process(Vst::ProcessData& data)
         float* outL = outputBus.channelBuffers32[0];
         float* outR = outputBus.channelBuffers32[1];
 
-        // Process each sample
-        for (int32 i = 0; i < data.numSamples; i++)
+        // Delay buffers are not allocated until setActive(true)
+        if (!mIsActive || mScratchLeft.empty())
+        {
+            logDebug(mTraceInstance, "process() while inactive: {} samples of silence", data.numSamples);
+            std::fill(outL, outL + data.numSamples, 0.0f);
+            std::fill(outR, outR + data.numSamples, 0.0f);
+            return;
+        }
+
+        // Split hosts' blocks into scratch-sized segments; while smoothing,
+        // segments are limited to kRampLength so the matrix ramps track the
+        // smoothers. Segments also end at program changes, which take
+        // effect exactly at their sample offset.
+        int32 offset = 0;
+        while (offset < data.numSamples)
         {
-            // Get smoothed parameter values (per-sample)
-            float leftPanNorm = mLeftPanSmoother.getNext();
-            float leftGainNorm = mLeftGainSmoother.getNext();
-            float rightPanNorm = mRightPanSmoother.getNext();
-            float rightGainNorm = mRightGainSmoother.getNext();
-            float masterGainNorm = mMasterGainSmoother.getNext();
-
-            // Convert normalized parameters to usable values
-            float leftPanValue = normalizedToPan(leftPanNorm);
-            float leftGainDb = normalizedToDb(leftGainNorm);
-            float leftGainLinear = dbToLinear(leftGainDb);
-
-            float rightPanValue = normalizedToPan(rightPanNorm);
-            float rightGainDb = normalizedToDb(rightGainNorm);
-            float rightGainLinear = dbToLinear(rightGainDb);
-
-            float masterGainDb = normalizedToDb(masterGainNorm);
-            float masterGainLinear = dbToLinear(masterGainDb);
-
-            // Calculate pan gains
-            PanGains leftPanGains = calculatePanGains(leftPanValue);
-            PanGains rightPanGains = calculatePanGains(rightPanValue);
-
-            // Read input samples
-            float inLeftSample = inL[i];
-            float inRightSample = inR[i];
-
-            // Apply delay
-            float delayedLeft = mDelayLeft.process(inLeftSample);
-            float delayedRight = mDelayRight.process(inRightSample);
-
-            // Apply gain
-            float gainedLeft = delayedLeft * leftGainLinear;
-            float gainedRight = delayedRight * rightGainLinear;
-
-            // Apply panning and mix
-            float mixedLeft = gainedLeft * leftPanGains.left + gainedRight * rightPanGains.left;
-            float mixedRight = gainedLeft * leftPanGains.right + gainedRight * rightPanGains.right;
-
-            // Apply master gain
-            outL[i] = mixedLeft * masterGainLinear;
-            outR[i] = mixedRight * masterGainLinear;
+            applyProgramChanges(offset);
+            int32 segmentEnd = data.numSamples;
+            if (mNextProgramChange < mNumProgramChanges)
+                segmentEnd = std::min(segmentEnd, mProgramChanges[mNextProgramChange].sampleOffset);
+
+            bool smoothing = isSmoothing();
+            int32 maxSegment = static_cast<int32>(mScratchLeft.size());
+            if (smoothing)
+                maxSegment = std::min(maxSegment, kRampLength);
+            int32 numSamples = std::min(maxSegment, segmentEnd - offset);
+
+            MixMatrix target = updateMixMatrix(smoothing, numSamples);
+
+            // Select the kernel once per segment
+            ProcessKernel kernel = selectKernel(target);
+            (this->*kernel)(inL + offset, inR + offset, outL + offset, outR + offset, numSamples, target);
+
+            mMixMatrix = target;
+            offset += numSamples;
         }
     }
+}
 
-    return kResultOk;
+//------------------------------------------------------------------------
+void SimplePannerProcessor::analyzeOutput(Vst::ProcessData& data)
+{
+    if (data.numOutputs == 0 || data.outputs[0].numChannels < 2 || data.numSamples <= 0)
+        return;
+
+    const float* outL = data.outputs[0].channelBuffers32[0];
+    const float* outR = data.outputs[0].channelBuffers32[1];
+    mOutputMeters[0].add(outL, data.numSamples);
+    mOutputMeters[1].add(outR, data.numSamples);
+
+    // Frames not polled yet keep their place; new ones are dropped
+    mStereoAnalyzer.add(outL, outR, data.numSamples,
+                        [this](const ScopeFrame& frame) { mScopeQueue.push(frame); });
+
+    // One meter report per period of audio, at the block's last sample
+    if (mOutputMeters[0].numSamples() >= static_cast<int64>(mSampleRate / kMeterRateHz))
+        reportOutputMeters(data.outputParameterChanges, data.numSamples - 1);
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::reportOutputMeters(Vst::IParameterChanges* outputChanges, int32 sampleOffset)
+{
+    const float levels[kMeterCount] = {
+        levelToNormalized(mOutputMeters[0].peak()),  // kParamPeakLeft
+        levelToNormalized(mOutputMeters[1].peak()),  // kParamPeakRight
+        levelToNormalized(mOutputMeters[0].rms()),   // kParamRmsLeft
+        levelToNormalized(mOutputMeters[1].rms()),   // kParamRmsRight
+    };
+    mOutputMeters[0].reset();
+    mOutputMeters[1].reset();
+
+    // Unchanged values (e.g. silence) are not sent again; without an output
+    // list nothing counts as reported
+    if (!outputChanges)
+        return;
+
+    for (int32 i = 0; i < kMeterCount; ++i)
+    {
+        if (levels[i] == mReportedMeters[i])
+            continue;
+
+        reportParameterChange(outputChanges, kParamPeakLeft + i, sampleOffset, levels[i]);
+        mReportedMeters[i] = levels[i];
+    }
 }
 
+static_assert(kParamPeakRight == kParamPeakLeft + 1 && kParamRmsLeft == kParamPeakLeft + 2
+              && kParamRmsRight == kParamPeakLeft + 3 && kMeterCount == 4,
+              "Meter IDs must be consecutive in reportOutputMeters order");
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::queueProgramChanges(Vst::IParamValueQueue* queue)
+{
+    int32 numPoints = queue->getPointCount();
+    for (int32 i = 0; i < numPoints; i++)
+    {
+        Vst::ParamValue value;
+        int32 sampleOffset;
+        if (queue->getPoint(i, sampleOffset, value) != kResultTrue)
+            continue;
+
+        // Points are in sample order; when full, the latest change replaces the last entry
+        ProgramChange change = {std::max(sampleOffset, 0),
+                                normalizedToProgram(value, static_cast<int>(mPresetTable->count()))};
+        if (mNumProgramChanges < kMaxProgramChanges)
+            mProgramChanges[mNumProgramChanges++] = change;
+        else
+        {
+            mProgramChanges[kMaxProgramChanges - 1] = change;
+            logWarning(mTraceInstance, "more than {} program changes in one block; offset {} replaces the last",
+                       kMaxProgramChanges, change.sampleOffset);
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::applyProgramChanges(int32 sampleOffset)
+{
+    while (mNextProgramChange < mNumProgramChanges
+           && mProgramChanges[mNextProgramChange].sampleOffset <= sampleOffset)
+    {
+        applyProgram(mProgramChanges[mNextProgramChange].program);
+        ++mNextProgramChange;
+    }
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::applyProgram(int32 program)
+{
+    const PresetTable& table = *mPresetTable;
+    if (program < 0 || program >= table.count())
+        return;
+
+    // One table lookup; fields the bank does not store keep their current values
+    PluginState state = currentState();
+    std::copy_n(table.program(program).values, table.numFields(), state.values);
+    applyState(state);
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::applyGainChanges(Vst::IParameterChanges* outputChanges)
+{
+    const GainChange& left = mLeftGainChange;
+    const GainChange& right = mRightGainChange;
+
+    if (!isGainLinked())
+    {
+        if (left.changed)
+            onSmoothedChange(kParamLeftGain, left.sampleOffset, left.value);
+        if (right.changed)
+            onSmoothedChange(kParamRightGain, right.sampleOffset, right.value);
+        return;
+    }
+
+    // Linked: both gains take one value. Left Gain wins when both changed,
+    // and a newly engaged link makes Right Gain follow Left Gain.
+    const GainChange* source = left.changed ? &left : (right.changed ? &right : nullptr);
+    if (!source && !mLinkEngaged)
+        return;
+
+    double value = source ? source->value : mParams[kParamLeftGain];
+    int32 sampleOffset = source ? source->sampleOffset : 0;
+
+    // The host only hears about the gain it did not write itself
+    bool reportLeft = (left.changed ? left.value : mParams[kParamLeftGain]) != value;
+    bool reportRight = (right.changed ? right.value : mParams[kParamRightGain]) != value;
+
+    mParams[kParamLeftGain] = value;
+    mParams[kParamRightGain] = value;
+    mSmoothers[kParamLeftGain].setTarget(static_cast<float>(value));
+    if (!mGainSmootherShared)
+        mSmoothers[kParamRightGain].setTarget(static_cast<float>(value));
+    mMixMatrixDirty = true;
+
+    if (reportLeft)
+        reportParameterChange(outputChanges, kParamLeftGain, sampleOffset, value);
+    if (reportRight)
+        reportParameterChange(outputChanges, kParamRightGain, sampleOffset, value);
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::unshareGainSmoother()
+{
+    if (!mGainSmootherShared)
+        return;
+
+    // Right Gain continues from where the shared smoother is
+    mSmoothers[kParamRightGain].reset(mSmoothers[kParamLeftGain].getCurrentValue());
+    mSmoothers[kParamRightGain].setTarget(mSmoothers[kParamLeftGain].getTargetValue());
+    mGainSmootherShared = false;
+}
+
+//------------------------------------------------------------------------
+bool SimplePannerProcessor::isSmoothing() const
+{
+    return isSmoothingLive() || mSmoothers[kParamMorph].isSmoothing();
+}
+
+//------------------------------------------------------------------------
+bool SimplePannerProcessor::isSmoothingLive() const
+{
+    for (Vst::ParamID id : kLiveSmoothedParams)
+    {
+        if (mSmoothers[id].isSmoothing() && !(id == kParamRightGain && mGainSmootherShared))
+            return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------
+MixMatrix SimplePannerProcessor::updateMixMatrix(bool smoothing, int32 numSamples)
+{
+    bool compileLive = false;
+    if (smoothing)
+    {
+        // Advance the smoothers to the end of the segment; a morph alone
+        // only blends the already compiled matrices
+        if (isSmoothingLive())
+        {
+            for (Vst::ParamID id : kLiveSmoothedParams)
+            {
+                if (!(id == kParamRightGain && mGainSmootherShared))
+                    mSmoothers[id].advance(numSamples);
+            }
+            compileLive = true;
+        }
+        if (mSmoothers[kParamMorph].isSmoothing())
+        {
+            mSmoothers[kParamMorph].advance(numSamples);
+            applyDelays();
+        }
+    }
+    else if (mMixMatrixDirty)
+    {
+        // Converged smoothers are snapped to their exact targets; the
+        // remaining difference is ramped out over this segment
+        for (Vst::ParamID id : kSmoothedParams)
+            mSmoothers[id].reset(mSmoothers[id].getTargetValue());
+        applyDelays();
+        compileLive = true;
+    }
+    else
+    {
+        return mMixMatrix;
+    }
+
+    // Linked gains merge into one smoother once both have met; until then
+    // Right Gain glides on its own smoother towards the shared target
+    if (isGainLinked() && !mGainSmootherShared
+        && mSmoothers[kParamRightGain].getCurrentValue() == mSmoothers[kParamLeftGain].getCurrentValue()
+        && mSmoothers[kParamRightGain].getTargetValue() == mSmoothers[kParamLeftGain].getTargetValue())
+    {
+        mGainSmootherShared = true;
+    }
+
+    mMixMatrixDirty = smoothing;
+    if (compileLive)
+    {
+        float leftGain = mSmoothers[kParamLeftGain].getCurrentValue();
+        float rightGain = mGainSmootherShared ? leftGain : mSmoothers[kParamRightGain].getCurrentValue();
+        mMixMatrixA = mCompileMixMatrix(leftGain,
+                                        rightGain,
+                                        mSmoothers[kParamLeftPan].getCurrentValue(),
+                                        mSmoothers[kParamRightPan].getCurrentValue(),
+                                        mSmoothers[kParamMasterGain].getCurrentValue());
+    }
+    return morphMixMatrix(mMixMatrixA, mMixMatrixB, mSmoothers[kParamMorph].getCurrentValue());
+}
+
+//------------------------------------------------------------------------
+SimplePannerProcessor::ProcessKernel SimplePannerProcessor::selectKernel(const MixMatrix& target) const
+{
+    // Delay 0 still has the 1-sample minimum latency of DelayLine, which the
+    // delay-inactive kernels reproduce without reading the delay buffer
+    bool delayActive = mDelayLeft.getDelay() > 1 || mDelayRight.getDelay() > 1;
+    bool ramp = target != mMixMatrix;
+    bool diagonal = target.isDiagonal() && mMixMatrix.isDiagonal();
+
+    int index = (delayActive ? 4 : 0)
+              | (ramp ? 2 : 0)
+              | (diagonal ? 1 : 0);
+    return kProcessKernels[index];
+}
+
+//------------------------------------------------------------------------
+template <bool kDelayActive, bool kRamp, bool kDiagonal>
+void SimplePannerProcessor::processKernel(const float* inL, const float* inR,
+                                          float* outL, float* outR, int32 numSamples,
+                                          const MixMatrix& target)
+{
+    size_t blockSize = static_cast<size_t>(numSamples);
+
+    // Apply delay
+    // Outputs may alias inputs, so the input is consumed before any output is written
+    const float* delayedL = mScratchLeft.data();
+    const float* delayedR = mScratchRight.data();
+    float previousL = 0.0f;
+    float previousR = 0.0f;
+    if constexpr (kDelayActive)
+    {
+        mDelayLeft.processBlock(inL, mScratchLeft.data(), blockSize);
+        mDelayRight.processBlock(inR, mScratchRight.data(), blockSize);
+    }
+    else
+    {
+        previousL = mDelayLeft.getLastInput();
+        previousR = mDelayRight.getLastInput();
+        mDelayLeft.write(inL, blockSize);
+        mDelayRight.write(inR, blockSize);
+    }
+
+    // Gain, pan and master gain as one matrix (ramped towards target if changing)
+    MixMatrix matrix = target;
+    MixMatrix step = {};
+    if constexpr (kRamp)
+    {
+        MixMatrixRamp ramp = MixMatrixRamp::between(mMixMatrix, target, numSamples);
+        matrix = ramp.start;
+        step = ramp.step;
+    }
+
+    for (int32 i = 0; i < numSamples; i++)
+    {
+        // Read delayed input samples
+        float delayedLeft;
+        float delayedRight;
+        if constexpr (kDelayActive)
+        {
+            delayedLeft = delayedL[i];
+            delayedRight = delayedR[i];
+        }
+        else
+        {
+            delayedLeft = previousL;
+            delayedRight = previousR;
+            previousL = inL[i];
+            previousR = inR[i];
+        }
+
+        if constexpr (kRamp)
+        {
+            matrix.leftToLeft += step.leftToLeft;
+            matrix.rightToRight += step.rightToRight;
+            if constexpr (!kDiagonal)
+            {
+                matrix.rightToLeft += step.rightToLeft;
+                matrix.leftToRight += step.leftToRight;
+            }
+        }
+
+        // Apply the mix matrix
+        if constexpr (kDiagonal)
+        {
+            outL[i] = delayedLeft * matrix.leftToLeft;
+            outR[i] = delayedRight * matrix.rightToRight;
+        }
+        else
+        {
+            outL[i] = delayedLeft * matrix.leftToLeft + delayedRight * matrix.rightToLeft;
+            outR[i] = delayedLeft * matrix.leftToRight + delayedRight * matrix.rightToRight;
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+// Kernel dispatch table
+// Index bits: 4 = delay active, 2 = matrix ramp, 1 = diagonal matrix (no crossfeed)
+//------------------------------------------------------------------------
+const SimplePannerProcessor::ProcessKernel SimplePannerProcessor::kProcessKernels[8] = {
+    &SimplePannerProcessor::processKernel<false, false, false>,
+    &SimplePannerProcessor::processKernel<false, false, true>,
+    &SimplePannerProcessor::processKernel<false, true, false>,
+    &SimplePannerProcessor::processKernel<false, true, true>,
+    &SimplePannerProcessor::processKernel<true, false, false>,
+    &SimplePannerProcessor::processKernel<true, false, true>,
+    &SimplePannerProcessor::processKernel<true, true, false>,
+    &SimplePannerProcessor::processKernel<true, true, true>,
+};
+
+//------------------------------------------------------------------------
+// Matrix compiler table
+// The per-sample kernels only see the compiled matrix, so the pan law costs
+// nothing per sample; a law change just ramps to the newly compiled matrix
+//------------------------------------------------------------------------
+const SimplePannerProcessor::MatrixCompiler SimplePannerProcessor::kMatrixCompilers[kPanLawCount] = {
+    &compileMixMatrix<PanLawLinear>,
+    &compileMixMatrix<PanLawCompromise>,
+    &compileMixMatrix<PanLawConstantPower>,
+    &compileMixMatrix<PanLawBalance>,
+};
+static_assert(PanLawLinear::kType == 0 && PanLawCompromise::kType == 1
+              && PanLawConstantPower::kType == 2 && PanLawBalance::kType == 3,
+              "kMatrixCompilers must be indexed by PanLawType");
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API SimplePannerProcessor::setupProcessing(Vst::ProcessSetup& newSetup)
 {
+    TraceScope trace("lifecycle", "Processor::setupProcessing", mTraceInstance);
+
     // Save sample rate
     mSampleRate = newSetup.sampleRate;
 
     // Update parameter smoothers if active
     if (mIsActive)
     {
-        mLeftPanSmoother.setSampleRate(mSampleRate);
-        mLeftGainSmoother.setSampleRate(mSampleRate);
-        mRightPanSmoother.setSampleRate(mSampleRate);
-        mRightGainSmoother.setSampleRate(mSampleRate);
-        mMasterGainSmoother.setSampleRate(mSampleRate);
+        for (Vst::ParamID id : kSmoothedParams)
+            mSmoothers[id].setSampleRate(mSampleRate);
 
         // Resize delay lines for new sample rate
         size_t maxDelaySamples = static_cast<size_t>(0.1 * mSampleRate);  // 100ms
-        mDelayLeft.resize(maxDelaySamples + 1);
-        mDelayRight.resize(maxDelaySamples + 1);
-
-        // Update current delay amounts
-        size_t leftDelaySamples = delayMsToSamples(normalizedToDelayMs(mLeftDelay), mSampleRate);
-        size_t rightDelaySamples = delayMsToSamples(normalizedToDelayMs(mRightDelay), mSampleRate);
-        mDelayLeft.setDelay(leftDelaySamples);
-        mDelayRight.setDelay(rightDelaySamples);
+        size_t maxBlockSize = mScratchLeft.size();
+        mDelayLeft.resize(maxDelaySamples + maxBlockSize + 1);
+        mDelayRight.resize(maxDelaySamples + maxBlockSize + 1);
+
     }
 
+    // Delay targets and scope frames depend on the sample rate
+    updateDelayTargets();
+    mStereoAnalyzer.setSampleRate(mSampleRate);
+    mWorkloadStats.setSampleRate(mSampleRate);
+    if (mCapture)
+        mCapture->recordSetup(newSetup);
+
     return AudioEffect::setupProcessing(newSetup);
 }
 
@@ -268,61 +974,144 @@ tresult PLUGIN_API SimplePannerProcessor::canProcessSampleSize(int32 symbolicSam
 //------------------------------------------------------------------------
 tresult PLUGIN_API SimplePannerProcessor::setState(IBStream* state)
 {
-    if (!state)
+    TraceScope trace("lifecycle", "Processor::setState", mTraceInstance);
+
+    // Fields missing from older states keep their defaults
+    PluginState loaded = PluginState::defaults();
+    if (!StateSerializer::read(state, loaded))
         return kResultFalse;
 
-    IBStreamer streamer(state, kLittleEndian);
+    // getState reports this recall until it has been applied
+    ++mRecallGeneration;
+    mLastRecalled = loaded;
 
-    // Read version
-    int32 version = 0;
-    if (!streamer.readInt32(version))
-        return kResultFalse;
+    // process() may run even while inactive, so this thread never applies
+    // the state itself: the next process() or setActive(true) consumes it
+    mPendingState.publish({loaded, mRecallGeneration});
 
-    if (version != 1)
-        return kResultFalse;
+    return kResultOk;
+}
 
-    // Read 8 parameter values (normalized)
-    if (!streamer.readDouble(mLeftPan)) return kResultFalse;
-    if (!streamer.readDouble(mLeftGain)) return kResultFalse;
-    if (!streamer.readDouble(mLeftDelay)) return kResultFalse;
-    if (!streamer.readDouble(mRightPan)) return kResultFalse;
-    if (!streamer.readDouble(mRightGain)) return kResultFalse;
-    if (!streamer.readDouble(mRightDelay)) return kResultFalse;
-    if (!streamer.readDouble(mMasterGain)) return kResultFalse;
-    if (!streamer.readDouble(mLinkGain)) return kResultFalse;
-
-    // Update delay lines if active
-    if (mIsActive)
+//------------------------------------------------------------------------
+bool SimplePannerProcessor::applyPendingState()
+{
+    RecalledState recalled;
+    if (!mPendingState.consume(recalled))
+        return false;
+
+    applyState(recalled.state);
+    mAppliedGeneration = recalled.generation;
+    logDebug(mTraceInstance, "state recall {} applied", recalled.generation);
+    if (mCapture)
+        mCapture->recordState(recalled.state);
+    return true;
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::applyState(const PluginState& state)
+{
+    std::copy_n(state.values, kParamCount, mParams);
+    std::copy_n(state.values + kStateSnapshotB, kParamCount, mSnapshotB);
+
+    // Same resolution as the controller: linked gains follow Left Gain
+    if (isGainLinked())
+        mParams[kParamRightGain] = mParams[kParamLeftGain];
+    else
+        unshareGainSmoother();
+
+    // Smoothers glide to the recalled values (reset again by setActive)
+    for (Vst::ParamID id : kSmoothedParams)
     {
-        size_t leftDelaySamples = delayMsToSamples(normalizedToDelayMs(mLeftDelay), mSampleRate);
-        size_t rightDelaySamples = delayMsToSamples(normalizedToDelayMs(mRightDelay), mSampleRate);
-        mDelayLeft.setDelay(leftDelaySamples);
-        mDelayRight.setDelay(rightDelaySamples);
+        if (!(id == kParamRightGain && mGainSmootherShared))
+            mSmoothers[id].setTarget(static_cast<float>(mParams[id]));
     }
 
-    return kResultOk;
+    mCompileMixMatrix = kMatrixCompilers[normalizedToPanLaw(mParams[kParamPanLaw])];
+    compileSnapshotB();
+    mMixMatrixDirty = true;
+
+    updateDelayTargets();
 }
 
 //------------------------------------------------------------------------
-tresult PLUGIN_API SimplePannerProcessor::getState(IBStream* state)
+void SimplePannerProcessor::captureSnapshotB()
 {
-    if (!state)
-        return kResultFalse;
+    // Snapshot B takes the current settings (targets, not smoothed values)
+    PluginState state = currentState();
+    std::copy_n(state.values, kParamCount, mSnapshotB);
+
+    compileSnapshotB();
+    mMixMatrixDirty = true;
+    updateDelayTargets();
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::compileSnapshotB()
+{
+    // Snapshot B does not glide, so it is compiled once per change
+    MatrixCompiler compile = kMatrixCompilers[normalizedToPanLaw(mSnapshotB[kParamPanLaw])];
+    mMixMatrixB = compile(static_cast<float>(mSnapshotB[kParamLeftGain]),
+                          static_cast<float>(mSnapshotB[kParamRightGain]),
+                          static_cast<float>(mSnapshotB[kParamLeftPan]),
+                          static_cast<float>(mSnapshotB[kParamRightPan]),
+                          static_cast<float>(mSnapshotB[kParamMasterGain]));
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::updateDelayTargets()
+{
+    // Parameter → sample conversions, only when a delay, snapshot B or the sample rate changes
+    mDelaySamplesA[0] = static_cast<double>(delayMsToSamples(normalizedToDelayMs(mParams[kParamLeftDelay]), mSampleRate));
+    mDelaySamplesA[1] = static_cast<double>(delayMsToSamples(normalizedToDelayMs(mParams[kParamRightDelay]), mSampleRate));
+    mDelaySamplesB[0] = static_cast<double>(delayMsToSamples(normalizedToDelayMs(mSnapshotB[kParamLeftDelay]), mSampleRate));
+    mDelaySamplesB[1] = static_cast<double>(delayMsToSamples(normalizedToDelayMs(mSnapshotB[kParamRightDelay]), mSampleRate));
+
+    applyDelays();
+}
+
+//------------------------------------------------------------------------
+void SimplePannerProcessor::applyDelays()
+{
+    // Delay lines exist only while active
+    if (!mIsActive)
+        return;
+
+    double morph = mSmoothers[kParamMorph].getCurrentValue();
+    mDelayLeft.setDelay(static_cast<size_t>(mDelaySamplesA[0] + (mDelaySamplesB[0] - mDelaySamplesA[0]) * morph + 0.5));
+    mDelayRight.setDelay(static_cast<size_t>(mDelaySamplesA[1] + (mDelaySamplesB[1] - mDelaySamplesA[1]) * morph + 0.5));
+}
+
+//------------------------------------------------------------------------
+PluginState SimplePannerProcessor::currentState() const
+{
+    PluginState state;
+    std::copy_n(mParams, kParamCount, state.values);
+    std::copy_n(mSnapshotB, kParamCount, state.values + kStateSnapshotB);
+    return state;
+}
+
+//------------------------------------------------------------------------
+PluginState SimplePannerProcessor::getParameterSnapshot() const
+{
+    PluginState state;
+    mParameterSnapshot.read(state);
+    return state;
+}
 
-    IBStreamer streamer(state, kLittleEndian);
+//------------------------------------------------------------------------
+tresult PLUGIN_API SimplePannerProcessor::getState(IBStream* state)
+{
+    // Never touches the audio thread's members, so hosts need not serialize
+    // state saves against process()
+    PluginState saved;
+    uint32 generation = mParameterSnapshot.read(saved);
 
-    // Write version
-    streamer.writeInt32(1);
+    // A recall that process() has not picked up yet is newer than the snapshot
+    if (generation != mRecallGeneration)
+        saved = mLastRecalled;
 
-    // Write 8 parameter values (normalized)
-    streamer.writeDouble(mLeftPan);
-    streamer.writeDouble(mLeftGain);
-    streamer.writeDouble(mLeftDelay);
-    streamer.writeDouble(mRightPan);
-    streamer.writeDouble(mRightGain);
-    streamer.writeDouble(mRightDelay);
-    streamer.writeDouble(mMasterGain);
-    streamer.writeDouble(mLinkGain);
+    if (!StateSerializer::write(state, saved))
+        return kResultFalse;
 
     return kResultOk;
 }
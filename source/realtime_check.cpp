@@ -0,0 +1,246 @@
+// realtime_check.cpp
+// Interposed C library functions for SIMPLEPANNER_REALTIME_CHECK builds (Linux, glibc)
+//
+// Linked into the executable, these definitions take precedence over the
+// C library's. Each one records a violation when the calling thread is
+// inside a RealtimeScope and then forwards to the real function:
+// allocation goes to glibc's __libc_* entry points, everything else to the
+// next definition found by dlsym(RTLD_NEXT). operator new / delete reach
+// malloc / free, and std::mutex reaches pthread_mutex_lock, so C++ code is
+// covered as well. Reading clocks (vDSO) is allowed and not interposed.
+
+#undef _FORTIFY_SOURCE  // Inline read() / open() wrappers would clash with the definitions below
+
+#include "realtime_check.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/types.h>
+#include <time.h>
+
+#if !defined(__linux__) || !defined(__GLIBC__)
+#error "SIMPLEPANNER_REALTIME_CHECK is only supported on Linux with glibc"
+#endif
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void __libc_free(void* ptr);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+}
+
+namespace Steinberg {
+namespace SimplePanner {
+namespace RealtimeCheck {
+
+namespace {
+
+// Initial-exec TLS: reading it never allocates, even on a new thread
+__attribute__((tls_model("initial-exec"))) thread_local int tRealtimeDepth = 0;
+
+std::atomic<size_t> gViolationCount{0};
+std::atomic<const char*> gFirstViolation{nullptr};
+
+//------------------------------------------------------------------------
+inline void check(const char* function)
+{
+    if (tRealtimeDepth == 0)
+        return;
+
+    const char* none = nullptr;
+    gFirstViolation.compare_exchange_strong(none, function, std::memory_order_relaxed);
+    gViolationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------
+// Next definition of a C library function, looked up once. A race only
+// repeats the lookup; no static-local guard (which may lock) is involved.
+template <typename Function>
+Function* next(std::atomic<Function*>& cache, const char* name)
+{
+    Function* function = cache.load(std::memory_order_acquire);
+    if (!function)
+    {
+        function = reinterpret_cast<Function*>(dlsym(RTLD_NEXT, name));
+        cache.store(function, std::memory_order_release);
+    }
+    return function;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------
+void enter()
+{
+    ++tRealtimeDepth;
+}
+
+//------------------------------------------------------------------------
+void leave()
+{
+    --tRealtimeDepth;
+}
+
+//------------------------------------------------------------------------
+size_t violationCount()
+{
+    return gViolationCount.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------
+const char* firstViolation()
+{
+    return gFirstViolation.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------
+void resetViolations()
+{
+    gViolationCount.store(0, std::memory_order_relaxed);
+    gFirstViolation.store(nullptr, std::memory_order_relaxed);
+}
+
+} // namespace RealtimeCheck
+} // namespace SimplePanner
+} // namespace Steinberg
+
+using Steinberg::SimplePanner::RealtimeCheck::check;
+using Steinberg::SimplePanner::RealtimeCheck::next;
+
+// Forwarding definition of a function that is always a violation
+#define REALTIME_CHECK_FORWARD(ret, name, params, args, spec) \
+    extern "C" ret name params spec \
+    { \
+        static std::atomic<ret (*) params> real{nullptr}; \
+        check(#name); \
+        return next(real, #name) args; \
+    }
+
+//------------------------------------------------------------------------
+// Allocation
+//------------------------------------------------------------------------
+extern "C" void* malloc(size_t size) noexcept
+{
+    check("malloc");
+    return __libc_malloc(size);
+}
+
+extern "C" void free(void* ptr) noexcept
+{
+    check("free");
+    __libc_free(ptr);
+}
+
+extern "C" void* calloc(size_t count, size_t size) noexcept
+{
+    check("calloc");
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) noexcept
+{
+    check("realloc");
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void* memalign(size_t alignment, size_t size) noexcept
+{
+    check("memalign");
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    check("aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+{
+    check("posix_memalign");
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+        return 22;  // EINVAL
+
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr)
+        return 12;  // ENOMEM
+    *result = ptr;
+    return 0;
+}
+
+//------------------------------------------------------------------------
+// Locks and waits
+//------------------------------------------------------------------------
+REALTIME_CHECK_FORWARD(int, pthread_mutex_lock, (pthread_mutex_t* mutex), (mutex), noexcept)
+REALTIME_CHECK_FORWARD(int, pthread_rwlock_rdlock, (pthread_rwlock_t* lock), (lock), noexcept)
+REALTIME_CHECK_FORWARD(int, pthread_rwlock_wrlock, (pthread_rwlock_t* lock), (lock), noexcept)
+REALTIME_CHECK_FORWARD(int, pthread_spin_lock, (pthread_spinlock_t* lock), (lock), noexcept)
+REALTIME_CHECK_FORWARD(int, pthread_cond_wait, (pthread_cond_t* cond, pthread_mutex_t* mutex), (cond, mutex), )
+REALTIME_CHECK_FORWARD(int, pthread_cond_timedwait,
+                       (pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* abstime),
+                       (cond, mutex, abstime), )
+REALTIME_CHECK_FORWARD(int, pthread_join, (pthread_t thread, void** result), (thread, result), )
+REALTIME_CHECK_FORWARD(int, sem_wait, (sem_t* sem), (sem), )
+
+//------------------------------------------------------------------------
+// Blocking system calls
+//------------------------------------------------------------------------
+REALTIME_CHECK_FORWARD(ssize_t, read, (int fd, void* buffer, size_t count), (fd, buffer, count), )
+REALTIME_CHECK_FORWARD(ssize_t, write, (int fd, const void* buffer, size_t count), (fd, buffer, count), )
+REALTIME_CHECK_FORWARD(int, close, (int fd), (fd), )
+REALTIME_CHECK_FORWARD(int, nanosleep, (const struct timespec* duration, struct timespec* remaining),
+                       (duration, remaining), )
+REALTIME_CHECK_FORWARD(int, clock_nanosleep,
+                       (clockid_t clock, int flags, const struct timespec* duration, struct timespec* remaining),
+                       (clock, flags, duration, remaining), )
+REALTIME_CHECK_FORWARD(int, usleep, (useconds_t micros), (micros), )
+REALTIME_CHECK_FORWARD(int, sched_yield, (), (), noexcept)
+REALTIME_CHECK_FORWARD(void*, mmap, (void* address, size_t length, int protection, int flags, int fd, off_t offset),
+                       (address, length, protection, flags, fd, offset), noexcept)
+REALTIME_CHECK_FORWARD(int, munmap, (void* address, size_t length), (address, length), noexcept)
+
+// Variadic: the optional mode is always passed on (ignored without O_CREAT)
+extern "C" int open(const char* path, int flags, ...)
+{
+    static std::atomic<int (*)(const char*, int, ...)> real{nullptr};
+    check("open");
+    va_list args;
+    va_start(args, flags);
+    unsigned int mode = va_arg(args, unsigned int);
+    va_end(args);
+    return next(real, "open")(path, flags, mode);
+}
+
+extern "C" int openat(int dirfd, const char* path, int flags, ...)
+{
+    static std::atomic<int (*)(int, const char*, int, ...)> real{nullptr};
+    check("openat");
+    va_list args;
+    va_start(args, flags);
+    unsigned int mode = va_arg(args, unsigned int);
+    va_end(args);
+    return next(real, "openat")(dirfd, path, flags, mode);
+}
+
+// Raw system calls (e.g. futex waits of std::atomic::wait), forwarded with
+// the maximum of six arguments
+extern "C" long syscall(long number, ...) noexcept
+{
+    static std::atomic<long (*)(long, ...)> real{nullptr};
+    check("syscall");
+    va_list args;
+    va_start(args, number);
+    long a = va_arg(args, long);
+    long b = va_arg(args, long);
+    long c = va_arg(args, long);
+    long d = va_arg(args, long);
+    long e = va_arg(args, long);
+    long f = va_arg(args, long);
+    va_end(args);
+    return next(real, "syscall")(number, a, b, c, d, e, f);
+}
@@ -0,0 +1,225 @@
+// process_test_helpers.h
+// Minimal host-side helpers for driving SimplePannerProcessor::process() in tests
+
+#pragma once
+
+#include "record_message.h"
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+#include "pluginterfaces/vst/ivstmessage.h"
+#include "public.sdk/source/vst/hosting/hostclasses.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace SimplePannerTest {
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+//------------------------------------------------------------------------------
+// Parameter value queue holding (sampleOffset, value) points
+//------------------------------------------------------------------------------
+class TestParamValueQueue : public IParamValueQueue {
+public:
+    explicit TestParamValueQueue(ParamID id) : mId(id) {}
+    virtual ~TestParamValueQueue() = default;
+
+    ParamID PLUGIN_API getParameterId() override { return mId; }
+    int32 PLUGIN_API getPointCount() override { return static_cast<int32>(mPoints.size()); }
+
+    tresult PLUGIN_API getPoint(int32 index, int32& sampleOffset, ParamValue& value) override {
+        if (index < 0 || index >= getPointCount())
+            return kResultFalse;
+        sampleOffset = mPoints[index].first;
+        value = mPoints[index].second;
+        return kResultTrue;
+    }
+
+    tresult PLUGIN_API addPoint(int32 sampleOffset, ParamValue value, int32& index) override {
+        mPoints.emplace_back(sampleOffset, value);
+        index = getPointCount() - 1;
+        return kResultTrue;
+    }
+
+    tresult PLUGIN_API queryInterface(const TUID, void** obj) override {
+        *obj = nullptr;
+        return kNoInterface;
+    }
+    uint32 PLUGIN_API addRef() override { return 1; }
+    uint32 PLUGIN_API release() override { return 1; }
+
+private:
+    ParamID mId;
+    std::vector<std::pair<int32, ParamValue>> mPoints;
+};
+
+//------------------------------------------------------------------------------
+// Parameter change list (one queue per parameter)
+//------------------------------------------------------------------------------
+class TestParameterChanges : public IParameterChanges {
+public:
+    virtual ~TestParameterChanges() = default;
+
+    int32 PLUGIN_API getParameterCount() override { return static_cast<int32>(mQueues.size()); }
+
+    IParamValueQueue* PLUGIN_API getParameterData(int32 index) override {
+        if (index < 0 || index >= getParameterCount())
+            return nullptr;
+        return mQueues[index].get();
+    }
+
+    IParamValueQueue* PLUGIN_API addParameterData(const ParamID& id, int32& index) override {
+        for (size_t i = 0; i < mQueues.size(); ++i) {
+            if (mQueues[i]->getParameterId() == id) {
+                index = static_cast<int32>(i);
+                return mQueues[i].get();
+            }
+        }
+        mQueues.emplace_back(new TestParamValueQueue(id));
+        index = getParameterCount() - 1;
+        return mQueues.back().get();
+    }
+
+    // Convenience: add a single point
+    void add(ParamID id, ParamValue value, int32 sampleOffset = 0) {
+        int32 index = 0;
+        addParameterData(id, index)->addPoint(sampleOffset, value, index);
+    }
+
+    // Last value reported for a parameter, or -1.0 if none
+    ParamValue lastValue(ParamID id) {
+        for (auto& queue : mQueues) {
+            if (queue->getParameterId() == id && queue->getPointCount() > 0) {
+                int32 offset = 0;
+                ParamValue value = 0.0;
+                queue->getPoint(queue->getPointCount() - 1, offset, value);
+                return value;
+            }
+        }
+        return -1.0;
+    }
+
+    void clear() { mQueues.clear(); }
+
+    tresult PLUGIN_API queryInterface(const TUID, void** obj) override {
+        *obj = nullptr;
+        return kNoInterface;
+    }
+    uint32 PLUGIN_API addRef() override { return 1; }
+    uint32 PLUGIN_API release() override { return 1; }
+
+private:
+    std::vector<std::unique_ptr<TestParamValueQueue>> mQueues;
+};
+
+//------------------------------------------------------------------------------
+// Connection point standing in for the controller: keeps every message the
+// processor sends (connect the processor to it; messages come from a
+// Vst::HostApplication passed to initialize())
+//------------------------------------------------------------------------------
+class TestConnectionPoint : public IConnectionPoint {
+public:
+    virtual ~TestConnectionPoint() = default;
+
+    tresult PLUGIN_API connect(IConnectionPoint*) override { return kResultTrue; }
+    tresult PLUGIN_API disconnect(IConnectionPoint*) override { return kResultTrue; }
+
+    tresult PLUGIN_API notify(IMessage* message) override {
+        if (!message)
+            return kInvalidArgument;
+        mMessages.emplace_back(message);
+        return kResultTrue;
+    }
+
+    // Number of messages received with the given ID
+    size_t count(FIDString messageId) const {
+        size_t numMessages = 0;
+        for (const auto& message : mMessages) {
+            if (std::strcmp(message->getMessageID(), messageId) == 0)
+                ++numMessages;
+        }
+        return numMessages;
+    }
+
+    // Records of all messages with the given ID, in arrival order
+    template <typename T>
+    std::vector<T> records(FIDString messageId) const {
+        std::vector<T> all;
+        for (const auto& message : mMessages) {
+            if (std::strcmp(message->getMessageID(), messageId) != 0)
+                continue;
+            T batch[kMaxBatch];
+            size_t numRecords = SimplePanner::readRecords(message->getAttributes(), batch, kMaxBatch);
+            all.insert(all.end(), batch, batch + numRecords);
+        }
+        return all;
+    }
+
+    void clear() { mMessages.clear(); }
+
+    tresult PLUGIN_API queryInterface(const TUID, void** obj) override {
+        *obj = nullptr;
+        return kNoInterface;
+    }
+    uint32 PLUGIN_API addRef() override { return 1; }
+    uint32 PLUGIN_API release() override { return 1; }
+
+private:
+    static constexpr size_t kMaxBatch = 64;
+
+    std::vector<IPtr<IMessage>> mMessages;
+};
+
+// Send the controller's telemetry poll to a processor
+template <typename Processor>
+void pollTelemetry(Processor* processor) {
+    IPtr<IMessage> poll = owned(static_cast<IMessage*>(new HostMessage));
+    poll->setMessageID(SimplePanner::TelemetryPoll::kId);
+    processor->notify(poll);
+}
+
+//------------------------------------------------------------------------------
+// Stereo in/out buffers wired into a ProcessData
+//------------------------------------------------------------------------------
+class StereoBlock {
+public:
+    explicit StereoBlock(int32 numSamples)
+        : inL(numSamples, 0.0f), inR(numSamples, 0.0f)
+        , outL(numSamples, 0.0f), outR(numSamples, 0.0f)
+    {
+        mInputs[0] = inL.data();
+        mInputs[1] = inR.data();
+        mOutputs[0] = outL.data();
+        mOutputs[1] = outR.data();
+
+        mInputBus.numChannels = 2;
+        mInputBus.channelBuffers32 = mInputs;
+        mOutputBus.numChannels = 2;
+        mOutputBus.channelBuffers32 = mOutputs;
+
+        data.processMode = kRealtime;
+        data.symbolicSampleSize = kSample32;
+        data.numSamples = numSamples;
+        data.numInputs = 1;
+        data.numOutputs = 1;
+        data.inputs = &mInputBus;
+        data.outputs = &mOutputBus;
+    }
+
+    StereoBlock(const StereoBlock&) = delete;
+    StereoBlock& operator=(const StereoBlock&) = delete;
+
+    std::vector<float> inL, inR, outL, outR;
+    ProcessData data;
+
+private:
+    float* mInputs[2];
+    float* mOutputs[2];
+    AudioBusBuffers mInputBus;
+    AudioBusBuffers mOutputBus;
+};
+
+} // namespace SimplePannerTest
@@ -0,0 +1,81 @@
+// test_audio_log.cpp
+// Integration test for the log SimplePannerProcessor writes when
+// PluginInfo::kLogEnv is set
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "audio_logger.h"
+#include "process_test_helpers.h"
+#include "test_file_helpers.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+//------------------------------------------------------------------------------
+// Session log
+//------------------------------------------------------------------------------
+
+TEST(AudioLog, Session_RecordsFromAudioAndMainThread) {
+    // Must precede the first AudioLogger::get() in this executable
+    std::string path = ::testing::TempDir() + "simplepanner.log";
+    setEnvironment(PluginInfo::kLogEnv, path.c_str());
+
+    const int32 kBlockSize = 128;
+    SimplePannerProcessor* processor = new SimplePannerProcessor();
+    processor->initialize(nullptr);
+
+    ProcessSetup setup;
+    setup.processMode = kRealtime;
+    setup.symbolicSampleSize = kSample32;
+    setup.maxSamplesPerBlock = kBlockSize;
+    setup.sampleRate = 44100.0;
+    processor->setupProcessing(setup);
+    processor->setActive(true);
+
+    // Two program changes more than a block keeps: two warnings
+    TestParameterChanges changes;
+    for (int32 i = 0; i < 18; ++i)
+        changes.add(kParamProgram, 0.0, i);
+
+    StereoBlock block(kBlockSize);
+    block.data.inputParameterChanges = &changes;
+    processor->process(block.data);
+
+    processor->setActive(false);
+    processor->terminate();
+    processor->release();
+
+    AudioLogger* logger = AudioLogger::get();
+    ASSERT_NE(logger, nullptr);
+
+    // Warnings always; initialize and activation notes from the info level on
+    const uint64 kExpectedRecords = isLogLevelEnabled(LogLevel::kInfo) ? 4 : 2;
+    for (int i = 0; i < 300 && logger->numWritten() < kExpectedRecords; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(logger->numWritten(), kExpectedRecords);
+
+    std::string log = readFile(path);
+
+    EXPECT_EQ(countOf(log, "] W #"), 2u);
+    EXPECT_NE(log.find(" more than 16 program changes in one block; offset 16 replaces the last\n"),
+              std::string::npos);
+    EXPECT_NE(log.find(" more than 16 program changes in one block; offset 17 replaces the last\n"),
+              std::string::npos);
+    if (isLogLevelEnabled(LogLevel::kInfo)) {
+        EXPECT_NE(log.find("] I #"), std::string::npos);
+        EXPECT_NE(log.find(" initialized with 1 programs\n"), std::string::npos);
+        EXPECT_NE(log.find(" activated at 44100 Hz, up to 128 samples per block\n"), std::string::npos);
+        EXPECT_LT(log.find("initialized"), log.find("activated"));
+    }
+
+    // Module exit: the writer is stopped; later records go nowhere
+    AudioLogger::shutdown();
+    EXPECT_EQ(AudioLogger::get(), nullptr);
+    logWarning(1, "after shutdown");
+}
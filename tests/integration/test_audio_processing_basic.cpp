@@ -0,0 +1,647 @@
+// test_audio_processing_basic.cpp
+// Integration tests for SimplePannerProcessor audio processing
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "parameter_utils.h"
+#include "pan_calculator.h"
+#include "state_serializer.h"
+#include "preset_bank.h"
+#include "process_test_helpers.h"
+#include "public.sdk/source/common/memorystream.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+class AudioProcessingTest : public ::testing::Test {
+protected:
+    static constexpr int32 kBlockSize = 256;
+    static constexpr double kSampleRate = 48000.0;
+
+    void SetUp() override {
+        processor = new SimplePannerProcessor();
+        processor->initialize(nullptr);
+
+        ProcessSetup setup;
+        setup.processMode = kRealtime;
+        setup.symbolicSampleSize = kSample32;
+        setup.maxSamplesPerBlock = kBlockSize;
+        setup.sampleRate = kSampleRate;
+        processor->setupProcessing(setup);
+        processor->setActive(true);
+    }
+
+    void TearDown() override {
+        processor->setActive(false);
+        processor->terminate();
+        processor->release();
+    }
+
+    // Fill the block with a deterministic test signal continuing from mSampleIndex
+    void fillInput(StereoBlock& block) {
+        for (int32 i = 0; i < block.data.numSamples; ++i, ++mSampleIndex) {
+            block.inL[i] = std::sin(0.031f * mSampleIndex);
+            block.inR[i] = 0.5f * std::cos(0.017f * mSampleIndex);
+        }
+    }
+
+    // Apply parameter changes and run enough silent blocks for smoothing to settle
+    void applyAndSettle(TestParameterChanges& changes) {
+        StereoBlock block(kBlockSize);
+        block.data.inputParameterChanges = &changes;
+        processor->process(block.data);
+        block.data.inputParameterChanges = nullptr;
+        for (int i = 0; i < 40; ++i)
+            processor->process(block.data);
+    }
+
+    SimplePannerProcessor* processor = nullptr;
+    int32 mSampleIndex = 0;
+};
+
+//------------------------------------------------------------------------------
+// Default (transparent) configuration
+//------------------------------------------------------------------------------
+
+TEST_F(AudioProcessingTest, DefaultParameters_PassThroughWithOneSampleLatency) {
+    StereoBlock block(kBlockSize);
+    float previousL = 0.0f;
+    float previousR = 0.0f;
+
+    for (int b = 0; b < 4; ++b) {
+        fillInput(block);
+        processor->process(block.data);
+
+        for (int32 i = 0; i < kBlockSize; ++i) {
+            EXPECT_NEAR(block.outL[i], previousL, 1.0e-6f);
+            EXPECT_NEAR(block.outR[i], previousR, 1.0e-6f);
+            previousL = block.inL[i];
+            previousR = block.inR[i];
+        }
+    }
+}
+
+TEST_F(AudioProcessingTest, InPlaceProcessing_MatchesSeparateBuffers) {
+    SimplePannerProcessor* reference = new SimplePannerProcessor();
+    reference->initialize(nullptr);
+    ProcessSetup setup = {kRealtime, kSample32, kBlockSize, kSampleRate};
+    reference->setupProcessing(setup);
+    reference->setActive(true);
+
+    TestParameterChanges changes;
+    changes.add(kParamLeftPan, 0.3);
+    changes.add(kParamRightDelay, 0.05);
+    changes.add(kParamMasterGain, 0.8);
+
+    StereoBlock separate(kBlockSize);
+    StereoBlock inPlace(kBlockSize);
+    float* inPlaceBuffers[2] = {inPlace.inL.data(), inPlace.inR.data()};
+    inPlace.data.outputs[0].channelBuffers32 = inPlaceBuffers;
+
+    for (int b = 0; b < 8; ++b) {
+        fillInput(separate);
+        inPlace.inL = separate.inL;
+        inPlace.inR = separate.inR;
+
+        separate.data.inputParameterChanges = (b == 0) ? &changes : nullptr;
+        inPlace.data.inputParameterChanges = (b == 0) ? &changes : nullptr;
+        reference->process(separate.data);
+        processor->process(inPlace.data);
+
+        for (int32 i = 0; i < kBlockSize; ++i) {
+            EXPECT_FLOAT_EQ(inPlace.inL[i], separate.outL[i]);
+            EXPECT_FLOAT_EQ(inPlace.inR[i], separate.outR[i]);
+        }
+    }
+
+    reference->setActive(false);
+    reference->terminate();
+    reference->release();
+}
+
+//------------------------------------------------------------------------------
+// Static configurations
+//------------------------------------------------------------------------------
+
+TEST_F(AudioProcessingTest, CenterPan_MixesBothChannelsEqually) {
+    TestParameterChanges changes;
+    changes.add(kParamLeftPan, 0.5);
+    changes.add(kParamRightPan, 0.5);
+    applyAndSettle(changes);
+
+    StereoBlock block(kBlockSize);
+    fillInput(block);
+    processor->process(block.data);
+
+    PanGains center = calculatePanGains(0.0f);
+    for (int32 i = 1; i < kBlockSize; ++i) {
+        float expectedL = block.inL[i - 1] * center.left + block.inR[i - 1] * center.left;
+        float expectedR = block.inL[i - 1] * center.right + block.inR[i - 1] * center.right;
+        EXPECT_NEAR(block.outL[i], expectedL, 1.0e-3f);
+        EXPECT_NEAR(block.outR[i], expectedR, 1.0e-3f);
+    }
+}
+
+TEST_F(AudioProcessingTest, PanLaw_ChangesCenterLevel) {
+    const float expectedCenterDb[kPanLawCount] = {-6.02f, -4.52f, -3.01f, 0.0f};
+
+    for (int law = 0; law < kPanLawCount; ++law) {
+        TestParameterChanges changes;
+        changes.add(kParamLeftPan, 0.5);
+        changes.add(kParamRightPan, 0.5);
+        changes.add(kParamPanLaw, panLawToNormalized(law));
+        applyAndSettle(changes);
+
+        StereoBlock block(kBlockSize);
+        std::fill(block.inL.begin(), block.inL.end(), 1.0f);
+        processor->process(block.data);
+
+        EXPECT_NEAR(20.0f * std::log10(block.outL[kBlockSize - 1]), expectedCenterDb[law], 0.01f)
+            << "pan law " << law;
+        EXPECT_FLOAT_EQ(block.outL[kBlockSize - 1], block.outR[kBlockSize - 1]);
+    }
+}
+
+TEST_F(AudioProcessingTest, LeftDelay_DelaysOnlyLeftChannel) {
+    TestParameterChanges changes;
+    changes.add(kParamLeftDelay, delayMsToNormalized(1.0f));  // 48 samples
+    applyAndSettle(changes);
+
+    StereoBlock block(kBlockSize);
+    std::vector<float> historyL;
+    std::vector<float> historyR;
+
+    for (int b = 0; b < 3; ++b) {
+        fillInput(block);
+        processor->process(block.data);
+        historyL.insert(historyL.end(), block.inL.begin(), block.inL.end());
+        historyR.insert(historyR.end(), block.inR.begin(), block.inR.end());
+    }
+
+    size_t start = historyL.size() - kBlockSize;
+    for (int32 i = 0; i < kBlockSize; ++i) {
+        EXPECT_NEAR(block.outL[i], historyL[start + i - 48], 1.0e-3f);
+        EXPECT_NEAR(block.outR[i], historyR[start + i - 1], 1.0e-3f);
+    }
+}
+
+TEST_F(AudioProcessingTest, MasterGainMinimum_Mutes) {
+    TestParameterChanges changes;
+    changes.add(kParamMasterGain, 0.0);
+    applyAndSettle(changes);
+
+    StereoBlock block(kBlockSize);
+    fillInput(block);
+    processor->process(block.data);
+
+    for (int32 i = 0; i < kBlockSize; ++i) {
+        EXPECT_FLOAT_EQ(block.outL[i], 0.0f);
+        EXPECT_FLOAT_EQ(block.outR[i], 0.0f);
+    }
+}
+
+TEST_F(AudioProcessingTest, ChannelGain_AppliedPerChannel) {
+    TestParameterChanges changes;
+    changes.add(kParamLeftGain, dbToNormalized(-6.0f));
+    changes.add(kParamRightGain, dbToNormalized(3.0f));
+    applyAndSettle(changes);
+
+    StereoBlock block(kBlockSize);
+    fillInput(block);
+    processor->process(block.data);
+
+    for (int32 i = 1; i < kBlockSize; ++i) {
+        EXPECT_NEAR(block.outL[i], block.inL[i - 1] * dbToLinear(-6.0f), 1.0e-3f);
+        EXPECT_NEAR(block.outR[i], block.inR[i - 1] * dbToLinear(3.0f), 1.0e-3f);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Smoothing and block handling
+//------------------------------------------------------------------------------
+
+TEST_F(AudioProcessingTest, GainChange_IsSmoothed) {
+    TestParameterChanges changes;
+    changes.add(kParamMasterGain, 0.0);
+
+    StereoBlock block(kBlockSize);
+    std::fill(block.inL.begin(), block.inL.end(), 1.0f);
+    std::fill(block.inR.begin(), block.inR.end(), 1.0f);
+    block.data.inputParameterChanges = &changes;
+    processor->process(block.data);
+
+    // Output ramps down instead of jumping to silence
+    EXPECT_GT(block.outL[1], 0.9f);
+    EXPECT_LT(block.outL[kBlockSize - 1], block.outL[1]);
+    EXPECT_GT(block.outL[kBlockSize - 1], 0.0f);
+}
+
+TEST_F(AudioProcessingTest, BlockLargerThanMaxSamplesPerBlock_IsProcessed) {
+    StereoBlock block(kBlockSize * 3 + 17);
+    fillInput(block);
+    processor->process(block.data);
+
+    for (int32 i = 1; i < block.data.numSamples; ++i) {
+        EXPECT_NEAR(block.outL[i], block.inL[i - 1], 1.0e-6f);
+        EXPECT_NEAR(block.outR[i], block.inR[i - 1], 1.0e-6f);
+    }
+}
+
+TEST_F(AudioProcessingTest, Inactive_OutputsSilence) {
+    processor->setActive(false);
+
+    StereoBlock block(kBlockSize);
+    fillInput(block);
+    processor->process(block.data);
+
+    for (int32 i = 0; i < kBlockSize; ++i) {
+        EXPECT_FLOAT_EQ(block.outL[i], 0.0f);
+        EXPECT_FLOAT_EQ(block.outR[i], 0.0f);
+    }
+
+    processor->setActive(true);
+}
+
+//------------------------------------------------------------------------------
+// State recall while active
+//------------------------------------------------------------------------------
+
+TEST_F(AudioProcessingTest, SetStateWhileActive_AppliedSmoothlyAtNextBlock) {
+    PluginState recalled = PluginState::defaults();
+    recalled.values[kParamMasterGain] = 0.0;  // mute
+
+    MemoryStream stream;
+    ASSERT_TRUE(StateSerializer::write(&stream, recalled));
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    EXPECT_EQ(processor->setState(&stream), kResultOk);
+
+    StereoBlock block(kBlockSize);
+    std::fill(block.inL.begin(), block.inL.end(), 1.0f);
+    std::fill(block.inR.begin(), block.inR.end(), 1.0f);
+    processor->process(block.data);
+
+    // Recalled values glide in like automation
+    EXPECT_GT(block.outL[1], 0.9f);
+    EXPECT_LT(block.outL[kBlockSize - 1], block.outL[1]);
+
+    for (int i = 0; i < 40; ++i)
+        processor->process(block.data);
+    EXPECT_FLOAT_EQ(block.outL[kBlockSize - 1], 0.0f);
+    EXPECT_FLOAT_EQ(block.outR[kBlockSize - 1], 0.0f);
+}
+
+TEST_F(AudioProcessingTest, SetStateWhileActive_ParameterChangeInSameBlockWins) {
+    PluginState recalled = PluginState::defaults();
+    recalled.values[kParamMasterGain] = 0.0;
+
+    MemoryStream stream;
+    ASSERT_TRUE(StateSerializer::write(&stream, recalled));
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    processor->setState(&stream);
+
+    TestParameterChanges changes;
+    changes.add(kParamMasterGain, dbToNormalized(0.0f));
+    applyAndSettle(changes);
+
+    StereoBlock block(kBlockSize);
+    fillInput(block);
+    processor->process(block.data);
+    for (int32 i = 1; i < kBlockSize; ++i)
+        EXPECT_NEAR(block.outL[i], block.inL[i - 1], 1.0e-6f);
+}
+
+TEST_F(AudioProcessingTest, GetState_ReflectsAutomationAfterProcess) {
+    TestParameterChanges changes;
+    changes.add(kParamLeftDelay, 0.25);
+
+    StereoBlock block(kBlockSize);
+    block.data.inputParameterChanges = &changes;
+    processor->process(block.data);
+
+    EXPECT_EQ(processor->getParameterSnapshot().values[kParamLeftDelay], 0.25);
+
+    MemoryStream stream;
+    ASSERT_EQ(processor->getState(&stream), kResultOk);
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState saved = {};
+    ASSERT_TRUE(StateSerializer::read(&stream, saved));
+    EXPECT_EQ(saved.values[kParamLeftDelay], 0.25);
+}
+
+TEST_F(AudioProcessingTest, GetState_AfterSetStateWhileActive_ReportsRecalledState) {
+    PluginState recalled = PluginState::defaults();
+    recalled.values[kParamRightDelay] = 0.75;
+
+    MemoryStream stream;
+    ASSERT_TRUE(StateSerializer::write(&stream, recalled));
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    ASSERT_EQ(processor->setState(&stream), kResultOk);
+
+    // process() has not run yet: the pending recall is reported
+    MemoryStream saved;
+    ASSERT_EQ(processor->getState(&saved), kResultOk);
+    saved.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState savedState = {};
+    ASSERT_TRUE(StateSerializer::read(&saved, savedState));
+    EXPECT_EQ(savedState.values[kParamRightDelay], 0.75);
+
+    // Once picked up, the snapshot carries it
+    StereoBlock block(kBlockSize);
+    processor->process(block.data);
+    EXPECT_EQ(processor->getParameterSnapshot().values[kParamRightDelay], 0.75);
+}
+
+TEST_F(AudioProcessingTest, SetStateWhileInactive_AppliedBySetActive) {
+    processor->setActive(false);
+
+    PluginState recalled = PluginState::defaults();
+    recalled.values[kParamMasterGain] = 0.0;  // mute
+
+    MemoryStream stream;
+    ASSERT_TRUE(StateSerializer::write(&stream, recalled));
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    ASSERT_EQ(processor->setState(&stream), kResultOk);
+
+    // The pending recall is reported before anything applied it
+    MemoryStream saved;
+    ASSERT_EQ(processor->getState(&saved), kResultOk);
+    saved.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState savedState = {};
+    ASSERT_TRUE(StateSerializer::read(&saved, savedState));
+    EXPECT_EQ(savedState.values[kParamMasterGain], 0.0);
+
+    // setActive(true) applies it before resetting the smoothers: no glide
+    processor->setActive(true);
+    StereoBlock block(kBlockSize);
+    std::fill(block.inL.begin(), block.inL.end(), 1.0f);
+    std::fill(block.inR.begin(), block.inR.end(), 1.0f);
+    processor->process(block.data);
+    for (int32 i = 0; i < kBlockSize; ++i) {
+        EXPECT_FLOAT_EQ(block.outL[i], 0.0f);
+        EXPECT_FLOAT_EQ(block.outR[i], 0.0f);
+    }
+    EXPECT_EQ(processor->getParameterSnapshot().values[kParamMasterGain], 0.0);
+}
+
+//------------------------------------------------------------------------------
+// Program Change (preset table)
+//------------------------------------------------------------------------------
+
+namespace {
+
+// Write a two-preset bank: 0 = defaults, 1 = muted with Left Delay 0.25
+std::string writeTestBank(const char* fileName) {
+    PresetBankEntry unity = {"Unity", PluginState::defaults()};
+    PresetBankEntry muted = {"Muted", PluginState::defaults()};
+    muted.state.values[kParamMasterGain] = 0.0;
+    muted.state.values[kParamLeftDelay] = 0.25;
+    std::vector<uint8> data = PresetBank::build({unity, muted});
+
+    const char* dir = std::getenv("TMPDIR");
+    std::string path = std::string(dir ? dir : "/tmp") + "/" + fileName;
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return std::string();
+    std::fwrite(data.data(), 1, data.size(), file);
+    std::fclose(file);
+    return path;
+}
+
+} // namespace
+
+TEST_F(AudioProcessingTest, ProgramChange_AppliedAtSampleOffset) {
+    std::string path = writeTestBank("simplepanner_program_bank.sppb");
+    ASSERT_FALSE(path.empty());
+    processor->setActive(false);
+    ASSERT_TRUE(processor->loadPresetTable(path.c_str()));
+    processor->setActive(true);
+    std::remove(path.c_str());
+
+    const int32 kChangeOffset = 100;
+    TestParameterChanges changes;
+    changes.add(kParamProgram, programToNormalized(1, 2), kChangeOffset);
+
+    StereoBlock block(kBlockSize);
+    std::fill(block.inL.begin(), block.inL.end(), 1.0f);
+    std::fill(block.inR.begin(), block.inR.end(), 1.0f);
+    block.data.inputParameterChanges = &changes;
+    processor->process(block.data);
+
+    // Untouched up to the change, gliding towards mute from the change on
+    for (int32 i = 1; i < kChangeOffset; ++i)
+        EXPECT_EQ(block.outR[i], 1.0f) << "sample " << i;
+    EXPECT_LT(block.outR[kChangeOffset], 1.0f);
+    EXPECT_LT(block.outR[kBlockSize - 1], block.outR[kChangeOffset]);
+
+    // All program values are in effect (and reported) after the block
+    PluginState snapshot = processor->getParameterSnapshot();
+    EXPECT_EQ(snapshot.values[kParamMasterGain], 0.0);
+    EXPECT_EQ(snapshot.values[kParamLeftDelay], 0.25);
+
+    block.data.inputParameterChanges = nullptr;
+    for (int i = 0; i < 40; ++i)
+        processor->process(block.data);
+    EXPECT_FLOAT_EQ(block.outR[kBlockSize - 1], 0.0f);
+}
+
+TEST_F(AudioProcessingTest, ProgramChange_MultipleChangesInOneBlock) {
+    std::string path = writeTestBank("simplepanner_program_bank2.sppb");
+    ASSERT_FALSE(path.empty());
+    processor->setActive(false);
+    ASSERT_TRUE(processor->loadPresetTable(path.c_str()));
+    processor->setActive(true);
+    std::remove(path.c_str());
+
+    TestParameterChanges changes;
+    changes.add(kParamProgram, programToNormalized(1, 2), 10);
+    changes.add(kParamProgram, programToNormalized(0, 2), 200);
+
+    StereoBlock block(kBlockSize);
+    block.data.inputParameterChanges = &changes;
+    processor->process(block.data);
+
+    // The last change in the block wins
+    PluginState snapshot = processor->getParameterSnapshot();
+    EXPECT_EQ(snapshot.values[kParamMasterGain], PluginState::defaults().values[kParamMasterGain]);
+    EXPECT_EQ(snapshot.values[kParamLeftDelay], PluginState::defaults().values[kParamLeftDelay]);
+}
+
+TEST_F(AudioProcessingTest, ProgramChange_WithoutBank_RecallsDefaults) {
+    processor->setActive(false);
+    EXPECT_FALSE(processor->loadPresetTable(nullptr));
+    processor->setActive(true);
+
+    TestParameterChanges automation;
+    automation.add(kParamRightPan, 0.3);
+    automation.add(kParamMasterGain, 0.4);
+    applyAndSettle(automation);
+
+    TestParameterChanges changes;
+    changes.add(kParamProgram, 0.0, 17);
+    applyAndSettle(changes);
+
+    PluginState snapshot = processor->getParameterSnapshot();
+    PluginState defaults = PluginState::defaults();
+    for (int32 i = 0; i < StateSerializer::kNumFields; ++i)
+        EXPECT_EQ(snapshot.values[i], defaults.values[i]) << "field " << i;
+}
+
+//------------------------------------------------------------------------------
+// A/B Morph
+//------------------------------------------------------------------------------
+
+TEST_F(AudioProcessingTest, Morph_BlendsTowardsCapturedSnapshotB) {
+    // B: left channel at -12 dB
+    TestParameterChanges setB;
+    setB.add(kParamLeftGain, dbToNormalized(-12.0f));
+    applyAndSettle(setB);
+    TestParameterChanges capture;
+    capture.add(kParamCaptureB, 1.0);
+    applyAndSettle(capture);
+
+    // A: back to unity
+    TestParameterChanges setA;
+    setA.add(kParamLeftGain, dbToNormalized(0.0f));
+    applyAndSettle(setA);
+
+    StereoBlock block(kBlockSize);
+    fillInput(block);
+    processor->process(block.data);
+    for (int32 i = 1; i < kBlockSize; ++i)
+        EXPECT_NEAR(block.outL[i], block.inL[i - 1], 1.0e-6f);
+
+    TestParameterChanges morphB;
+    morphB.add(kParamMorph, 1.0);
+    applyAndSettle(morphB);
+    fillInput(block);
+    processor->process(block.data);
+    for (int32 i = 1; i < kBlockSize; ++i) {
+        EXPECT_NEAR(block.outL[i], block.inL[i - 1] * dbToLinear(-12.0f), 1.0e-3f);
+        EXPECT_NEAR(block.outR[i], block.inR[i - 1], 1.0e-6f);
+    }
+
+    TestParameterChanges morphHalf;
+    morphHalf.add(kParamMorph, 0.5);
+    applyAndSettle(morphHalf);
+    fillInput(block);
+    processor->process(block.data);
+    float halfGain = 0.5f * (1.0f + dbToLinear(-12.0f));
+    for (int32 i = 1; i < kBlockSize; ++i)
+        EXPECT_NEAR(block.outL[i], block.inL[i - 1] * halfGain, 1.0e-3f);
+}
+
+TEST_F(AudioProcessingTest, CaptureB_ReportsOffAndCapturesEveryPress) {
+    // First press: B at -12 dB, and the switch is reported back to Off
+    TestParameterChanges setB;
+    setB.add(kParamLeftGain, dbToNormalized(-12.0f));
+    applyAndSettle(setB);
+    TestParameterChanges capture;
+    capture.add(kParamCaptureB, 1.0, 16);
+    TestParameterChanges reported;
+    StereoBlock block(kBlockSize);
+    block.data.inputParameterChanges = &capture;
+    block.data.outputParameterChanges = &reported;
+    processor->process(block.data);
+    EXPECT_EQ(reported.lastValue(kParamCaptureB), 0.0);
+
+    // Second press without an Off in between: B at -6 dB
+    TestParameterChanges setB2;
+    setB2.add(kParamLeftGain, dbToNormalized(-6.0f));
+    applyAndSettle(setB2);
+    reported.clear();
+    processor->process(block.data);
+    EXPECT_EQ(reported.lastValue(kParamCaptureB), 0.0);
+
+    // A: unity; full morph plays the second capture
+    TestParameterChanges setA;
+    setA.add(kParamLeftGain, dbToNormalized(0.0f));
+    setA.add(kParamMorph, 1.0);
+    applyAndSettle(setA);
+    block.data.inputParameterChanges = nullptr;
+    block.data.outputParameterChanges = nullptr;
+    fillInput(block);
+    processor->process(block.data);
+    for (int32 i = 1; i < kBlockSize; ++i)
+        EXPECT_NEAR(block.outL[i], block.inL[i - 1] * dbToLinear(-6.0f), 1.0e-3f);
+}
+
+TEST_F(AudioProcessingTest, Morph_InterpolatesDelay) {
+    // B: Left Delay 10 ms (480 samples), A: no delay
+    TestParameterChanges setB;
+    setB.add(kParamLeftDelay, delayMsToNormalized(10.0f));
+    applyAndSettle(setB);
+    TestParameterChanges capture;
+    capture.add(kParamCaptureB, 1.0);
+    applyAndSettle(capture);
+    TestParameterChanges setA;
+    setA.add(kParamLeftDelay, delayMsToNormalized(0.0f));
+    setA.add(kParamMorph, 0.5);
+    applyAndSettle(setA);
+
+    // Impulse at the first sample of a block: halfway delay is 240 samples
+    StereoBlock block(kBlockSize);
+    block.inL[0] = 1.0f;
+    processor->process(block.data);
+
+    int32 peak = static_cast<int32>(std::max_element(block.outL.begin(), block.outL.end()) - block.outL.begin());
+    EXPECT_EQ(peak, 240);
+    EXPECT_NEAR(block.outL[peak], 1.0f, 1.0e-6f);
+}
+
+TEST_F(AudioProcessingTest, Morph_SnapshotBSurvivesStateRoundTrip) {
+    TestParameterChanges setB;
+    setB.add(kParamMasterGain, dbToNormalized(-6.0f));
+    setB.add(kParamCaptureB, 1.0);
+    applyAndSettle(setB);
+
+    MemoryStream stream;
+    ASSERT_EQ(processor->getState(&stream), kResultOk);
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState saved = {};
+    ASSERT_TRUE(StateSerializer::read(&stream, saved));
+    EXPECT_EQ(saved.values[kStateSnapshotB + kParamMasterGain], static_cast<double>(dbToNormalized(-6.0f)));
+
+    // A fresh instance recalls B: full morph reproduces it
+    SimplePannerProcessor* other = new SimplePannerProcessor();
+    other->initialize(nullptr);
+    ProcessSetup setup;
+    setup.processMode = kRealtime;
+    setup.symbolicSampleSize = kSample32;
+    setup.maxSamplesPerBlock = kBlockSize;
+    setup.sampleRate = kSampleRate;
+    other->setupProcessing(setup);
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    ASSERT_EQ(other->setState(&stream), kResultOk);
+    other->setActive(true);
+
+    TestParameterChanges reset;
+    reset.add(kParamMasterGain, dbToNormalized(0.0f));
+    reset.add(kParamMorph, 1.0);
+    StereoBlock block(kBlockSize);
+    block.data.inputParameterChanges = &reset;
+    other->process(block.data);
+    block.data.inputParameterChanges = nullptr;
+    for (int i = 0; i < 40; ++i)
+        other->process(block.data);
+
+    fillInput(block);
+    other->process(block.data);
+    for (int32 i = 1; i < kBlockSize; ++i)
+        EXPECT_NEAR(block.outL[i], block.inL[i - 1] * dbToLinear(-6.0f), 1.0e-3f);
+
+    other->setActive(false);
+    other->terminate();
+    other->release();
+}
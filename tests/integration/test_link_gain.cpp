@@ -0,0 +1,266 @@
+// test_link_gain.cpp
+// Integration tests for Link L/R Gain resolved inside SimplePannerProcessor::process()
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "parameter_utils.h"
+#include "state_serializer.h"
+#include "process_test_helpers.h"
+#include "public.sdk/source/common/memorystream.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+class LinkGainTest : public ::testing::Test {
+protected:
+    static constexpr int32 kBlockSize = 256;
+    static constexpr double kSampleRate = 48000.0;
+
+    void SetUp() override {
+        processor = new SimplePannerProcessor();
+        processor->initialize(nullptr);
+
+        ProcessSetup setup;
+        setup.processMode = kRealtime;
+        setup.symbolicSampleSize = kSample32;
+        setup.maxSamplesPerBlock = kBlockSize;
+        setup.sampleRate = kSampleRate;
+        processor->setupProcessing(setup);
+        processor->setActive(true);
+    }
+
+    void TearDown() override {
+        processor->setActive(false);
+        processor->terminate();
+        processor->release();
+    }
+
+    // Process one block with parameter changes, collecting the reported changes
+    void applyAndSettle(TestParameterChanges& changes, TestParameterChanges* reported = nullptr) {
+        StereoBlock block(kBlockSize);
+        block.data.inputParameterChanges = &changes;
+        block.data.outputParameterChanges = reported;
+        processor->process(block.data);
+        block.data.inputParameterChanges = nullptr;
+        block.data.outputParameterChanges = nullptr;
+        for (int i = 0; i < 40; ++i)
+            processor->process(block.data);
+    }
+
+    // Settled per-channel gain measured with a constant input of 1.0
+    void measureGains(float& leftGain, float& rightGain) {
+        StereoBlock block(kBlockSize);
+        std::fill(block.inL.begin(), block.inL.end(), 1.0f);
+        std::fill(block.inR.begin(), block.inR.end(), 1.0f);
+        processor->process(block.data);
+        processor->process(block.data);
+        leftGain = block.outL[kBlockSize - 1];
+        rightGain = block.outR[kBlockSize - 1];
+    }
+
+    // Pan both channels hard to their own side so outputs measure the channel gains
+    void panHard() {
+        TestParameterChanges pan;
+        pan.add(kParamLeftPan, panToNormalized(-100.0f));
+        pan.add(kParamRightPan, panToNormalized(100.0f));
+        applyAndSettle(pan);
+    }
+
+    void enableLink() {
+        TestParameterChanges link;
+        link.add(kParamLinkGain, 1.0);
+        applyAndSettle(link);
+    }
+
+    SimplePannerProcessor* processor = nullptr;
+};
+
+//------------------------------------------------------------------------------
+// Linked automation
+//------------------------------------------------------------------------------
+
+TEST_F(LinkGainTest, Linked_AutomatingLeftGainDrivesBothChannels) {
+    panHard();
+    enableLink();
+
+    TestParameterChanges changes;
+    TestParameterChanges reported;
+    changes.add(kParamLeftGain, dbToNormalized(-6.0f), 10);
+    applyAndSettle(changes, &reported);
+
+    float leftGain = 0.0f;
+    float rightGain = 0.0f;
+    measureGains(leftGain, rightGain);
+    EXPECT_NEAR(leftGain, dbToLinear(-6.0f), 1.0e-3f);
+    EXPECT_NEAR(rightGain, dbToLinear(-6.0f), 1.0e-3f);
+
+    // Only the mirrored gain is reported back, at the source's sample offset
+    ASSERT_EQ(reported.getParameterCount(), 1);
+    IParamValueQueue* queue = reported.getParameterData(0);
+    EXPECT_EQ(queue->getParameterId(), static_cast<ParamID>(kParamRightGain));
+    int32 sampleOffset = -1;
+    ParamValue value = 0.0;
+    ASSERT_EQ(queue->getPoint(0, sampleOffset, value), kResultTrue);
+    EXPECT_EQ(sampleOffset, 10);
+    EXPECT_EQ(value, static_cast<ParamValue>(dbToNormalized(-6.0f)));
+
+    PluginState snapshot = processor->getParameterSnapshot();
+    EXPECT_EQ(snapshot.values[kParamRightGain], snapshot.values[kParamLeftGain]);
+}
+
+TEST_F(LinkGainTest, Linked_AutomatingRightGainReportsLeftGain) {
+    panHard();
+    enableLink();
+
+    TestParameterChanges changes;
+    TestParameterChanges reported;
+    changes.add(kParamRightGain, dbToNormalized(3.0f));
+    applyAndSettle(changes, &reported);
+
+    float leftGain = 0.0f;
+    float rightGain = 0.0f;
+    measureGains(leftGain, rightGain);
+    EXPECT_NEAR(leftGain, dbToLinear(3.0f), 1.0e-3f);
+    EXPECT_NEAR(rightGain, dbToLinear(3.0f), 1.0e-3f);
+
+    EXPECT_EQ(reported.lastValue(kParamLeftGain), static_cast<ParamValue>(dbToNormalized(3.0f)));
+    EXPECT_EQ(reported.lastValue(kParamRightGain), -1.0);
+}
+
+TEST_F(LinkGainTest, Linked_BothGainsChanged_LeftGainWins) {
+    panHard();
+    enableLink();
+
+    TestParameterChanges changes;
+    TestParameterChanges reported;
+    changes.add(kParamRightGain, dbToNormalized(3.0f));
+    changes.add(kParamLeftGain, dbToNormalized(-9.0f));
+    applyAndSettle(changes, &reported);
+
+    float leftGain = 0.0f;
+    float rightGain = 0.0f;
+    measureGains(leftGain, rightGain);
+    EXPECT_NEAR(leftGain, dbToLinear(-9.0f), 1.0e-3f);
+    EXPECT_NEAR(rightGain, dbToLinear(-9.0f), 1.0e-3f);
+
+    // The host's Right Gain value was overridden, so it is corrected
+    EXPECT_EQ(reported.lastValue(kParamRightGain), static_cast<ParamValue>(dbToNormalized(-9.0f)));
+    EXPECT_EQ(reported.lastValue(kParamLeftGain), -1.0);
+}
+
+TEST_F(LinkGainTest, LinkAndGainInSameBlock_GainIsLinked) {
+    panHard();
+
+    // Queue order must not matter: the gain precedes the link switch
+    TestParameterChanges changes;
+    TestParameterChanges reported;
+    changes.add(kParamLeftGain, dbToNormalized(-4.0f));
+    changes.add(kParamLinkGain, 1.0);
+    applyAndSettle(changes, &reported);
+
+    float leftGain = 0.0f;
+    float rightGain = 0.0f;
+    measureGains(leftGain, rightGain);
+    EXPECT_NEAR(leftGain, dbToLinear(-4.0f), 1.0e-3f);
+    EXPECT_NEAR(rightGain, dbToLinear(-4.0f), 1.0e-3f);
+    EXPECT_EQ(reported.lastValue(kParamRightGain), static_cast<ParamValue>(dbToNormalized(-4.0f)));
+}
+
+//------------------------------------------------------------------------------
+// Engaging and releasing the link
+//------------------------------------------------------------------------------
+
+TEST_F(LinkGainTest, EnablingLink_RightGainGlidesToLeftGain) {
+    panHard();
+    TestParameterChanges gains;
+    gains.add(kParamLeftGain, dbToNormalized(0.0f));
+    gains.add(kParamRightGain, dbToNormalized(-20.0f));
+    applyAndSettle(gains);
+
+    TestParameterChanges link;
+    link.add(kParamLinkGain, 1.0);
+    TestParameterChanges reported;
+    StereoBlock block(kBlockSize);
+    std::fill(block.inL.begin(), block.inL.end(), 1.0f);
+    std::fill(block.inR.begin(), block.inR.end(), 1.0f);
+    block.data.inputParameterChanges = &link;
+    block.data.outputParameterChanges = &reported;
+    processor->process(block.data);
+
+    // Right Gain is smoothed towards Left Gain instead of jumping
+    EXPECT_NEAR(block.outR[1], dbToLinear(-20.0f), 1.0e-2f);
+    for (int32 i = 2; i < kBlockSize; ++i)
+        EXPECT_LT(std::abs(block.outR[i] - block.outR[i - 1]), 1.0e-2f) << "sample " << i;
+    EXPECT_EQ(reported.lastValue(kParamRightGain), static_cast<ParamValue>(dbToNormalized(0.0f)));
+
+    block.data.inputParameterChanges = nullptr;
+    block.data.outputParameterChanges = nullptr;
+    for (int i = 0; i < 40; ++i)
+        processor->process(block.data);
+
+    float leftGain = 0.0f;
+    float rightGain = 0.0f;
+    measureGains(leftGain, rightGain);
+    EXPECT_NEAR(leftGain, 1.0f, 1.0e-3f);
+    EXPECT_NEAR(rightGain, 1.0f, 1.0e-3f);
+}
+
+TEST_F(LinkGainTest, DisablingLink_GainsBecomeIndependent) {
+    panHard();
+    enableLink();
+    TestParameterChanges linked;
+    linked.add(kParamLeftGain, dbToNormalized(-6.0f));
+    applyAndSettle(linked);
+
+    TestParameterChanges unlink;
+    TestParameterChanges reported;
+    unlink.add(kParamLinkGain, 0.0);
+    unlink.add(kParamRightGain, dbToNormalized(0.0f));
+    applyAndSettle(unlink, &reported);
+
+    float leftGain = 0.0f;
+    float rightGain = 0.0f;
+    measureGains(leftGain, rightGain);
+    EXPECT_NEAR(leftGain, dbToLinear(-6.0f), 1.0e-3f);
+    EXPECT_NEAR(rightGain, 1.0f, 1.0e-3f);
+    EXPECT_EQ(reported.getParameterCount(), 0);
+}
+
+TEST_F(LinkGainTest, Unlinked_GainChangesAreNotReported) {
+    TestParameterChanges changes;
+    TestParameterChanges reported;
+    changes.add(kParamLeftGain, dbToNormalized(-6.0f));
+    applyAndSettle(changes, &reported);
+
+    EXPECT_EQ(reported.getParameterCount(), 0);
+    PluginState snapshot = processor->getParameterSnapshot();
+    EXPECT_EQ(snapshot.values[kParamRightGain], static_cast<double>(dbToNormalized(ParamDefault::kRightGain)));
+}
+
+TEST_F(LinkGainTest, LinkedState_RightGainFollowsLeftGain) {
+    PluginState state = PluginState::defaults();
+    state.values[kParamLeftGain] = dbToNormalized(-12.0f);
+    state.values[kParamRightGain] = dbToNormalized(-3.0f);
+    state.values[kParamLinkGain] = 1.0;
+
+    MemoryStream stream;
+    ASSERT_TRUE(StateSerializer::write(&stream, state));
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    ASSERT_EQ(processor->setState(&stream), kResultOk);
+
+    panHard();
+    float leftGain = 0.0f;
+    float rightGain = 0.0f;
+    measureGains(leftGain, rightGain);
+    EXPECT_NEAR(leftGain, dbToLinear(-12.0f), 1.0e-3f);
+    EXPECT_NEAR(rightGain, dbToLinear(-12.0f), 1.0e-3f);
+}
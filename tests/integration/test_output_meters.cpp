@@ -0,0 +1,144 @@
+// test_output_meters.cpp
+// Integration tests for the peak / RMS output meters reported by SimplePannerProcessor::process()
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "parameter_utils.h"
+#include "process_test_helpers.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+class OutputMetersTest : public ::testing::Test {
+protected:
+    static constexpr int32 kBlockSize = 160;
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kBlocksPerReport = 10;   // 1600 samples = 1/30 s
+
+    void SetUp() override {
+        processor = new SimplePannerProcessor();
+        processor->initialize(nullptr);
+
+        ProcessSetup setup;
+        setup.processMode = kRealtime;
+        setup.symbolicSampleSize = kSample32;
+        setup.maxSamplesPerBlock = kBlockSize;
+        setup.sampleRate = kSampleRate;
+        processor->setupProcessing(setup);
+        processor->setActive(true);
+    }
+
+    void TearDown() override {
+        processor->setActive(false);
+        processor->terminate();
+        processor->release();
+    }
+
+    // Process blocks of constant input, collecting every reported change
+    void processConstant(int count, float left, float right, TestParameterChanges* reported) {
+        StereoBlock block(kBlockSize);
+        std::fill(block.inL.begin(), block.inL.end(), left);
+        std::fill(block.inR.begin(), block.inR.end(), right);
+        block.data.outputParameterChanges = reported;
+        for (int i = 0; i < count; ++i)
+            processor->process(block.data);
+    }
+
+    // Number of points reported for a parameter
+    static int32 pointCount(TestParameterChanges& changes, ParamID id) {
+        for (int32 i = 0; i < changes.getParameterCount(); ++i) {
+            IParamValueQueue* queue = changes.getParameterData(i);
+            if (queue->getParameterId() == id)
+                return queue->getPointCount();
+        }
+        return 0;
+    }
+
+    SimplePannerProcessor* processor = nullptr;
+};
+
+//------------------------------------------------------------------------------
+// Reporting
+//------------------------------------------------------------------------------
+
+TEST_F(OutputMetersTest, ReportsOncePerPeriodOfAudio) {
+    TestParameterChanges reported;
+    processConstant(kBlocksPerReport - 1, 0.5f, 0.25f, &reported);
+    EXPECT_EQ(reported.getParameterCount(), 0);
+
+    processConstant(1, 0.5f, 0.25f, &reported);
+    EXPECT_EQ(pointCount(reported, kParamPeakLeft), 1);
+    EXPECT_EQ(pointCount(reported, kParamPeakRight), 1);
+    EXPECT_EQ(pointCount(reported, kParamRmsLeft), 1);
+    EXPECT_EQ(pointCount(reported, kParamRmsRight), 1);
+
+    // Reported at the last sample of the block that completed the period
+    for (int32 i = 0; i < reported.getParameterCount(); ++i) {
+        int32 sampleOffset = -1;
+        ParamValue value = 0.0;
+        reported.getParameterData(i)->getPoint(0, sampleOffset, value);
+        EXPECT_EQ(sampleOffset, kBlockSize - 1);
+    }
+}
+
+TEST_F(OutputMetersTest, ConstantInput_PeakAndRmsMatchLevel) {
+    // Defaults: both channels hard panned to their own side at unity gain
+    TestParameterChanges reported;
+    processConstant(kBlocksPerReport, 0.5f, 0.25f, &reported);
+
+    EXPECT_NEAR(reported.lastValue(kParamPeakLeft), dbToNormalized(linearToDb(0.5f)), 1.0e-4);
+    EXPECT_NEAR(reported.lastValue(kParamRmsLeft), dbToNormalized(linearToDb(0.5f)), 1.0e-4);
+    EXPECT_NEAR(reported.lastValue(kParamPeakRight), dbToNormalized(linearToDb(0.25f)), 1.0e-4);
+    EXPECT_NEAR(reported.lastValue(kParamRmsRight), dbToNormalized(linearToDb(0.25f)), 1.0e-4);
+}
+
+TEST_F(OutputMetersTest, Silence_IsNotReported) {
+    // Meters start at -∞ (normalized 0), like the controller's parameters
+    TestParameterChanges reported;
+    processConstant(5 * kBlocksPerReport, 0.0f, 0.0f, &reported);
+    EXPECT_EQ(reported.getParameterCount(), 0);
+}
+
+TEST_F(OutputMetersTest, UnchangedLevels_AreReportedOnce) {
+    TestParameterChanges reported;
+    processConstant(3 * kBlocksPerReport, 0.5f, 0.5f, &reported);
+    EXPECT_EQ(pointCount(reported, kParamPeakLeft), 1);
+
+    // Falling back to silence is reported, then nothing more
+    processConstant(3 * kBlocksPerReport, 0.0f, 0.0f, &reported);
+    EXPECT_EQ(pointCount(reported, kParamPeakLeft), 2);
+    EXPECT_EQ(reported.lastValue(kParamPeakLeft), 0.0);
+}
+
+TEST_F(OutputMetersTest, WithoutOutputList_LevelsAreReportedLater) {
+    processConstant(kBlocksPerReport, 0.5f, 0.5f, nullptr);
+
+    TestParameterChanges reported;
+    processConstant(kBlocksPerReport, 0.5f, 0.5f, &reported);
+    EXPECT_EQ(pointCount(reported, kParamPeakLeft), 1);
+    EXPECT_NEAR(reported.lastValue(kParamPeakLeft), dbToNormalized(linearToDb(0.5f)), 1.0e-4);
+}
+
+TEST_F(OutputMetersTest, MetersFollowOutputNotInput) {
+    TestParameterChanges changes;
+    changes.add(kParamMasterGain, dbToNormalized(-12.0f));
+    StereoBlock block(kBlockSize);
+    block.data.inputParameterChanges = &changes;
+    processor->process(block.data);
+
+    // Let the master gain settle, then measure one full period
+    processConstant(4 * kBlocksPerReport, 1.0f, 1.0f, nullptr);
+    TestParameterChanges reported;
+    processConstant(kBlocksPerReport, 1.0f, 1.0f, &reported);
+    EXPECT_NEAR(reported.lastValue(kParamPeakLeft), dbToNormalized(-12.0f), 1.0e-3);
+    EXPECT_NEAR(reported.lastValue(kParamRmsRight), dbToNormalized(-12.0f), 1.0e-3);
+}
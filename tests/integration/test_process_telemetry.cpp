@@ -0,0 +1,234 @@
+// test_process_telemetry.cpp
+// Integration tests for process() timing telemetry of SimplePannerProcessor
+
+#include "pluginprocessor.h"
+#include "process_test_helpers.h"
+#include <gtest/gtest.h>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+class ProcessTelemetryTest : public ::testing::Test {
+protected:
+    static constexpr int32 kBlockSize = 480;         // 10 ms
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kBlocksPerPeriod = 25;      // 250 ms
+
+    void SetUp() override {
+        processor = new SimplePannerProcessor();
+        processor->initialize(&host);
+        processor->connect(&controller);
+
+        ProcessSetup setup;
+        setup.processMode = kRealtime;
+        setup.symbolicSampleSize = kSample32;
+        setup.maxSamplesPerBlock = kBlockSize;
+        setup.sampleRate = kSampleRate;
+        processor->setupProcessing(setup);
+        processor->setActive(true);
+    }
+
+    void TearDown() override {
+        processor->setActive(false);
+        processor->disconnect(&controller);
+        processor->terminate();
+        processor->release();
+    }
+
+    void processBlocks(int count) {
+        StereoBlock block(kBlockSize);
+        for (int i = 0; i < count; ++i)
+            processor->process(block.data);
+    }
+
+    // Poll like the editor does; the summaries the controller received
+    std::vector<ProcessTimingSummary> pollSummaries() {
+        pollTelemetry(processor);
+        std::vector<ProcessTimingSummary> summaries = controller.records<ProcessTimingSummary>(TimingMessage::kId);
+        controller.clear();
+        return summaries;
+    }
+
+    HostApplication host;
+    TestConnectionPoint controller;
+    SimplePannerProcessor* processor = nullptr;
+};
+
+//------------------------------------------------------------------------------
+// Measurement periods
+//------------------------------------------------------------------------------
+
+TEST_F(ProcessTelemetryTest, NoSummaryBeforeFirstPeriodCompletes) {
+    processBlocks(kBlocksPerPeriod - 1);
+
+    EXPECT_TRUE(pollSummaries().empty());
+}
+
+TEST_F(ProcessTelemetryTest, SummaryCoversOnePeriodOfBlocks) {
+    processBlocks(kBlocksPerPeriod);
+
+    std::vector<ProcessTimingSummary> summaries = pollSummaries();
+    ASSERT_EQ(summaries.size(), 1u);
+    const ProcessTimingSummary& summary = summaries[0];
+    EXPECT_EQ(summary.blocks, kBlocksPerPeriod);
+    EXPECT_GT(summary.maxMicros, 0.0);
+    EXPECT_LE(summary.minMicros, summary.meanMicros);
+    EXPECT_LE(summary.meanMicros, summary.maxMicros);
+    EXPECT_LE(summary.p99Micros, summary.maxMicros);
+    EXPECT_GT(summary.load, 0.0);
+
+    // Sent once; the next period starts empty
+    EXPECT_TRUE(pollSummaries().empty());
+}
+
+TEST_F(ProcessTelemetryTest, UnreadPeriodsAreQueuedInOrder) {
+    processBlocks(3 * kBlocksPerPeriod + 5);
+
+    std::vector<ProcessTimingSummary> summaries = pollSummaries();
+    ASSERT_EQ(summaries.size(), 3u);
+    for (const ProcessTimingSummary& summary : summaries)
+        EXPECT_EQ(summary.blocks, kBlocksPerPeriod);
+    EXPECT_TRUE(pollSummaries().empty());
+}
+
+TEST_F(ProcessTelemetryTest, FullQueueDropsNewPeriodsWithoutBlocking) {
+    processBlocks(static_cast<int>(TimingMessage::kMaxRecords + 4) * kBlocksPerPeriod);
+
+    EXPECT_EQ(pollSummaries().size(), TimingMessage::kMaxRecords);
+
+    // Draining makes room again
+    processBlocks(kBlocksPerPeriod);
+    EXPECT_EQ(pollSummaries().size(), 1u);
+}
+
+//------------------------------------------------------------------------------
+// Delivery to the controller
+//------------------------------------------------------------------------------
+
+TEST_F(ProcessTelemetryTest, Poll_SendsQueuedSummariesToController) {
+    processBlocks(2 * kBlocksPerPeriod);
+
+    pollTelemetry(processor);
+
+    // Both periods arrive in one message, oldest first
+    ASSERT_EQ(controller.count(TimingMessage::kId), 1u);
+    std::vector<ProcessTimingSummary> summaries = controller.records<ProcessTimingSummary>(TimingMessage::kId);
+    ASSERT_EQ(summaries.size(), 2u);
+    EXPECT_EQ(summaries[0].blocks, kBlocksPerPeriod);
+    EXPECT_EQ(summaries[1].blocks, kBlocksPerPeriod);
+    EXPECT_GT(summaries[1].maxMicros, 0.0);
+
+    // Nothing new: no message
+    pollTelemetry(processor);
+    EXPECT_EQ(controller.count(TimingMessage::kId), 1u);
+}
+
+TEST_F(ProcessTelemetryTest, Poll_NothingSentWithoutPoll) {
+    processBlocks(3 * kBlocksPerPeriod);
+
+    // Records wait for the controller; process() and setActive never send
+    processor->setActive(false);
+    processor->setActive(true);
+    EXPECT_EQ(controller.count(TimingMessage::kId), 0u);
+}
+
+TEST_F(ProcessTelemetryTest, Poll_OtherMessagesIgnored) {
+    processBlocks(kBlocksPerPeriod);
+
+    IPtr<IMessage> message = owned(static_cast<IMessage*>(new HostMessage));
+    message->setMessageID("SomethingElse");
+    EXPECT_NE(processor->notify(message), kResultOk);
+    EXPECT_EQ(controller.count(TimingMessage::kId), 0u);
+}
+
+TEST_F(ProcessTelemetryTest, Poll_WithoutHostMessagesSendsNothing) {
+    SimplePannerProcessor* standalone = new SimplePannerProcessor();
+    standalone->initialize(nullptr);
+    standalone->connect(&controller);
+    ProcessSetup setup = {kRealtime, kSample32, kBlockSize, kSampleRate};
+    standalone->setupProcessing(setup);
+    standalone->setActive(true);
+
+    StereoBlock block(kBlockSize);
+    for (int i = 0; i < kBlocksPerPeriod; ++i)
+        standalone->process(block.data);
+
+    // No host application: allocateMessage() fails and nothing is sent
+    pollTelemetry(standalone);
+    EXPECT_EQ(controller.count(TimingMessage::kId), 0u);
+
+    standalone->setActive(false);
+    standalone->disconnect(&controller);
+    standalone->terminate();
+    standalone->release();
+}
+
+//------------------------------------------------------------------------------
+// Deadline watchdog
+//------------------------------------------------------------------------------
+
+TEST_F(ProcessTelemetryTest, Deadline_CountersCoverBlocksSinceActivation) {
+    processBlocks(10);
+
+    DeadlineCounters counters = processor->getDeadlineCounters();
+    EXPECT_EQ(counters.blocks, 10);
+    EXPECT_GT(counters.worstUse, 0.0);
+    for (int32 level = 0; level < kDeadlineLevels; ++level)
+        EXPECT_EQ(counters.thresholds[level], kDefaultDeadlineThresholds[level]);
+
+    // Reactivation starts counting again
+    processor->setActive(false);
+    processor->setActive(true);
+    EXPECT_EQ(processor->getDeadlineCounters().blocks, 0);
+}
+
+TEST_F(ProcessTelemetryTest, Deadline_ThresholdsDecideWhatIsCounted) {
+    // 1 ps, 2 ps, 1000 deadlines: every block is over the first two only
+    const double kThresholds[kDeadlineLevels] = {1.0e-10, 2.0e-10, 1000.0};
+    processor->setActive(false);
+    processor->setDeadlineThresholds(kThresholds);
+    processor->setActive(true);
+
+    processBlocks(kBlocksPerPeriod);
+
+    DeadlineCounters counters = processor->getDeadlineCounters();
+    EXPECT_EQ(counters.exceeded[0], kBlocksPerPeriod);
+    EXPECT_EQ(counters.exceeded[1], kBlocksPerPeriod);
+    EXPECT_EQ(counters.exceeded[2], 0);
+
+    std::vector<ProcessTimingSummary> summaries = pollSummaries();
+    ASSERT_EQ(summaries.size(), 1u);
+    const ProcessTimingSummary& summary = summaries[0];
+    EXPECT_EQ(summary.deadlineExceeded[0], kBlocksPerPeriod);
+    EXPECT_EQ(summary.deadlineExceeded[2], 0);
+    EXPECT_GT(summary.maxDeadlineUse, 0.0);
+    EXPECT_LE(summary.maxDeadlineUse, counters.worstUse);
+}
+
+TEST_F(ProcessTelemetryTest, Deadline_SummaryCountsAreTotals) {
+    const double kThresholds[kDeadlineLevels] = {1.0e-10, 1000.0, 2000.0};
+    processor->setActive(false);
+    processor->setDeadlineThresholds(kThresholds);
+    processor->setActive(true);
+
+    processBlocks(2 * kBlocksPerPeriod);
+
+    std::vector<ProcessTimingSummary> summaries = pollSummaries();
+    ASSERT_EQ(summaries.size(), 2u);
+    EXPECT_EQ(summaries[0].deadlineExceeded[0], kBlocksPerPeriod);
+    EXPECT_EQ(summaries[1].deadlineExceeded[0], 2 * kBlocksPerPeriod);
+}
+
+TEST_F(ProcessTelemetryTest, Deadline_BlocksWithoutAudioAreNotCounted) {
+    StereoBlock block(kBlockSize);
+    block.data.numSamples = 0;
+    processor->process(block.data);
+
+    EXPECT_EQ(processor->getDeadlineCounters().blocks, 0);
+}
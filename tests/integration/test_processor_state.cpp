@@ -3,6 +3,8 @@
 
 #include "pluginprocessor.h"
 #include "plugids.h"
+#include "parameter_utils.h"
+#include "state_serializer.h"
 #include <gtest/gtest.h>
 #include "pluginterfaces/vst/ivstaudioprocessor.h"
 #include "pluginterfaces/vst/ivstcomponent.h"
@@ -170,6 +172,89 @@ TEST_F(ProcessorStateTest, SetState_WithDefaultValues_Succeeds) {
     processor->terminate();
 }
 
+TEST_F(ProcessorStateTest, SetState_WithoutPanLaw_UsesDefaultPanLaw) {
+    processor->initialize(nullptr);
+
+    // State saved before the pan law parameter existed: 8 values only
+    MemoryStream stream;
+    IBStreamer streamer(&stream, kLittleEndian);
+    streamer.writeInt32(1);
+    for (int i = 0; i < 8; ++i)
+        streamer.writeDouble(0.5);
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    EXPECT_EQ(processor->setState(&stream), kResultOk);
+
+    MemoryStream saved;
+    processor->getState(&saved);
+    saved.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState savedState = {};
+    EXPECT_TRUE(StateSerializer::read(&saved, savedState));
+    EXPECT_EQ(normalizedToPanLaw(savedState.values[kParamPanLaw]), ParamDefault::kPanLaw);
+
+    processor->terminate();
+}
+
+TEST_F(ProcessorStateTest, SetState_PanLaw_RoundTrip) {
+    processor->initialize(nullptr);
+
+    // The pan law is only stored by v2; v1 always holds 8 values
+    PluginState written = PluginState::defaults();
+    written.values[kParamPanLaw] = panLawToNormalized(kPanLawLinear);
+
+    MemoryStream stream;
+    ASSERT_TRUE(StateSerializer::write(&stream, written));
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    EXPECT_EQ(processor->setState(&stream), kResultOk);
+
+    MemoryStream saved;
+    processor->getState(&saved);
+    saved.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState savedState = {};
+    EXPECT_TRUE(StateSerializer::read(&saved, savedState));
+    EXPECT_EQ(normalizedToPanLaw(savedState.values[kParamPanLaw]), kPanLawLinear);
+
+    processor->terminate();
+}
+
+TEST_F(ProcessorStateTest, GetState_WritesVersion2) {
+    processor->initialize(nullptr);
+
+    MemoryStream stream;
+    processor->getState(&stream);
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    IBStreamer reader(&stream, kLittleEndian);
+    int32 version = 0;
+    EXPECT_TRUE(reader.readInt32(version));
+    EXPECT_EQ(version, StateSerializer::kVersion2);
+
+    processor->terminate();
+}
+
+TEST_F(ProcessorStateTest, SetState_Version2_RoundTrip) {
+    processor->initialize(nullptr);
+
+    PluginState written = PluginState::defaults();
+    for (int32 i = 0; i < StateSerializer::kNumFields; ++i)
+        written.values[i] = 0.1 * (i + 1);
+
+    MemoryStream stream;
+    ASSERT_TRUE(StateSerializer::write(&stream, written));
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    EXPECT_EQ(processor->setState(&stream), kResultOk);
+
+    MemoryStream saved;
+    processor->getState(&saved);
+    saved.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState savedState = {};
+    ASSERT_TRUE(StateSerializer::read(&saved, savedState));
+    for (int32 i = 0; i < StateSerializer::kNumFields; ++i)
+        EXPECT_EQ(savedState.values[i], written.values[i]) << "field " << i;
+
+    processor->terminate();
+}
+
 TEST_F(ProcessorStateTest, SetState_WithCustomValues_Succeeds) {
     processor->initialize(nullptr);
 
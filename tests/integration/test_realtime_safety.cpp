@@ -0,0 +1,276 @@
+// test_realtime_safety.cpp
+// Drives full processing sessions with the real-time check enabled: any
+// allocation, lock or blocking system call inside process() fails the test
+// (built only with SIMPLEPANNER_REALTIME_CHECK, see source/realtime_check.cpp)
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "parameter_utils.h"
+#include "realtime_check.h"
+#include "process_test_helpers.h"
+#include <gtest/gtest.h>
+#include "public.sdk/source/common/memorystream.h"
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include <sched.h>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Output parameter list with preallocated storage, as a real-time host has
+// (TestParameterChanges grows vectors, which would count as violations)
+//------------------------------------------------------------------------------
+class FixedParamValueQueue : public IParamValueQueue {
+public:
+    static constexpr int32 kMaxPoints = 64;
+
+    ParamID PLUGIN_API getParameterId() override { return mId; }
+    int32 PLUGIN_API getPointCount() override { return mNumPoints; }
+
+    tresult PLUGIN_API getPoint(int32 index, int32& sampleOffset, ParamValue& value) override {
+        if (index < 0 || index >= mNumPoints)
+            return kResultFalse;
+        sampleOffset = mOffsets[index];
+        value = mValues[index];
+        return kResultTrue;
+    }
+
+    tresult PLUGIN_API addPoint(int32 sampleOffset, ParamValue value, int32& index) override {
+        if (mNumPoints == kMaxPoints)
+            return kResultFalse;
+        mOffsets[mNumPoints] = sampleOffset;
+        mValues[mNumPoints] = value;
+        index = mNumPoints++;
+        return kResultTrue;
+    }
+
+    tresult PLUGIN_API queryInterface(const TUID, void** obj) override {
+        *obj = nullptr;
+        return kNoInterface;
+    }
+    uint32 PLUGIN_API addRef() override { return 1; }
+    uint32 PLUGIN_API release() override { return 1; }
+
+    ParamID mId = 0;
+    int32 mNumPoints = 0;
+    int32 mOffsets[kMaxPoints];
+    ParamValue mValues[kMaxPoints];
+};
+
+class FixedParameterChanges : public IParameterChanges {
+public:
+    static constexpr int32 kMaxQueues = 16;
+
+    int32 PLUGIN_API getParameterCount() override { return mNumQueues; }
+
+    IParamValueQueue* PLUGIN_API getParameterData(int32 index) override {
+        if (index < 0 || index >= mNumQueues)
+            return nullptr;
+        return &mQueues[index];
+    }
+
+    IParamValueQueue* PLUGIN_API addParameterData(const ParamID& id, int32& index) override {
+        for (int32 i = 0; i < mNumQueues; ++i) {
+            if (mQueues[i].mId == id) {
+                index = i;
+                return &mQueues[i];
+            }
+        }
+        if (mNumQueues == kMaxQueues)
+            return nullptr;
+        mQueues[mNumQueues].mId = id;
+        mQueues[mNumQueues].mNumPoints = 0;
+        index = mNumQueues++;
+        return &mQueues[index];
+    }
+
+    void clear() { mNumQueues = 0; }
+
+    tresult PLUGIN_API queryInterface(const TUID, void** obj) override {
+        *obj = nullptr;
+        return kNoInterface;
+    }
+    uint32 PLUGIN_API addRef() override { return 1; }
+    uint32 PLUGIN_API release() override { return 1; }
+
+private:
+    int32 mNumQueues = 0;
+    FixedParamValueQueue mQueues[kMaxQueues];
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+class RealtimeSafetyTest : public ::testing::Test {
+protected:
+    static constexpr int32 kBlockSize = 256;
+
+    void SetUp() override {
+        processor = new SimplePannerProcessor();
+        processor->initialize(nullptr);
+        setup(48000.0);
+        processor->setActive(true);
+        RealtimeCheck::resetViolations();
+    }
+
+    void TearDown() override {
+        processor->setActive(false);
+        processor->terminate();
+        processor->release();
+    }
+
+    void setup(double sampleRate) {
+        ProcessSetup setup;
+        setup.processMode = kRealtime;
+        setup.symbolicSampleSize = kSample32;
+        setup.maxSamplesPerBlock = kBlockSize;
+        setup.sampleRate = sampleRate;
+        processor->setupProcessing(setup);
+    }
+
+    // Process blocks of a stereo test signal; the input list (filled by the
+    // caller before the first block) is delivered with the first block only
+    void processBlocks(int count, TestParameterChanges* inputChanges = nullptr) {
+        for (int b = 0; b < count; ++b) {
+            for (int32 i = 0; i < kBlockSize; ++i) {
+                float phase = 0.03f * static_cast<float>(mPosition + i);
+                block.inL[i] = 0.5f * std::sin(phase);
+                block.inR[i] = 0.5f * std::cos(1.7f * phase);
+            }
+            mPosition += kBlockSize;
+
+            outputChanges.clear();
+            block.data.inputParameterChanges = (b == 0) ? inputChanges : nullptr;
+            block.data.outputParameterChanges = &outputChanges;
+            processor->process(block.data);
+        }
+    }
+
+    void expectNoViolations() {
+        const char* first = RealtimeCheck::firstViolation();
+        EXPECT_EQ(RealtimeCheck::violationCount(), 0u)
+            << "first violation in process(): " << (first ? first : "?");
+    }
+
+    SimplePannerProcessor* processor = nullptr;
+    StereoBlock block{kBlockSize};
+    FixedParameterChanges outputChanges;
+    int64 mPosition = 0;
+};
+
+//------------------------------------------------------------------------------
+// The checker itself
+//------------------------------------------------------------------------------
+
+TEST_F(RealtimeSafetyTest, Checker_DetectsAllocationLockAndSyscall) {
+    {
+        RealtimeCheck::RealtimeScope scope;
+        void* volatile memory = std::malloc(64);
+        std::free(memory);
+    }
+    EXPECT_EQ(RealtimeCheck::violationCount(), 2u);
+    ASSERT_NE(RealtimeCheck::firstViolation(), nullptr);
+    EXPECT_STREQ(RealtimeCheck::firstViolation(), "malloc");
+
+    RealtimeCheck::resetViolations();
+    {
+        std::mutex mutex;
+        RealtimeCheck::RealtimeScope scope;
+        mutex.lock();
+        mutex.unlock();
+    }
+    EXPECT_EQ(RealtimeCheck::violationCount(), 1u);
+    EXPECT_STREQ(RealtimeCheck::firstViolation(), "pthread_mutex_lock");
+
+    RealtimeCheck::resetViolations();
+    {
+        RealtimeCheck::RealtimeScope scope;
+        sched_yield();
+    }
+    EXPECT_EQ(RealtimeCheck::violationCount(), 1u);
+    EXPECT_STREQ(RealtimeCheck::firstViolation(), "sched_yield");
+}
+
+TEST_F(RealtimeSafetyTest, Checker_IgnoresCallsOutsideScope) {
+    void* volatile memory = std::malloc(64);
+    std::free(memory);
+    { RealtimeCheck::RealtimeScope scope; }
+    sched_yield();
+    EXPECT_EQ(RealtimeCheck::violationCount(), 0u);
+}
+
+//------------------------------------------------------------------------------
+// Processing sessions
+//------------------------------------------------------------------------------
+
+TEST_F(RealtimeSafetyTest, Session_SteadyStateAndAutomation) {
+    // Plain processing past several meter, scope and timing periods
+    processBlocks(200);
+
+    // Every parameter automated, several points per queue
+    TestParameterChanges changes;
+    for (ParamID id = 0; id < kParamCount; ++id) {
+        changes.add(id, 0.2, 0);
+        changes.add(id, 0.8, kBlockSize / 2);
+    }
+    changes.add(kParamCaptureB, 1.0, 10);
+    changes.add(kParamProgram, 0.0, 20);
+    processBlocks(50, &changes);
+
+    // Link L/R Gain on, with gain changes resolved and reported back
+    TestParameterChanges link;
+    link.add(kParamLinkGain, 1.0);
+    link.add(kParamLeftGain, dbToNormalized(-6.0f), 5);
+    processBlocks(50, &link);
+
+    // Host flush: no audio
+    block.data.numSamples = 0;
+    processor->process(block.data);
+    block.data.numSamples = kBlockSize;
+
+    expectNoViolations();
+}
+
+TEST_F(RealtimeSafetyTest, Session_StateRecallAndTelemetryBetweenBlocks) {
+    processBlocks(20);
+
+    // Main thread work between blocks is outside process() and not checked
+    MemoryStream saved;
+    ASSERT_EQ(processor->getState(&saved), kResultOk);
+    saved.seek(0, IBStream::kIBSeekSet, nullptr);
+    ASSERT_EQ(processor->setState(&saved), kResultOk);
+    pollTelemetry(processor);
+
+    // The recalled state is applied inside process()
+    processBlocks(100);
+    pollTelemetry(processor);
+    processBlocks(100);
+
+    expectNoViolations();
+}
+
+TEST_F(RealtimeSafetyTest, Session_RestartAtAnotherSampleRate) {
+    processBlocks(50);
+
+    // Buffers are resized while inactive, never inside process()
+    processor->setActive(false);
+    setup(96000.0);
+    processor->setActive(true);
+    RealtimeCheck::resetViolations();
+
+    TestParameterChanges delays;
+    delays.add(kParamLeftDelay, 1.0);
+    delays.add(kParamRightDelay, 0.5);
+    processBlocks(400, &delays);
+
+    expectNoViolations();
+}
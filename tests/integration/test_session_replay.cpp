@@ -0,0 +1,357 @@
+// test_session_replay.cpp
+// Integration test for session capture in SimplePannerProcessor and its
+// replay into a fresh processor
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "process_test_helpers.h"
+#include "session_replay.h"
+#include "public.sdk/source/common/memorystream.h"
+#include "test_file_helpers.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+namespace {
+
+void setState(SimplePannerProcessor* processor, const PluginState& state) {
+    uint8 chunk[StateSerializer::kMaxChunkSize];
+    size_t size = StateSerializer::encode(state, chunk);
+    MemoryStream stream;
+    int32 numWritten = 0;
+    stream.write(chunk, static_cast<int32>(size), &numWritten);
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    processor->setState(&stream);
+}
+
+// Output samples of every block, in order
+using Outputs = std::vector<std::vector<float>>;
+
+// Two-preset bank; preset 1 pans both channels to the centre at half gain
+std::string writeBank(const char* fileName, double gain) {
+    PresetBankEntry first = {"First", PluginState::defaults()};
+    PresetBankEntry second = {"Second", PluginState::defaults()};
+    second.state.values[kParamLeftPan] = 0.5;
+    second.state.values[kParamRightPan] = 0.5;
+    second.state.values[kParamMasterGain] = gain;
+    std::vector<uint8> data = PresetBank::build({first, second});
+
+    std::string bankPath = ::testing::TempDir() + fileName;
+    std::ofstream file(bankPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return bankPath;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+class SessionReplayTest : public ::testing::Test {
+protected:
+    static constexpr int32 kMaxBlockSize = 256;
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    void start(SimplePannerProcessor* processor, double sampleRate) {
+        ProcessSetup setup;
+        setup.processMode = kRealtime;
+        setup.symbolicSampleSize = kSample32;
+        setup.maxSamplesPerBlock = kMaxBlockSize;
+        setup.sampleRate = sampleRate;
+        processor->setupProcessing(setup);
+        processor->setActive(true);
+    }
+
+    void process(SimplePannerProcessor* processor, int32 numSamples, IParameterChanges* changes = nullptr) {
+        for (int32 i = 0; i < numSamples; ++i) {
+            block.inL[i] = std::sin(0.05f * static_cast<float>(phase + i));
+            block.inR[i] = 0.5f * std::cos(0.03f * static_cast<float>(phase + i));
+        }
+        phase += numSamples;
+        block.data.numSamples = numSamples;
+        block.data.inputParameterChanges = changes;
+        processor->process(block.data);
+        outputs.push_back(std::vector<float>(block.outL.begin(), block.outL.begin() + numSamples));
+        outputs.push_back(std::vector<float>(block.outR.begin(), block.outR.begin() + numSamples));
+    }
+
+    // A session with automation, a program change, a state recalled while
+    // processing and a second activation at another sample rate
+    void captureSession(bool withAudio, const char* bankPath = nullptr) {
+        SimplePannerProcessor* processor = new SimplePannerProcessor();
+        processor->initialize(nullptr);
+        if (bankPath) {
+            ASSERT_TRUE(processor->loadPresetTable(bankPath));
+        }
+        ASSERT_TRUE(processor->startCapture(path.c_str(), withAudio));
+
+        start(processor, 48000.0);
+        process(processor, 256);
+
+        TestParameterChanges changes;
+        changes.add(kParamLeftPan, 0.1, 0);
+        changes.add(kParamLeftPan, 0.9, 200);
+        changes.add(kParamMasterGain, 0.4, 64);
+        changes.add(kParamLeftDelay, 0.3, 0);
+        process(processor, 256, &changes);
+        process(processor, 100);
+
+        changes.clear();
+        changes.add(kParamProgram, 1.0, 0);
+        process(processor, 256, &changes);
+
+        PluginState recalled = PluginState::defaults();
+        recalled.values[kParamRightPan] = 0.2;
+        recalled.values[kParamRightGain] = 0.6;
+        setState(processor, recalled);
+        process(processor, 256);
+        processor->setActive(false);
+
+        recalled.values[kParamLeftGain] = 0.7;
+        setState(processor, recalled);
+        start(processor, 96000.0);
+        process(processor, 0);
+        process(processor, 256);
+        processor->setActive(false);
+
+        processor->terminate();
+        processor->release();
+    }
+
+    // Replays the capture into a fresh processor and keeps its outputs
+    bool replay(ReplayStats& stats, Outputs& replayed, int64 maxBlocks = -1, const char* bankPath = nullptr) {
+        SessionReplay session;
+        if (!session.open(path.c_str()))
+            return false;
+
+        SimplePannerProcessor* processor = new SimplePannerProcessor();
+        processor->initialize(nullptr);
+        if (bankPath)
+            processor->loadPresetTable(bankPath);
+        bool ok = session.run(*processor, stats, maxBlocks, [&replayed](int64, ProcessData& data) {
+            for (int32 c = 0; c < data.outputs[0].numChannels; ++c) {
+                const float* samples = data.outputs[0].channelBuffers32[c];
+                replayed.push_back(std::vector<float>(samples, samples + data.numSamples));
+            }
+        });
+        processor->terminate();
+        processor->release();
+        return ok;
+    }
+
+    std::string path = ::testing::TempDir() + "session_replay.spcap";
+    StereoBlock block{kMaxBlockSize};
+    int32 phase = 0;
+    Outputs outputs;
+};
+
+//------------------------------------------------------------------------------
+// Replay
+//------------------------------------------------------------------------------
+
+TEST_F(SessionReplayTest, WithAudio_OutputBitIdentical) {
+    captureSession(true);
+
+    ReplayStats stats;
+    Outputs replayed;
+    ASSERT_TRUE(replay(stats, replayed));
+    EXPECT_EQ(stats.blocks, 7);
+    EXPECT_EQ(stats.samples, 256 * 5 + 100);
+    EXPECT_EQ(stats.setups, 3);  // startCapture() records the setup it starts from
+    EXPECT_EQ(stats.activations, 4);
+    EXPECT_GE(stats.states, 2);
+    EXPECT_EQ(stats.presetBanks, 1);
+    EXPECT_TRUE(stats.complete);
+    EXPECT_EQ(stats.droppedRecords, 0u);
+
+    ASSERT_EQ(replayed.size(), outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i)
+        EXPECT_EQ(replayed[i], outputs[i]) << "channel block " << i;
+}
+
+TEST_F(SessionReplayTest, WithoutAudio_SameBlocksOnSilence) {
+    captureSession(false);
+
+    SessionReplay session;
+    ASSERT_TRUE(session.open(path.c_str()));
+    EXPECT_FALSE(session.hasAudio());
+
+    ReplayStats stats;
+    Outputs replayed;
+    ASSERT_TRUE(replay(stats, replayed));
+    EXPECT_EQ(stats.blocks, 7);
+    ASSERT_EQ(replayed.size(), outputs.size());
+    for (size_t i = 0; i < replayed.size(); ++i)
+        EXPECT_EQ(replayed[i].size(), outputs[i].size());
+}
+
+TEST_F(SessionReplayTest, MaxBlocks_StopsEarlyAndDeactivates) {
+    captureSession(true);
+
+    ReplayStats stats;
+    Outputs replayed;
+    ASSERT_TRUE(replay(stats, replayed, 3));
+    EXPECT_EQ(stats.blocks, 3);
+    EXPECT_FALSE(stats.complete);
+    ASSERT_EQ(replayed.size(), 6u);
+    for (size_t i = 0; i < replayed.size(); ++i)
+        EXPECT_EQ(replayed[i], outputs[i]);
+}
+
+//------------------------------------------------------------------------------
+// Preset bank
+//------------------------------------------------------------------------------
+
+TEST_F(SessionReplayTest, PresetBank_NoneRecordedAsDefault) {
+    captureSession(true);
+
+    SessionReplay session;
+    ASSERT_TRUE(session.open(path.c_str()));
+    const ReplayPresetBank& bank = session.presetBank();
+    EXPECT_TRUE(bank.recorded);
+    EXPECT_TRUE(bank.path.empty());
+    EXPECT_EQ(bank.count, 1);
+    EXPECT_EQ(bank.checksum, PresetTable::defaults()->checksum());
+}
+
+TEST_F(SessionReplayTest, PresetBank_PathAndChecksumRecorded) {
+    std::string bankPath = writeBank("session_replay_bank.sppb", 0.5);
+    captureSession(true, bankPath.c_str());
+
+    SessionReplay session;
+    ASSERT_TRUE(session.open(path.c_str()));
+    const ReplayPresetBank& bank = session.presetBank();
+    ASSERT_TRUE(bank.recorded);
+    EXPECT_EQ(bank.path, bankPath);
+    EXPECT_EQ(bank.count, 2);
+    EXPECT_EQ(bank.numFields, StateSerializer::kNumParams);
+    EXPECT_EQ(bank.checksum, PresetTable::share(bankPath.c_str())->checksum());
+
+    // Replayed with the same bank: the program change recalls the same values
+    ReplayStats stats;
+    Outputs replayed;
+    ASSERT_TRUE(replay(stats, replayed, -1, bankPath.c_str()));
+    ASSERT_EQ(replayed.size(), outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i)
+        EXPECT_EQ(replayed[i], outputs[i]) << "channel block " << i;
+    std::remove(bankPath.c_str());
+}
+
+TEST_F(SessionReplayTest, PresetBank_OtherBankHasOtherChecksum) {
+    std::string bankPath = writeBank("session_replay_bank_a.sppb", 0.5);
+    captureSession(true, bankPath.c_str());
+    std::string otherPath = writeBank("session_replay_bank_b.sppb", 0.2);
+
+    SessionReplay session;
+    ASSERT_TRUE(session.open(path.c_str()));
+    EXPECT_NE(session.presetBank().checksum, PresetTable::share(otherPath.c_str())->checksum());
+
+    // What the replay tool warns about: the program change (fourth block)
+    // recalls other values
+    ReplayStats stats;
+    Outputs replayed;
+    ASSERT_TRUE(replay(stats, replayed, -1, otherPath.c_str()));
+    ASSERT_EQ(replayed.size(), outputs.size());
+    EXPECT_EQ(replayed[5], outputs[5]);
+    EXPECT_NE(replayed[7], outputs[7]);
+    std::remove(bankPath.c_str());
+    std::remove(otherPath.c_str());
+}
+
+//------------------------------------------------------------------------------
+// Damaged files
+//------------------------------------------------------------------------------
+
+TEST_F(SessionReplayTest, Truncated_RunFailsAfterLastWholeRecord) {
+    captureSession(true);
+
+    std::vector<char> bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GT(bytes.size(), 1000u);
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 1000));
+    }
+
+    SessionReplay session;
+    ASSERT_TRUE(session.open(path.c_str()));
+    SimplePannerProcessor* processor = new SimplePannerProcessor();
+    processor->initialize(nullptr);
+    ReplayStats stats;
+    EXPECT_FALSE(session.run(*processor, stats));
+    EXPECT_STREQ(session.error(), "truncated record");
+    EXPECT_GT(stats.blocks, 0);
+    EXPECT_FALSE(stats.complete);
+    processor->terminate();
+    processor->release();
+}
+
+TEST_F(SessionReplayTest, NotACapture_OpenFails) {
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "{\"blocks\": 10, \"samples\": 5120}";
+    }
+    SessionReplay session;
+    EXPECT_FALSE(session.open(path.c_str()));
+    EXPECT_STREQ(session.error(), "not a capture file");
+
+    EXPECT_FALSE(session.open((::testing::TempDir() + "missing.spcap").c_str()));
+    EXPECT_STREQ(session.error(), "cannot open the file");
+}
+
+//------------------------------------------------------------------------------
+// Capture from the environment
+//------------------------------------------------------------------------------
+
+TEST_F(SessionReplayTest, Environment_CapturesEachInstance) {
+    setEnvironment(PluginInfo::kCaptureDirEnv, ::testing::TempDir().c_str());
+    setEnvironment(PluginInfo::kCaptureAudioEnv, "1");
+    SimplePannerProcessor* processor = new SimplePannerProcessor();
+    processor->initialize(nullptr);
+    setEnvironment(PluginInfo::kCaptureDirEnv, "");
+
+    start(processor, 44100.0);
+    process(processor, 128);
+    processor->setActive(false);
+    processor->terminate();
+    processor->release();
+
+    // The newest capture file of this process is this instance's
+    std::string capture;
+    for (int32 instance = 1; instance < 1000; ++instance) {
+        std::string candidate = ::testing::TempDir() + "capture-" + std::to_string(currentProcessId()) + "-"
+                              + std::to_string(instance) + ".spcap";
+        if (fileExists(candidate))
+            capture = candidate;
+    }
+    ASSERT_FALSE(capture.empty());
+
+    SessionReplay session;
+    ASSERT_TRUE(session.open(capture.c_str()));
+    EXPECT_TRUE(session.hasAudio());
+    SimplePannerProcessor* replayed = new SimplePannerProcessor();
+    replayed->initialize(nullptr);
+    ReplayStats stats;
+    EXPECT_TRUE(session.run(*replayed, stats));
+    EXPECT_EQ(stats.blocks, 1);
+    EXPECT_EQ(stats.samples, 128);
+    EXPECT_TRUE(stats.complete);
+    replayed->terminate();
+    replayed->release();
+    std::remove(capture.c_str());
+}
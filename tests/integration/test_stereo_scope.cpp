@@ -0,0 +1,145 @@
+// test_stereo_scope.cpp
+// Integration tests for the stereo scope frames queued by SimplePannerProcessor::process()
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "parameter_utils.h"
+#include "process_test_helpers.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+class StereoScopeTest : public ::testing::Test {
+protected:
+    static constexpr int32 kBlockSize = 400;
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kBlocksPerFrame = 4;   // 1600 samples = 1/30 s
+
+    void SetUp() override {
+        processor = new SimplePannerProcessor();
+        processor->initialize(&host);
+        processor->connect(&controller);
+
+        ProcessSetup setup;
+        setup.processMode = kRealtime;
+        setup.symbolicSampleSize = kSample32;
+        setup.maxSamplesPerBlock = kBlockSize;
+        setup.sampleRate = kSampleRate;
+        processor->setupProcessing(setup);
+        processor->setActive(true);
+    }
+
+    void TearDown() override {
+        processor->setActive(false);
+        processor->disconnect(&controller);
+        processor->terminate();
+        processor->release();
+    }
+
+    // Process blocks of a sine on the left and a scaled copy on the right
+    void processSine(int count, float rightScale) {
+        StereoBlock block(kBlockSize);
+        for (int b = 0; b < count; ++b) {
+            for (int32 i = 0; i < kBlockSize; ++i) {
+                float sample = 0.5f * std::sin(0.05f * static_cast<float>(mPosition + i));
+                block.inL[i] = sample;
+                block.inR[i] = rightScale * sample;
+            }
+            mPosition += kBlockSize;
+            processor->process(block.data);
+        }
+    }
+
+    // Poll like the editor does; the frames the controller received
+    std::vector<ScopeFrame> pollFrames() {
+        pollTelemetry(processor);
+        std::vector<ScopeFrame> frames = controller.records<ScopeFrame>(ScopeMessage::kId);
+        controller.clear();
+        return frames;
+    }
+
+    HostApplication host;
+    TestConnectionPoint controller;
+    SimplePannerProcessor* processor = nullptr;
+    int64 mPosition = 0;
+};
+
+//------------------------------------------------------------------------------
+// Frames
+//------------------------------------------------------------------------------
+
+TEST_F(StereoScopeTest, NoFrameBeforeFirstFrameCompletes) {
+    processSine(kBlocksPerFrame - 1, 1.0f);
+
+    EXPECT_TRUE(pollFrames().empty());
+}
+
+TEST_F(StereoScopeTest, OneFramePerThirtiethOfASecond) {
+    processSine(3 * kBlocksPerFrame, 1.0f);
+
+    // All three frames arrive in one message
+    pollTelemetry(processor);
+    EXPECT_EQ(controller.count(ScopeMessage::kId), 1u);
+    std::vector<ScopeFrame> frames = controller.records<ScopeFrame>(ScopeMessage::kId);
+    controller.clear();
+    ASSERT_EQ(frames.size(), 3u);
+    for (const ScopeFrame& frame : frames) {
+        EXPECT_GT(frame.numPoints, 0);
+        EXPECT_LE(frame.numPoints, kScopePoints);
+    }
+
+    // Nothing new: no message
+    EXPECT_TRUE(pollFrames().empty());
+    EXPECT_EQ(controller.count(ScopeMessage::kId), 0u);
+}
+
+TEST_F(StereoScopeTest, MonoOutput_CorrelationIsPlusOne) {
+    // Defaults: hard L/R panning, so identical inputs give identical outputs
+    processSine(kBlocksPerFrame, 1.0f);
+
+    std::vector<ScopeFrame> frames = pollFrames();
+    ASSERT_EQ(frames.size(), 1u);
+    const ScopeFrame& frame = frames[0];
+    EXPECT_NEAR(frame.correlation, 1.0f, 1.0e-4f);
+    for (int32 i = 0; i < frame.numPoints; ++i)
+        EXPECT_EQ(frame.left[i], frame.right[i]);
+}
+
+TEST_F(StereoScopeTest, InvertedOutput_CorrelationIsMinusOne) {
+    processSine(kBlocksPerFrame, -1.0f);
+
+    std::vector<ScopeFrame> frames = pollFrames();
+    ASSERT_EQ(frames.size(), 1u);
+    const ScopeFrame& frame = frames[0];
+    EXPECT_NEAR(frame.correlation, -1.0f, 1.0e-4f);
+}
+
+TEST_F(StereoScopeTest, Silence_CorrelationIsZero) {
+    StereoBlock block(kBlockSize);
+    for (int i = 0; i < kBlocksPerFrame; ++i)
+        processor->process(block.data);
+
+    std::vector<ScopeFrame> frames = pollFrames();
+    ASSERT_EQ(frames.size(), 1u);
+    const ScopeFrame& frame = frames[0];
+    EXPECT_EQ(frame.correlation, 0.0f);
+}
+
+TEST_F(StereoScopeTest, FullQueueDropsNewFramesWithoutBlocking) {
+    processSine(static_cast<int>(ScopeMessage::kMaxRecords + 3) * kBlocksPerFrame, 1.0f);
+
+    EXPECT_EQ(pollFrames().size(), ScopeMessage::kMaxRecords);
+
+    // Draining makes room again
+    processSine(kBlocksPerFrame, 1.0f);
+    EXPECT_EQ(pollFrames().size(), 1u);
+}
@@ -0,0 +1,79 @@
+// test_trace_export.cpp
+// Integration test for the Chrome trace written by SimplePannerProcessor
+// when PluginInfo::kTraceEnv is set
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "trace_recorder.h"
+#include "process_test_helpers.h"
+#include "test_file_helpers.h"
+#include <gtest/gtest.h>
+#include "public.sdk/source/common/memorystream.h"
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+//------------------------------------------------------------------------------
+// Session trace
+//------------------------------------------------------------------------------
+
+TEST(TraceExport, Session_LifecycleCallsAndSampledBlocks) {
+    // Must precede the first TraceRecorder::get() in this executable
+    std::string path = ::testing::TempDir() + "simplepanner_trace.json";
+    setEnvironment(PluginInfo::kTraceEnv, path.c_str());
+
+    const int32 kBlockSize = 128;
+    SimplePannerProcessor* processor = new SimplePannerProcessor();
+    processor->initialize(nullptr);
+
+    ProcessSetup setup;
+    setup.processMode = kRealtime;
+    setup.symbolicSampleSize = kSample32;
+    setup.maxSamplesPerBlock = kBlockSize;
+    setup.sampleRate = 44100.0;
+    processor->setupProcessing(setup);
+    processor->setActive(true);
+
+    MemoryStream state;
+    processor->getState(&state);
+    state.seek(0, IBStream::kIBSeekSet, nullptr);
+    processor->setState(&state);
+
+    StereoBlock block(kBlockSize);
+    for (int i = 0; i < 4 * 16; ++i)  // 4 sampled blocks
+        processor->process(block.data);
+
+    processor->setActive(false);
+    processor->terminate();
+    processor->release();
+
+    TraceRecorder* recorder = TraceRecorder::get();
+    ASSERT_NE(recorder, nullptr);
+
+    // 5 lifecycle calls and 4 blocks, written by the background thread
+    const uint64 kExpectedEvents = 9;
+    for (int i = 0; i < 300 && recorder->numWritten() < kExpectedEvents; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(recorder->numWritten(), kExpectedEvents);
+
+    std::string trace = readFile(path);
+
+    EXPECT_EQ(countOf(trace, "\"Processor::initialize\""), 1u);
+    EXPECT_EQ(countOf(trace, "\"Processor::setupProcessing\""), 1u);
+    EXPECT_EQ(countOf(trace, "\"Processor::setActive(true)\""), 1u);
+    EXPECT_EQ(countOf(trace, "\"Processor::setActive(false)\""), 1u);
+    EXPECT_EQ(countOf(trace, "\"Processor::setState\""), 1u);
+    EXPECT_EQ(countOf(trace, "\"Processor::process\",\"cat\":\"audio\""), 4u);
+
+    // Module exit: the writer is stopped and the JSON array closed
+    TraceRecorder::shutdown();
+    EXPECT_EQ(TraceRecorder::get(), nullptr);
+    trace = readFile(path);
+    EXPECT_NE(trace.find("\"dropped events\""), std::string::npos);
+    EXPECT_EQ(trace.compare(trace.size() - 3, 3, "\n]\n"), 0);
+}
@@ -0,0 +1,147 @@
+// test_workload_dump.cpp
+// Integration test for the workload statistics SimplePannerProcessor writes
+// on terminate() when a statistics directory is set
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "process_test_helpers.h"
+#include "test_file_helpers.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+class WorkloadDumpTest : public ::testing::Test {
+protected:
+    static constexpr int32 kMaxBlockSize = 512;
+
+    void SetUp() override {
+        processor = new SimplePannerProcessor();
+        processor->initialize(nullptr);
+    }
+
+    void TearDown() override {
+        processor->release();
+    }
+
+    void start(double sampleRate) {
+        ProcessSetup setup;
+        setup.processMode = kRealtime;
+        setup.symbolicSampleSize = kSample32;
+        setup.maxSamplesPerBlock = kMaxBlockSize;
+        setup.sampleRate = sampleRate;
+        processor->setupProcessing(setup);
+        processor->setActive(true);
+    }
+
+    void process(int32 numSamples, uint64 silenceFlags = 0, IParameterChanges* changes = nullptr) {
+        block.data.numSamples = numSamples;
+        block.data.inputs[0].silenceFlags = silenceFlags;
+        block.data.inputParameterChanges = changes;
+        processor->process(block.data);
+    }
+
+    SimplePannerProcessor* processor = nullptr;
+    StereoBlock block{kMaxBlockSize};
+};
+
+//------------------------------------------------------------------------------
+// Output file
+//------------------------------------------------------------------------------
+
+TEST_F(WorkloadDumpTest, Path_NamedAfterProcessAndInstance) {
+    EXPECT_EQ(processor->getWorkloadStatsPath(), "");
+
+    processor->setWorkloadStatsDirectory(::testing::TempDir().c_str());
+    std::string path = processor->getWorkloadStatsPath();
+    EXPECT_EQ(path.compare(0, ::testing::TempDir().size(), ::testing::TempDir()), 0);
+    EXPECT_NE(path.find("workload-"), std::string::npos);
+    EXPECT_EQ(path.compare(path.size() - 5, 5, ".json"), 0);
+
+    // Another instance writes another file
+    SimplePannerProcessor* other = new SimplePannerProcessor();
+    other->setWorkloadStatsDirectory(::testing::TempDir().c_str());
+    EXPECT_NE(other->getWorkloadStatsPath(), path);
+    other->release();
+
+    processor->setWorkloadStatsDirectory("");
+    EXPECT_EQ(processor->getWorkloadStatsPath(), "");
+    processor->terminate();
+}
+
+TEST_F(WorkloadDumpTest, Session_WrittenOnTerminate) {
+    processor->setWorkloadStatsDirectory(::testing::TempDir().c_str());
+    std::string path = processor->getWorkloadStatsPath();
+    std::remove(path.c_str());
+
+    start(48000.0);
+    for (int i = 0; i < 6; ++i)
+        process(512);
+    process(300, 0x3);  // Silent input, irregular size
+    process(0);         // Host flush
+
+    // Two queues, three points
+    TestParameterChanges changes;
+    changes.add(kParamLeftPan, 0.2, 0);
+    changes.add(kParamLeftPan, 0.4, 100);
+    changes.add(kParamMasterGain, 0.5, 10);
+    process(512, 0x1, &changes);
+    processor->setActive(false);
+
+    start(96000.0);
+    process(256);
+    processor->setActive(false);
+
+    EXPECT_FALSE(fileExists(path));
+    processor->terminate();
+    ASSERT_TRUE(fileExists(path));
+
+    std::string text = readFile(path);
+    EXPECT_NE(text.find("\"blocks\": 10,"), std::string::npos);
+    EXPECT_NE(text.find("\"blockSize\": {\"min\": 0, \"max\": 512,"), std::string::npos);
+    EXPECT_NE(text.find("{\"from\": 512, \"blocks\": 7}"), std::string::npos);
+    EXPECT_NE(text.find("\"nonPowerOfTwoBlocks\": 1,"), std::string::npos);
+    EXPECT_NE(text.find("\"parameterQueues\": {\"min\": 0, \"max\": 2,"), std::string::npos);
+    EXPECT_NE(text.find("\"parameterPoints\": {\"min\": 0, \"max\": 3,"), std::string::npos);
+    EXPECT_NE(text.find("\"silentInputBlocks\": 1,"), std::string::npos);
+    EXPECT_NE(text.find("\"partlySilentInputBlocks\": 1,"), std::string::npos);
+    EXPECT_NE(text.find("\"processMode\": {\"realtime\": 10, \"prefetch\": 0, \"offline\": 0},"),
+              std::string::npos);
+    EXPECT_NE(text.find("\"sampleRates\": [{\"hz\": 48000, \"blocks\": 9}, {\"hz\": 96000, \"blocks\": 1}]"),
+              std::string::npos);
+
+    std::remove(path.c_str());
+}
+
+TEST_F(WorkloadDumpTest, Disabled_NoFile) {
+    processor->setWorkloadStatsDirectory(::testing::TempDir().c_str());
+    std::string path = processor->getWorkloadStatsPath();
+    std::remove(path.c_str());
+    processor->setWorkloadStatsDirectory(nullptr);
+
+    start(48000.0);
+    process(512);
+    processor->setActive(false);
+    processor->terminate();
+
+    EXPECT_FALSE(fileExists(path));
+}
+
+TEST_F(WorkloadDumpTest, NoBlocks_NoFile) {
+    // A plugin scan: initialized and terminated without processing
+    processor->setWorkloadStatsDirectory(::testing::TempDir().c_str());
+    std::string path = processor->getWorkloadStatsPath();
+    std::remove(path.c_str());
+
+    processor->terminate();
+
+    EXPECT_FALSE(fileExists(path));
+}
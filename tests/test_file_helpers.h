@@ -0,0 +1,44 @@
+// test_file_helpers.h
+// File and environment helpers shared by the unit and integration tests
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace SimplePannerTest {
+
+// Set an environment variable read by the plugin (e.g. PluginInfo::kTraceEnv)
+inline void setEnvironment(const char* name, const char* value) {
+#if defined(_WIN32)
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+// Whole text file, or "" if it cannot be read
+inline std::string readFile(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+inline bool fileExists(const std::string& path) {
+    std::ifstream file(path);
+    return file.good();
+}
+
+// Number of (possibly overlapping) occurrences of pattern in text
+inline size_t countOf(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+        ++count;
+    return count;
+}
+
+} // namespace SimplePannerTest
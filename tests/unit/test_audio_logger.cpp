@@ -0,0 +1,190 @@
+// test_audio_logger.cpp
+// Unit tests for the asynchronous audio thread logger
+
+#include "audio_logger.h"
+#include "test_file_helpers.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+namespace {
+
+std::string logPath(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+// Record as queued, with a fixed time
+template <typename... Args>
+std::string formatted(LogLevel level, int64 timeNanos, const char* format, Args... args) {
+    LogRecord entry;
+    entry.timeNanos = timeNanos;
+    entry.format = format;
+    entry.instance = 3;
+    entry.level = level;
+    entry.numArguments = static_cast<uint8>(sizeof...(Args));
+    int32 index = 0;
+    ((entry.arguments[index++] = makeLogArgument(args)), ...);
+    (void)index;
+
+    char text[256];
+    AudioLogger::format(entry, text, sizeof(text));
+    return text;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Formatting
+//------------------------------------------------------------------------------
+
+TEST(AudioLogger, Format_PrefixAndArguments) {
+    EXPECT_EQ(formatted(LogLevel::kWarning, 12345678901LL, "block of {} samples took {} us", 512, 11000u),
+              "[   12.345678] W #3 block of 512 samples took 11000 us");
+    EXPECT_EQ(formatted(LogLevel::kError, 0, "no arguments"), "[    0.000000] E #3 no arguments");
+    EXPECT_EQ(formatted(LogLevel::kInfo, 0, "{}", "literal"), "[    0.000000] I #3 literal");
+    EXPECT_EQ(formatted(LogLevel::kDebug, 0, "{} {}", true, -7LL), "[    0.000000] D #3 1 -7");
+}
+
+TEST(AudioLogger, Format_RealsIndependentOfLocale) {
+    EXPECT_EQ(formatted(LogLevel::kInfo, 0, "{}", 48000.0), "[    0.000000] I #3 48000");
+    EXPECT_EQ(formatted(LogLevel::kInfo, 0, "{}", 0.5f), "[    0.000000] I #3 0.5");
+    EXPECT_EQ(formatted(LogLevel::kInfo, 0, "{}", -1.25), "[    0.000000] I #3 -1.25");
+    EXPECT_EQ(formatted(LogLevel::kInfo, 0, "{}", 1.0 / 3.0), "[    0.000000] I #3 0.333333");
+    EXPECT_EQ(formatted(LogLevel::kInfo, 0, "{}", 2.0e12), "[    0.000000] I #3 2000000000000");
+}
+
+TEST(AudioLogger, Format_PlaceholdersAndArgumentsMismatched) {
+    // Missing arguments leave the placeholder, extra ones are ignored
+    EXPECT_EQ(formatted(LogLevel::kInfo, 0, "{} and {}", 1), "[    0.000000] I #3 1 and {}");
+    EXPECT_EQ(formatted(LogLevel::kInfo, 0, "only {}", 1, 2), "[    0.000000] I #3 only 1");
+    EXPECT_EQ(formatted(LogLevel::kInfo, 0, "{ } {x}"), "[    0.000000] I #3 { } {x}");
+}
+
+TEST(AudioLogger, Format_TruncatedToBuffer) {
+    LogRecord entry;
+    entry.timeNanos = 0;
+    entry.format = "a long message that does not fit {}";
+    entry.instance = 1;
+    entry.level = LogLevel::kInfo;
+    entry.numArguments = 1;
+    entry.arguments[0] = makeLogArgument(123456789);
+
+    char text[24];
+    AudioLogger::format(entry, text, sizeof(text));
+    EXPECT_EQ(std::string(text), "[    0.000000] I #1 a l");
+}
+
+//------------------------------------------------------------------------------
+// Logger
+//------------------------------------------------------------------------------
+
+TEST(AudioLogger, File_OneLinePerRecord) {
+    std::string path = logPath("audio_logger_basic.log");
+    {
+        AudioLogger logger(path.c_str());
+        ASSERT_TRUE(logger.isOpen());
+        logger.record(LogLevel::kInfo, 2, "activated at {} Hz", 44100.0);
+        logger.record(LogLevel::kWarning, 2, "block of {} samples missed its deadline", 256);
+    }
+
+    std::string text = readFile(path);
+    EXPECT_EQ(countOf(text, "\n"), 2u);
+    EXPECT_NE(text.find("] I #2 activated at 44100 Hz\n"), std::string::npos);
+    EXPECT_NE(text.find("] W #2 block of 256 samples missed its deadline\n"), std::string::npos);
+    EXPECT_LT(text.find("activated"), text.find("missed"));
+    std::remove(path.c_str());
+}
+
+TEST(AudioLogger, Records_FromManyThreadsAreAllWritten) {
+    std::string path = logPath("audio_logger_threads.log");
+    const int kThreads = 4;
+    const int kRecordsPerThread = 200;
+    {
+        AudioLogger logger(path.c_str());
+        ASSERT_TRUE(logger.isOpen());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&logger, t] {
+                for (int i = 0; i < kRecordsPerThread; ++i)
+                    logger.record(LogLevel::kDebug, static_cast<uint32>(t), "record {}", i);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        EXPECT_EQ(logger.numDropped(), 0u);  // Fewer records than kCapacity
+    }
+
+    std::string text = readFile(path);
+    EXPECT_EQ(countOf(text, "] D #"), static_cast<size_t>(kThreads * kRecordsPerThread));
+    EXPECT_EQ(countOf(text, " record 199\n"), static_cast<size_t>(kThreads));
+    std::remove(path.c_str());
+}
+
+TEST(AudioLogger, BufferFull_DroppedRecordsNoted) {
+    std::string path = logPath("audio_logger_dropped.log");
+    uint64 dropped = 0;
+    {
+        AudioLogger logger(path.c_str());
+        ASSERT_TRUE(logger.isOpen());
+        for (size_t i = 0; i < AudioLogger::kCapacity + 100; ++i)
+            logger.record(LogLevel::kDebug, 1, "record {}", i);
+        dropped = logger.numDropped();
+    }
+
+    // The writer may have drained some records in between
+    std::string text = readFile(path);
+    if (dropped > 0) {
+        EXPECT_NE(text.find("(" + std::to_string(dropped) + " log records dropped: buffer full)\n"),
+                  std::string::npos);
+    }
+    EXPECT_EQ(countOf(text, "] D #1 record "), AudioLogger::kCapacity + 100 - dropped);
+    std::remove(path.c_str());
+}
+
+TEST(AudioLogger, WriterThread_WritesWhileRunning) {
+    std::string path = logPath("audio_logger_running.log");
+    AudioLogger logger(path.c_str());
+    ASSERT_TRUE(logger.isOpen());
+    logger.record(LogLevel::kError, 5, "something failed");
+
+    for (int i = 0; i < 200 && logger.numWritten() == 0; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(logger.numWritten(), 1u);
+    EXPECT_NE(readFile(path).find("] E #5 something failed\n"), std::string::npos);
+}
+
+TEST(AudioLogger, UnwritablePath_IsNotOpen) {
+    AudioLogger logger("/nonexistent-directory/simplepanner.log");
+    EXPECT_FALSE(logger.isOpen());
+}
+
+//------------------------------------------------------------------------------
+// Levels
+//------------------------------------------------------------------------------
+
+TEST(AudioLogger, Levels_CompiledInUpToConfiguredLevel) {
+    EXPECT_EQ(isLogLevelEnabled(LogLevel::kError), SIMPLEPANNER_LOG_LEVEL >= 1);
+    EXPECT_EQ(isLogLevelEnabled(LogLevel::kWarning), SIMPLEPANNER_LOG_LEVEL >= 2);
+    EXPECT_EQ(isLogLevelEnabled(LogLevel::kInfo), SIMPLEPANNER_LOG_LEVEL >= 3);
+    EXPECT_EQ(isLogLevelEnabled(LogLevel::kDebug), SIMPLEPANNER_LOG_LEVEL >= 4);
+}
+
+TEST(AudioLogger, Get_IsNullWithoutEnvironmentVariable) {
+    // First use in this executable decides; CTest does not set the variable
+    if (std::getenv(PluginInfo::kLogEnv))
+        GTEST_SKIP() << PluginInfo::kLogEnv << " is set";
+
+    EXPECT_EQ(AudioLogger::get(), nullptr);
+    logError(1, "no effect {}", 1);
+
+    AudioLogger::shutdown();  // Nothing to stop
+    EXPECT_EQ(AudioLogger::get(), nullptr);
+}
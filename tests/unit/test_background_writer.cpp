@@ -0,0 +1,67 @@
+// test_background_writer.cpp
+// Unit tests for the periodic writer thread
+
+#include "background_writer.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Steinberg::SimplePanner;
+
+//------------------------------------------------------------------------------
+// Thread lifetime
+//------------------------------------------------------------------------------
+
+TEST(BackgroundWriter, Start_DrainsAtTheInterval) {
+    std::atomic<int> drains{0};
+    BackgroundWriter writer;
+    EXPECT_FALSE(writer.isRunning());
+
+    writer.start(5, [&drains] { drains.fetch_add(1); });
+    EXPECT_TRUE(writer.isRunning());
+    for (int i = 0; i < 300 && drains.load() < 3; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_GE(drains.load(), 3);
+
+    writer.stop();
+    EXPECT_FALSE(writer.isRunning());
+}
+
+TEST(BackgroundWriter, Stop_WakesWithoutWaitingForTheInterval) {
+    std::atomic<int> drains{0};
+    BackgroundWriter writer;
+    writer.start(60000, [&drains] { drains.fetch_add(1); });
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    writer.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10));
+
+    // No drain runs after stop() returns
+    int drained = drains.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(drains.load(), drained);
+}
+
+TEST(BackgroundWriter, Stop_WithoutStartOrTwiceIsHarmless) {
+    BackgroundWriter idle;
+    idle.stop();
+    EXPECT_FALSE(idle.isRunning());
+
+    BackgroundWriter writer;
+    writer.start(5, [] {});
+    writer.stop();
+    writer.stop();
+    EXPECT_FALSE(writer.isRunning());
+}
+
+TEST(BackgroundWriter, Destructor_StopsTheThread) {
+    std::atomic<int> drains{0};
+    {
+        BackgroundWriter writer;
+        writer.start(1, [&drains] { drains.fetch_add(1); });
+    }
+    int drained = drains.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(drains.load(), drained);
+}
@@ -357,3 +357,106 @@ TEST(DelayLine, SignalIntegrity_ImpulseResponse) {
         EXPECT_FLOAT_EQ(output, 0.0f);
     }
 }
+
+//------------------------------------------------------------------------------
+// Block Processing Tests
+//------------------------------------------------------------------------------
+
+TEST(DelayLine, ProcessBlock_MatchesPerSampleProcessing) {
+    // Cover delay 0 (1-sample minimum), small, large and full-buffer delays
+    size_t delays[] = {0, 1, 7, 63, 99, 100};
+
+    for (size_t delayAmount : delays) {
+        DelayLine reference;
+        DelayLine block;
+        reference.resize(100);
+        block.resize(100);
+        reference.setDelay(delayAmount);
+        block.setDelay(delayAmount);
+
+        std::vector<float> input(37);
+        std::vector<float> output(37);
+        float counter = 1.0f;
+
+        for (int b = 0; b < 20; ++b) {
+            for (auto& sample : input) {
+                sample = counter;
+                counter += 1.0f;
+            }
+
+            block.processBlock(input.data(), output.data(), input.size());
+
+            for (size_t i = 0; i < input.size(); ++i) {
+                EXPECT_FLOAT_EQ(output[i], reference.process(input[i]))
+                    << "delay " << delayAmount << " block " << b << " sample " << i;
+            }
+        }
+    }
+}
+
+TEST(DelayLine, ProcessBlock_InPlace) {
+    size_t delays[] = {0, 5, 100};
+
+    for (size_t delayAmount : delays) {
+        DelayLine reference;
+        DelayLine block;
+        reference.resize(100);
+        block.resize(100);
+        reference.setDelay(delayAmount);
+        block.setDelay(delayAmount);
+
+        std::vector<float> buffer(64);
+        float counter = 1.0f;
+
+        for (int b = 0; b < 10; ++b) {
+            std::vector<float> expected(buffer.size());
+            for (size_t i = 0; i < buffer.size(); ++i) {
+                buffer[i] = counter;
+                expected[i] = reference.process(counter);
+                counter += 1.0f;
+            }
+
+            block.processBlock(buffer.data(), buffer.data(), buffer.size());
+
+            for (size_t i = 0; i < buffer.size(); ++i) {
+                EXPECT_FLOAT_EQ(buffer[i], expected[i]) << "delay " << delayAmount;
+            }
+        }
+    }
+}
+
+TEST(DelayLine, Write_KeepsHistoryForLaterDelay) {
+    DelayLine reference;
+    DelayLine block;
+    reference.resize(100);
+    block.resize(100);
+
+    float input[30];
+    for (int i = 0; i < 30; ++i) {
+        input[i] = static_cast<float>(i + 1);
+        reference.process(input[i]);
+    }
+    block.write(input, 30);
+
+    EXPECT_FLOAT_EQ(block.getLastInput(), 30.0f);
+
+    // Switching to a longer delay reads the written history
+    reference.setDelay(10);
+    block.setDelay(10);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_FLOAT_EQ(block.process(0.0f), reference.process(0.0f));
+    }
+}
+
+TEST(DelayLine, ProcessBlock_EmptyBuffer_OutputsZero) {
+    DelayLine delay;
+    float input[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    float output[4];
+
+    delay.processBlock(input, output, 4);
+
+    for (float sample : output) {
+        EXPECT_FLOAT_EQ(sample, 0.0f);
+    }
+    EXPECT_FLOAT_EQ(delay.getLastInput(), 0.0f);
+}
@@ -0,0 +1,95 @@
+// test_fast_math.cpp
+// Accuracy tests for the fast approximations against the exact conversions
+
+#include "fast_math.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Logarithm
+//------------------------------------------------------------------------------
+
+TEST(FastMath, Log2_AbsoluteError) {
+    double maxError = 0.0;
+    for (int i = 1; i <= 100000; ++i) {
+        float x = i * 0.0001f;
+        double exact = std::log2(static_cast<double>(x));
+        maxError = std::max(maxError, std::abs(fastLog2(x) - exact));
+    }
+    EXPECT_LT(maxError, 1.0e-6);
+}
+
+//------------------------------------------------------------------------------
+// Trigonometry
+//------------------------------------------------------------------------------
+
+TEST(FastMath, Sin_AbsoluteError) {
+    double maxError = 0.0;
+    for (int i = -10000; i <= 10000; ++i) {
+        float x = static_cast<float>(i * (kPi / 2.0) / 10000.0);
+        maxError = std::max(maxError, std::abs(fastSin(x) - std::sin(static_cast<double>(x))));
+    }
+    EXPECT_LT(maxError, 2.0e-6);
+}
+
+TEST(FastMath, Cos_AbsoluteError) {
+    double maxError = 0.0;
+    for (int i = 0; i <= 20000; ++i) {
+        float x = static_cast<float>(i * kPi / 20000.0);
+        maxError = std::max(maxError, std::abs(fastCos(x) - std::cos(static_cast<double>(x))));
+    }
+    EXPECT_LT(maxError, 2.0e-6);
+}
+
+//------------------------------------------------------------------------------
+// Parameter Conversions over the full ParamRange
+//------------------------------------------------------------------------------
+
+TEST(FastMath, LinearToDb_FullGainRange) {
+    double maxErrorDb = 0.0;
+    for (int i = 1; i <= 66000; ++i) {
+        float db = ParamRange::kGainMin + i * 0.001f;
+        float linear = dbToLinear(db);
+        maxErrorDb = std::max(maxErrorDb,
+                              static_cast<double>(std::abs(fastLinearToDb(linear) - linearToDb(linear))));
+    }
+    EXPECT_LT(maxErrorDb, 1.0e-5);
+    EXPECT_FLOAT_EQ(fastLinearToDb(0.0f), ParamRange::kGainMin);
+}
+
+TEST(FastMath, PanGains_FullPanRange) {
+    double maxGainError = 0.0;
+    double maxAngleErrorDegrees = 0.0;
+    for (int i = 0; i <= 20000; ++i) {
+        float pan = ParamRange::kPanMin + i * 0.01f;
+        PanGains fast = fastCalculatePanGains(pan);
+        PanGains exact = calculatePanGains(pan);
+
+        maxGainError = std::max(maxGainError, static_cast<double>(std::abs(fast.left - exact.left)));
+        maxGainError = std::max(maxGainError, static_cast<double>(std::abs(fast.right - exact.right)));
+
+        double fastAngle = std::atan2(static_cast<double>(fast.right), static_cast<double>(fast.left));
+        double exactAngle = std::atan2(static_cast<double>(exact.right), static_cast<double>(exact.left));
+        maxAngleErrorDegrees = std::max(maxAngleErrorDegrees, std::abs(fastAngle - exactAngle) * 180.0 / kPi);
+    }
+    EXPECT_LT(maxGainError, 2.0e-6);
+    EXPECT_LT(maxAngleErrorDegrees, 1.0e-4);
+}
+
+TEST(FastMath, PanGains_HardPanExact) {
+    PanGains left = fastCalculatePanGains(ParamRange::kPanMin);
+    PanGains right = fastCalculatePanGains(ParamRange::kPanMax);
+
+    EXPECT_FLOAT_EQ(left.right, 0.0f);
+    EXPECT_FLOAT_EQ(right.left, 0.0f);
+    EXPECT_EQ(left.left, 1.0f);
+    EXPECT_EQ(right.right, 1.0f);
+}
@@ -0,0 +1,47 @@
+// test_gain_table.cpp
+// Accuracy tests for the compile-time normalized → linear gain table
+
+#include "gain_table.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace Steinberg::SimplePanner;
+
+//------------------------------------------------------------------------------
+// Table Entries
+//------------------------------------------------------------------------------
+
+TEST(GainTable, Entries_MatchExactConversion) {
+    for (size_t i = 0; i < GainTable::kSize; ++i) {
+        double db = ParamRange::kGainMin + static_cast<double>(i) / GainTable::kStepsPerDb;
+        double exact = std::pow(10.0, db / 20.0);
+        EXPECT_NEAR(kGainTable.at(i) / exact, 1.0, 1.0e-7) << "index " << i;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Lookup
+//------------------------------------------------------------------------------
+
+TEST(GainTable, Lookup_ErrorBelowHundredthDb) {
+    double maxErrorDb = 0.0;
+    for (int i = 1; i <= 100000; ++i) {
+        float normalized = i * 0.00001f;
+        double exact = std::pow(10.0, normalizedToDb(normalized) / 20.0);
+        double errorDb = std::abs(20.0 * std::log10(tableNormalizedToLinearGain(normalized) / exact));
+        maxErrorDb = std::max(maxErrorDb, errorDb);
+    }
+    EXPECT_LT(maxErrorDb, 0.01);
+    EXPECT_LT(maxErrorDb, 1.0e-4);
+}
+
+TEST(GainTable, Lookup_MuteAndRangeEnds) {
+    EXPECT_EQ(tableNormalizedToLinearGain(0.0f), 0.0f);
+    EXPECT_EQ(tableNormalizedToLinearGain(-0.5f), 0.0f);
+    EXPECT_NEAR(tableNormalizedToLinearGain(1.0f), dbToLinear(ParamRange::kGainMax), 1.0e-6f);
+    EXPECT_NEAR(tableNormalizedToLinearGain(1.5f), dbToLinear(ParamRange::kGainMax), 1.0e-6f);
+}
+
+TEST(GainTable, Lookup_UnityIsExact) {
+    EXPECT_EQ(tableNormalizedToLinearGain(dbToNormalized(0.0f)), 1.0f);
+}
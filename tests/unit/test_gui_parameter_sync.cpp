@@ -2,6 +2,12 @@
 #include "plugineditor.h"
 #include "plugincontroller.h"
 #include "parameter_utils.h"
+#include "state_serializer.h"
+#include "public.sdk/source/common/memorystream.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 
 using namespace Steinberg;
 using namespace Steinberg::SimplePanner;
@@ -225,6 +231,17 @@ TEST_F(ParameterSyncTest, GUIToController_LinkToggleSync)
     control->forget();
 }
 
+TEST_F(ParameterSyncTest, GUIToController_EnablingLinkRightGainFollowsLeft)
+{
+    controller->setParamNormalized(kParamLeftGain, dbToNormalized(-6.0f));
+    controller->setParamNormalized(kParamRightGain, dbToNormalized(2.0f));
+
+    // Same resolution as the processor, which reports Right Gain back
+    controller->setParamNormalized(kParamLinkGain, 1.0);
+    EXPECT_FLOAT_EQ(controller->getParamNormalized(kParamRightGain), dbToNormalized(-6.0f));
+    EXPECT_FLOAT_EQ(controller->getParamNormalized(kParamLeftGain), dbToNormalized(-6.0f));
+}
+
 TEST_F(ParameterSyncTest, GUIToController_AllParameters)
 {
     // Test that all 8 parameters can be set through GUI
@@ -346,3 +363,191 @@ TEST_F(ParameterSyncTest, EditSequence_NestedEdits)
     control1->forget();
     control2->forget();
 }
+
+//------------------------------------------------------------------------
+// Component State Tests (batched setComponentState)
+//------------------------------------------------------------------------
+
+TEST_F(ParameterSyncTest, SetComponentState_LinkEnabled_RightGainFollowsLeft)
+{
+    PluginState state = PluginState::defaults();
+    state.values[kParamLeftGain] = dbToNormalized(-12.0f);
+    state.values[kParamRightGain] = dbToNormalized(-3.0f);
+    state.values[kParamLinkGain] = 1.0;
+
+    MemoryStream stream;
+    ASSERT_TRUE(StateSerializer::write(&stream, state));
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+
+    EXPECT_EQ(controller->setComponentState(&stream), kResultOk);
+
+    // Link resolved once for the whole state: linked gains follow Left Gain
+    EXPECT_FLOAT_EQ(controller->getParamNormalized(kParamLeftGain), dbToNormalized(-12.0f));
+    EXPECT_FLOAT_EQ(controller->getParamNormalized(kParamRightGain), dbToNormalized(-12.0f));
+    EXPECT_FLOAT_EQ(controller->getParamNormalized(kParamLinkGain), 1.0);
+}
+
+TEST_F(ParameterSyncTest, SetComponentState_LinkDisabled_AppliesAllValues)
+{
+    // Link enabled before loading must not mirror values of an unlinked state
+    controller->setParamNormalized(kParamLinkGain, 1.0);
+
+    PluginState state = PluginState::defaults();
+    state.values[kParamLeftPan] = panToNormalized(-40.0f);
+    state.values[kParamLeftGain] = dbToNormalized(-12.0f);
+    state.values[kParamRightGain] = dbToNormalized(-3.0f);
+    state.values[kParamMasterGain] = dbToNormalized(2.0f);
+    state.values[kParamLinkGain] = 0.0;
+    state.values[kParamPanLaw] = panLawToNormalized(kPanLawLinear);
+
+    MemoryStream stream;
+    ASSERT_TRUE(StateSerializer::write(&stream, state));
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+
+    EXPECT_EQ(controller->setComponentState(&stream), kResultOk);
+
+    for (int32 i = 0; i < StateSerializer::kNumParams; ++i)
+    {
+        EXPECT_FLOAT_EQ(controller->getParamNormalized(static_cast<Vst::ParamID>(i)), state.values[i])
+            << "parameter " << i;
+    }
+}
+
+//------------------------------------------------------------------------
+// Program List Tests (preset bank)
+//------------------------------------------------------------------------
+
+TEST_F(ParameterSyncTest, ProgramList_WithoutBank_HasDefaultProgram)
+{
+    ASSERT_EQ(controller->getProgramListCount(), 1);
+
+    Vst::ProgramListInfo info {};
+    ASSERT_EQ(controller->getProgramListInfo(0, info), kResultOk);
+    EXPECT_EQ(info.id, kPresetListId);
+    EXPECT_EQ(info.programCount, 1);
+
+    Vst::Parameter* program = controller->getParameterObject(kParamProgram);
+    ASSERT_NE(program, nullptr);
+    EXPECT_NE(program->getInfo().flags & Vst::ParameterInfo::kIsProgramChange, 0);
+    EXPECT_EQ(program->getInfo().flags & Vst::ParameterInfo::kCanAutomate, 0);
+
+    Vst::String128 name {};
+    ASSERT_EQ(controller->getProgramName(kPresetListId, 0, name), kResultTrue);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(name)), u"Default");
+}
+
+TEST_F(ParameterSyncTest, ProgramList_NamesReadFromBank)
+{
+    // Three presets, the last one without a name
+    PresetBankEntry wide = {"Wide", PluginState::defaults()};
+    PresetBankEntry mono = {"Mono", PluginState::defaults()};
+    PresetBankEntry unnamed = {"", PluginState::defaults()};
+    std::vector<uint8> data = PresetBank::build({wide, mono, unnamed});
+
+    const char* dir = std::getenv("TMPDIR");
+    std::string path = std::string(dir ? dir : "/tmp") + "/simplepanner_program_names.sppb";
+    FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(data.data(), 1, data.size(), file);
+    std::fclose(file);
+
+    SimplePannerController* banked = new SimplePannerController();
+    ASSERT_TRUE(banked->loadPresetBank(path.c_str()));
+    ASSERT_EQ(banked->initialize(nullptr), kResultTrue);
+
+    Vst::ProgramListInfo info {};
+    ASSERT_EQ(banked->getProgramListInfo(0, info), kResultOk);
+    EXPECT_EQ(info.programCount, 3);
+
+    Vst::String128 name {};
+    ASSERT_EQ(banked->getProgramName(kPresetListId, 1, name), kResultTrue);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(name)), u"Mono");
+    ASSERT_EQ(banked->getProgramName(kPresetListId, 2, name), kResultTrue);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(name)), u"Preset 3");
+    EXPECT_NE(banked->getProgramName(kPresetListId, 3, name), kResultTrue);
+
+    // The stepped program parameter shows the same names
+    Vst::Parameter* program = banked->getParameterObject(kParamProgram);
+    ASSERT_NE(program, nullptr);
+    EXPECT_EQ(program->getInfo().stepCount, 2);
+    ASSERT_EQ(banked->getParamStringByValue(kParamProgram, programToNormalized(0, 3), name), kResultOk);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(name)), u"Wide");
+    EXPECT_DOUBLE_EQ(program->toPlain(programToNormalized(2, 3)), 2.0);
+
+    banked->terminate();
+    banked->release();
+    std::remove(path.c_str());
+}
+
+TEST_F(ParameterSyncTest, ProgramChange_WithoutBank_RecallsDefaults)
+{
+    controller->setParamNormalized(kParamLeftPan, panToNormalized(30.0f));
+    controller->setParamNormalized(kParamMasterGain, dbToNormalized(-20.0f));
+
+    controller->setParamNormalized(kParamProgram, 0.0);
+
+    PluginState defaults = PluginState::defaults();
+    for (int32 i = 0; i < StateSerializer::kNumParams; ++i)
+    {
+        EXPECT_FLOAT_EQ(controller->getParamNormalized(static_cast<Vst::ParamID>(i)), defaults.values[i])
+            << "parameter " << i;
+    }
+}
+
+//------------------------------------------------------------------------
+// Host String Conversion Tests (plugin_parameters.h)
+//------------------------------------------------------------------------
+
+TEST_F(ParameterSyncTest, HostString_MatchesEditorFormatting)
+{
+    Vst::String128 text {};
+
+    ASSERT_EQ(controller->getParamStringByValue(kParamLeftPan, panToNormalized(-50.0f), text), kResultOk);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(text)), u"L50");
+
+    ASSERT_EQ(controller->getParamStringByValue(kParamMasterGain, 0.0, text), kResultOk);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(text)), u"-∞");
+
+    ASSERT_EQ(controller->getParamStringByValue(kParamRightGain, dbToNormalized(3.0f), text), kResultOk);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(text)), u"+3.0");
+
+    ASSERT_EQ(controller->getParamStringByValue(kParamLeftDelay, delayMsToNormalized(25.5f), text), kResultOk);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(text)), u"25.5");
+
+    ASSERT_EQ(controller->getParamStringByValue(kParamLinkGain, 1.0, text), kResultOk);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(text)), u"On");
+
+    ASSERT_EQ(controller->getParamStringByValue(kParamMorph, 0.5, text), kResultOk);
+    EXPECT_EQ(std::u16string(reinterpret_cast<const char16_t*>(text)), u"50.0");
+}
+
+TEST_F(ParameterSyncTest, HostString_ParsesTypedValues)
+{
+    Vst::ParamValue value = -1.0;
+
+    ASSERT_EQ(controller->getParamValueByString(kParamRightPan, (Vst::TChar*)u"R25", value), kResultOk);
+    EXPECT_FLOAT_EQ(value, panToNormalized(25.0f));
+
+    ASSERT_EQ(controller->getParamValueByString(kParamLeftGain, (Vst::TChar*)u"-6 dB", value), kResultOk);
+    EXPECT_FLOAT_EQ(value, dbToNormalized(-6.0f));
+
+    ASSERT_EQ(controller->getParamValueByString(kParamLeftGain, (Vst::TChar*)u"-inf", value), kResultOk);
+    EXPECT_FLOAT_EQ(value, 0.0f);
+
+    ASSERT_EQ(controller->getParamValueByString(kParamMorph, (Vst::TChar*)u"50", value), kResultOk);
+    EXPECT_DOUBLE_EQ(value, 0.5);
+
+    EXPECT_NE(controller->getParamValueByString(kParamLeftGain, (Vst::TChar*)u"loud", value), kResultOk);
+}
+
+TEST_F(ParameterSyncTest, HostString_PlainValuesUseParameterUnits)
+{
+    EXPECT_FLOAT_EQ(controller->normalizedParamToPlain(kParamLeftPan, panToNormalized(-40.0f)), -40.0f);
+    EXPECT_FLOAT_EQ(controller->normalizedParamToPlain(kParamMasterGain, dbToNormalized(-12.0f)), -12.0f);
+    EXPECT_FLOAT_EQ(controller->plainParamToNormalized(kParamRightDelay, 50.0), delayMsToNormalized(50.0f));
+    EXPECT_DOUBLE_EQ(controller->normalizedParamToPlain(kParamMorph, 0.25), 25.0);
+
+    // Defaults are unchanged by the parameter classes
+    EXPECT_FLOAT_EQ(controller->getParamNormalized(kParamLeftGain), dbToNormalized(ParamDefault::kLeftGain));
+    EXPECT_FLOAT_EQ(controller->getParamNormalized(kParamLeftPan), panToNormalized(ParamDefault::kLeftPan));
+}
@@ -0,0 +1,114 @@
+// test_level_meter.cpp
+// Unit tests for the vectorized peak / RMS output metering
+
+#include "level_meter.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+// Deterministic test signal with a varying sign and magnitude
+std::vector<float> makeSignal(int32 numSamples) {
+    std::vector<float> samples(numSamples);
+    for (int32 i = 0; i < numSamples; ++i)
+        samples[i] = std::sin(0.37f * i) * (0.2f + 0.01f * (i % 17));
+    return samples;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Block Reduction
+//------------------------------------------------------------------------------
+
+TEST(LevelMeter, MeasureBlock_MatchesScalarReferenceForAllTailLengths) {
+    for (int32 numSamples = 0; numSamples <= 3 * kMeterLanes + 1; ++numSamples) {
+        std::vector<float> samples = makeSignal(numSamples);
+
+        float peak = 0.0f;
+        double sumSquares = 0.0;
+        for (float sample : samples) {
+            peak = std::max(peak, std::abs(sample));
+            sumSquares += static_cast<double>(sample) * sample;
+        }
+
+        BlockLevel level = measureBlock(samples.data(), numSamples);
+        EXPECT_EQ(level.peak, peak) << numSamples << " samples";
+        EXPECT_NEAR(level.sumSquares, sumSquares, 1.0e-5) << numSamples << " samples";
+    }
+}
+
+TEST(LevelMeter, MeasureBlock_PeakIsAbsolute) {
+    float samples[11] = {0.1f, -0.2f, 0.3f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -0.9f, 0.5f};
+    BlockLevel level = measureBlock(samples, 11);
+    EXPECT_EQ(level.peak, 0.9f);
+}
+
+TEST(LevelMeter, MeasureBlock_LargeBlock) {
+    std::vector<float> samples(4096, -0.5f);
+    samples[1234] = 0.75f;
+
+    BlockLevel level = measureBlock(samples.data(), static_cast<int32>(samples.size()));
+    EXPECT_EQ(level.peak, 0.75f);
+    EXPECT_NEAR(level.sumSquares, 4095 * 0.25 + 0.5625, 1.0e-2);
+}
+
+//------------------------------------------------------------------------------
+// Period Accumulation
+//------------------------------------------------------------------------------
+
+TEST(LevelMeter, Empty_ReportsSilence) {
+    LevelMeter meter;
+    EXPECT_EQ(meter.numSamples(), 0);
+    EXPECT_EQ(meter.peak(), 0.0f);
+    EXPECT_EQ(meter.rms(), 0.0f);
+}
+
+TEST(LevelMeter, Add_CombinesBlocksOfThePeriod) {
+    LevelMeter meter;
+    std::vector<float> loud(100, 0.5f);
+    std::vector<float> quiet(300, -0.25f);
+    meter.add(loud.data(), 100);
+    meter.add(quiet.data(), 300);
+
+    EXPECT_EQ(meter.numSamples(), 400);
+    EXPECT_EQ(meter.peak(), 0.5f);
+    EXPECT_NEAR(meter.rms(), std::sqrt((100 * 0.25 + 300 * 0.0625) / 400.0), 1.0e-6);
+
+    meter.reset();
+    EXPECT_EQ(meter.numSamples(), 0);
+    EXPECT_EQ(meter.peak(), 0.0f);
+}
+
+TEST(LevelMeter, Rms_OfFullScaleSine) {
+    const int32 kNumSamples = 48000;
+    std::vector<float> sine(kNumSamples);
+    for (int32 i = 0; i < kNumSamples; ++i)
+        sine[i] = static_cast<float>(std::sin(2.0 * 3.14159265358979323846 * 1000.0 * i / 48000.0));
+
+    LevelMeter meter;
+    meter.add(sine.data(), kNumSamples);
+    EXPECT_NEAR(meter.peak(), 1.0f, 1.0e-4f);
+    EXPECT_NEAR(meter.rms(), 1.0f / std::sqrt(2.0f), 1.0e-4f);
+}
+
+//------------------------------------------------------------------------------
+// Meter Scale
+//------------------------------------------------------------------------------
+
+TEST(LevelMeter, LevelToNormalized_UsesGainScale) {
+    EXPECT_NEAR(levelToNormalized(1.0f), dbToNormalized(0.0f), 1.0e-5f);
+    EXPECT_NEAR(levelToNormalized(0.5f), dbToNormalized(-6.0206f), 1.0e-5f);
+    EXPECT_NEAR(levelToNormalized(dbToLinear(-40.0f)), dbToNormalized(-40.0f), 1.0e-5f);
+}
+
+TEST(LevelMeter, LevelToNormalized_ClampsToRange) {
+    EXPECT_EQ(levelToNormalized(0.0f), 0.0f);
+    EXPECT_EQ(levelToNormalized(1.0e-30f), 0.0f);  // Denormal range
+    EXPECT_EQ(levelToNormalized(1.0e-4f), 0.0f);   // -80 dB
+    EXPECT_EQ(levelToNormalized(4.0f), 1.0f);      // +12 dB
+}
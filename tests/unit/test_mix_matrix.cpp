@@ -0,0 +1,165 @@
+// test_mix_matrix.cpp
+// Unit tests for the fused gain/pan/master mix matrix
+
+#include "mix_matrix.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+// Reference: the original five-multiply chain for one sample
+void referenceMix(float inL, float inR,
+                  float leftGain, float rightGain, float leftPan, float rightPan, float masterGain,
+                  float& outL, float& outR) {
+    float gainedLeft = inL * normalizedToLinearGain(leftGain);
+    float gainedRight = inR * normalizedToLinearGain(rightGain);
+    PanGains leftPanGains = calculatePanGains(normalizedToPan(leftPan));
+    PanGains rightPanGains = calculatePanGains(normalizedToPan(rightPan));
+    float master = normalizedToLinearGain(masterGain);
+    outL = (gainedLeft * leftPanGains.left + gainedRight * rightPanGains.left) * master;
+    outR = (gainedLeft * leftPanGains.right + gainedRight * rightPanGains.right) * master;
+}
+
+const float kUnity = dbToNormalized(0.0f);
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Compilation Tests
+//------------------------------------------------------------------------------
+
+TEST(MixMatrix, Defaults_AreIdentity) {
+    MixMatrix matrix = compileMixMatrix(kUnity, kUnity, 0.0f, 1.0f, kUnity);
+
+    EXPECT_NEAR(matrix.leftToLeft, 1.0f, 1.0e-5f);
+    EXPECT_NEAR(matrix.rightToRight, 1.0f, 1.0e-5f);
+    EXPECT_FLOAT_EQ(matrix.rightToLeft, 0.0f);
+    EXPECT_FLOAT_EQ(matrix.leftToRight, 0.0f);
+    EXPECT_TRUE(matrix.isDiagonal());
+}
+
+TEST(MixMatrix, CenterPan_HasCrossfeed) {
+    MixMatrix matrix = compileMixMatrix(kUnity, kUnity, 0.5f, 0.5f, kUnity);
+
+    EXPECT_NEAR(matrix.leftToLeft, 0.7071f, 0.001f);
+    EXPECT_NEAR(matrix.leftToRight, 0.7071f, 0.001f);
+    EXPECT_NEAR(matrix.rightToLeft, 0.7071f, 0.001f);
+    EXPECT_NEAR(matrix.rightToRight, 0.7071f, 0.001f);
+    EXPECT_FALSE(matrix.isDiagonal());
+}
+
+TEST(MixMatrix, MasterMute_AllZero) {
+    MixMatrix matrix = compileMixMatrix(kUnity, kUnity, 0.3f, 0.7f, 0.0f);
+
+    EXPECT_FLOAT_EQ(matrix.leftToLeft, 0.0f);
+    EXPECT_FLOAT_EQ(matrix.rightToLeft, 0.0f);
+    EXPECT_FLOAT_EQ(matrix.leftToRight, 0.0f);
+    EXPECT_FLOAT_EQ(matrix.rightToRight, 0.0f);
+}
+
+TEST(MixMatrix, SwappedHardPan_IsAntiDiagonal) {
+    MixMatrix matrix = compileMixMatrix(kUnity, kUnity, 1.0f, 0.0f, kUnity);
+
+    EXPECT_FLOAT_EQ(matrix.leftToLeft, 0.0f);
+    EXPECT_FLOAT_EQ(matrix.rightToRight, 0.0f);
+    EXPECT_NEAR(matrix.leftToRight, 1.0f, 1.0e-5f);
+    EXPECT_NEAR(matrix.rightToLeft, 1.0f, 1.0e-5f);
+}
+
+TEST(MixMatrix, MatchesSequentialProcessing) {
+    const float values[] = {0.0f, 0.13f, 0.5f, 0.77f, 0.909f, 1.0f};
+
+    for (float leftGain : values) {
+        for (float rightPan : values) {
+            for (float masterGain : values) {
+                float leftPan = 1.0f - rightPan;
+                float rightGain = 0.5f * (leftGain + masterGain);
+                MixMatrix matrix = compileMixMatrix(leftGain, rightGain, leftPan, rightPan, masterGain);
+
+                float inL = 0.8f;
+                float inR = -0.35f;
+                float expectedL, expectedR;
+                referenceMix(inL, inR, leftGain, rightGain, leftPan, rightPan, masterGain, expectedL, expectedR);
+
+                EXPECT_NEAR(inL * matrix.leftToLeft + inR * matrix.rightToLeft, expectedL, 1.0e-5f);
+                EXPECT_NEAR(inL * matrix.leftToRight + inR * matrix.rightToRight, expectedR, 1.0e-5f);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Ramp Tests
+//------------------------------------------------------------------------------
+
+TEST(MixMatrix, Ramp_EndsOnTarget) {
+    MixMatrix from = {1.0f, 0.0f, 0.0f, 1.0f};
+    MixMatrix to = {0.5f, 0.25f, -0.25f, 2.0f};
+    const int numSamples = 32;
+
+    MixMatrixRamp ramp = MixMatrixRamp::between(from, to, numSamples);
+    MixMatrix matrix = ramp.start;
+    for (int i = 0; i < numSamples; ++i) {
+        matrix.leftToLeft += ramp.step.leftToLeft;
+        matrix.rightToLeft += ramp.step.rightToLeft;
+        matrix.leftToRight += ramp.step.leftToRight;
+        matrix.rightToRight += ramp.step.rightToRight;
+    }
+
+    EXPECT_NEAR(matrix.leftToLeft, to.leftToLeft, 1.0e-5f);
+    EXPECT_NEAR(matrix.rightToLeft, to.rightToLeft, 1.0e-5f);
+    EXPECT_NEAR(matrix.leftToRight, to.leftToRight, 1.0e-5f);
+    EXPECT_NEAR(matrix.rightToRight, to.rightToRight, 1.0e-5f);
+}
+
+TEST(MixMatrix, Ramp_SameMatrix_ZeroStep) {
+    MixMatrix matrix = {0.3f, 0.1f, 0.2f, 0.4f};
+    MixMatrixRamp ramp = MixMatrixRamp::between(matrix, matrix, 16);
+
+    EXPECT_TRUE(ramp.start == matrix);
+    EXPECT_FLOAT_EQ(ramp.step.leftToLeft, 0.0f);
+    EXPECT_FLOAT_EQ(ramp.step.rightToLeft, 0.0f);
+    EXPECT_FLOAT_EQ(ramp.step.leftToRight, 0.0f);
+    EXPECT_FLOAT_EQ(ramp.step.rightToRight, 0.0f);
+}
+
+//------------------------------------------------------------------------------
+// A/B Morph Tests
+//------------------------------------------------------------------------------
+
+TEST(MixMatrix, Morph_EndsAreExact) {
+    MixMatrix a = compileMixMatrix(dbToNormalized(-3.0f), dbToNormalized(0.0f), 0.3f, 0.8f, dbToNormalized(0.0f));
+    MixMatrix b = {0.5f, 0.25f, -0.25f, 2.0f};
+
+    EXPECT_TRUE(morphMixMatrix(a, b, 0.0f) == a);
+    EXPECT_TRUE(morphMixMatrix(a, b, 1.0f) == b);
+}
+
+TEST(MixMatrix, Morph_MatchesCrossfadedOutputs) {
+    MixMatrix a = compileMixMatrix(dbToNormalized(-6.0f), dbToNormalized(2.0f), 0.2f, 0.9f, dbToNormalized(-1.0f));
+    MixMatrix b = compileMixMatrix(dbToNormalized(0.0f), dbToNormalized(-12.0f), 0.7f, 0.4f, dbToNormalized(3.0f));
+    const float amount = 0.35f;
+    const float inL = 0.8f;
+    const float inR = -0.3f;
+
+    MixMatrix m = morphMixMatrix(a, b, amount);
+    float outL = inL * m.leftToLeft + inR * m.rightToLeft;
+    float outR = inL * m.leftToRight + inR * m.rightToRight;
+
+    float outLA = inL * a.leftToLeft + inR * a.rightToLeft;
+    float outRA = inL * a.leftToRight + inR * a.rightToRight;
+    float outLB = inL * b.leftToLeft + inR * b.rightToLeft;
+    float outRB = inL * b.leftToRight + inR * b.rightToRight;
+
+    EXPECT_NEAR(outL, outLA + (outLB - outLA) * amount, 1.0e-6f);
+    EXPECT_NEAR(outR, outRA + (outRB - outRA) * amount, 1.0e-6f);
+}
+
+TEST(MixMatrix, Morph_DiagonalMatricesStayDiagonal) {
+    MixMatrix a = {1.0f, 0.0f, 0.0f, 1.0f};
+    MixMatrix b = {0.25f, 0.0f, 0.0f, 0.5f};
+
+    EXPECT_TRUE(morphMixMatrix(a, b, 0.5f).isDiagonal());
+}
@@ -0,0 +1,134 @@
+// test_mpsc_ring_buffer.cpp
+// Unit tests for the lock-free multiple producer / single consumer ring buffer
+
+#include "mpsc_ring_buffer.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+// Producer number plus a sequence repeated, so a torn copy shows
+struct Record {
+    long producer;
+    long values[7];
+};
+
+Record makeRecord(long producer, long value) {
+    Record record;
+    record.producer = producer;
+    for (long& v : record.values)
+        v = value;
+    return record;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Single Thread Semantics
+//------------------------------------------------------------------------------
+
+TEST(MpscRingBuffer, Empty_PopReturnsZero) {
+    MpscRingBuffer<int, 8> buffer;
+    int values[8] = {};
+    EXPECT_EQ(buffer.pop(values, 8), 0u);
+}
+
+TEST(MpscRingBuffer, Pop_DeliversInPushOrder) {
+    MpscRingBuffer<int, 8> buffer;
+    for (int i = 1; i <= 5; ++i)
+        EXPECT_TRUE(buffer.push(i));
+
+    int values[8] = {};
+    ASSERT_EQ(buffer.pop(values, 2), 2u);
+    EXPECT_EQ(values[0], 1);
+    EXPECT_EQ(values[1], 2);
+    ASSERT_EQ(buffer.pop(values, 8), 3u);
+    EXPECT_EQ(values[0], 3);
+    EXPECT_EQ(values[2], 5);
+    EXPECT_EQ(buffer.pop(values, 8), 0u);
+}
+
+TEST(MpscRingBuffer, Full_PushFailsAndKeepsOldRecords) {
+    MpscRingBuffer<int, 4> buffer;
+    for (int i = 1; i <= 4; ++i)
+        EXPECT_TRUE(buffer.push(i));
+    EXPECT_FALSE(buffer.push(5));
+
+    int values[4] = {};
+    ASSERT_EQ(buffer.pop(values, 1), 1u);
+    EXPECT_EQ(values[0], 1);
+
+    // One slot free again
+    EXPECT_TRUE(buffer.push(6));
+    EXPECT_FALSE(buffer.push(7));
+    ASSERT_EQ(buffer.pop(values, 4), 4u);
+    EXPECT_EQ(values[0], 2);
+    EXPECT_EQ(values[3], 6);
+}
+
+TEST(MpscRingBuffer, WrapAround_KeepsOrder) {
+    MpscRingBuffer<int, 4> buffer;
+    int next = 0;
+    int expected = 0;
+    int values[4] = {};
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 3; ++i)
+            ASSERT_TRUE(buffer.push(next++));
+        size_t count = buffer.pop(values, 4);
+        ASSERT_EQ(count, 3u);
+        for (size_t i = 0; i < count; ++i)
+            EXPECT_EQ(values[i], expected++);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Concurrency
+//------------------------------------------------------------------------------
+
+TEST(MpscRingBuffer, Concurrent_NoLostTornOrReorderedRecordsPerProducer) {
+    MpscRingBuffer<Record, 64> buffer;
+    const long kNumProducers = 4;
+    const long kNumRecords = 50000;
+    std::atomic<long> finishedProducers{0};
+
+    // Retries on a full buffer so that every record must arrive
+    std::vector<std::thread> producers;
+    for (long p = 0; p < kNumProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (long i = 1; i <= kNumRecords; ++i) {
+                while (!buffer.push(makeRecord(p, i)))
+                    std::this_thread::yield();
+            }
+            finishedProducers.fetch_add(1);
+        });
+    }
+
+    std::vector<long> last(kNumProducers, 0);
+    bool consistent = true;
+    bool sequential = true;
+    Record records[16];
+    for (;;) {
+        bool finished = finishedProducers.load() == kNumProducers;
+        size_t count = buffer.pop(records, 16);
+        for (size_t i = 0; i < count; ++i) {
+            const Record& record = records[i];
+            for (long v : record.values)
+                consistent = consistent && (v == record.values[0]);
+            sequential = sequential && (record.values[0] == last[record.producer] + 1);
+            last[record.producer] = record.values[0];
+        }
+        if (count == 0 && finished)
+            break;
+    }
+    for (std::thread& producer : producers)
+        producer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_TRUE(sequential);
+    for (long p = 0; p < kNumProducers; ++p)
+        EXPECT_EQ(last[p], kNumRecords);
+}
@@ -0,0 +1,94 @@
+// test_pan_law.cpp
+// Unit tests for the pan law policies
+
+#include "pan_law.h"
+#include "mix_matrix.h"
+#include "parameter_utils.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+float centerLevelDb(PanGains gains) {
+    return 20.0f * std::log10(gains.left);
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Center Levels
+//------------------------------------------------------------------------------
+
+TEST(PanLaw, CenterLevels) {
+    EXPECT_NEAR(centerLevelDb(PanLawLinear::gains(0.0f)), -6.02f, 0.01f);
+    EXPECT_NEAR(centerLevelDb(PanLawCompromise::gains(0.0f)), -4.52f, 0.01f);
+    EXPECT_NEAR(centerLevelDb(PanLawConstantPower::gains(0.0f)), -3.01f, 0.01f);
+    EXPECT_NEAR(centerLevelDb(PanLawBalance::gains(0.0f)), 0.0f, 0.01f);
+}
+
+TEST(PanLaw, CenterIsSymmetric) {
+    PanGains linear = PanLawLinear::gains(0.0f);
+    PanGains compromise = PanLawCompromise::gains(0.0f);
+    PanGains balance = PanLawBalance::gains(0.0f);
+
+    EXPECT_FLOAT_EQ(linear.left, linear.right);
+    EXPECT_NEAR(compromise.left, compromise.right, 1.0e-6f);
+    EXPECT_FLOAT_EQ(balance.left, balance.right);
+}
+
+TEST(PanLaw, ConstantPower_MatchesCalculatePanGains) {
+    for (float pan = -100.0f; pan <= 100.0f; pan += 12.5f) {
+        PanGains expected = calculatePanGains(pan);
+        PanGains gains = PanLawConstantPower::gains(pan);
+        EXPECT_NEAR(gains.left, expected.left, 2.0e-6f) << "pan " << pan;
+        EXPECT_NEAR(gains.right, expected.right, 2.0e-6f) << "pan " << pan;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Hard Pan
+//------------------------------------------------------------------------------
+
+template <typename Law>
+void expectExactHardPan() {
+    PanGains left = Law::gains(ParamRange::kPanMin);
+    PanGains right = Law::gains(ParamRange::kPanMax);
+
+    EXPECT_EQ(left.left, 1.0f);
+    EXPECT_EQ(left.right, 0.0f);
+    EXPECT_EQ(right.left, 0.0f);
+    EXPECT_EQ(right.right, 1.0f);
+}
+
+TEST(PanLaw, HardPan_ExactForAllLaws) {
+    expectExactHardPan<PanLawLinear>();
+    expectExactHardPan<PanLawCompromise>();
+    expectExactHardPan<PanLawConstantPower>();
+    expectExactHardPan<PanLawBalance>();
+}
+
+TEST(PanLaw, DefaultPans_CompileToIdentityForAllLaws) {
+    const float unity = dbToNormalized(0.0f);
+    MixMatrix identity = {1.0f, 0.0f, 0.0f, 1.0f};
+
+    EXPECT_TRUE(compileMixMatrix<PanLawLinear>(unity, unity, 0.0f, 1.0f, unity) == identity);
+    EXPECT_TRUE(compileMixMatrix<PanLawCompromise>(unity, unity, 0.0f, 1.0f, unity) == identity);
+    EXPECT_TRUE(compileMixMatrix<PanLawConstantPower>(unity, unity, 0.0f, 1.0f, unity) == identity);
+    EXPECT_TRUE(compileMixMatrix<PanLawBalance>(unity, unity, 0.0f, 1.0f, unity) == identity);
+}
+
+//------------------------------------------------------------------------------
+// Parameter Mapping
+//------------------------------------------------------------------------------
+
+TEST(PanLaw, NormalizedMapping_RoundTrip) {
+    for (int law = 0; law < kPanLawCount; ++law) {
+        EXPECT_EQ(normalizedToPanLaw(panLawToNormalized(law)), law);
+    }
+    EXPECT_EQ(normalizedToPanLaw(0.0), kPanLawLinear);
+    EXPECT_EQ(normalizedToPanLaw(1.0), kPanLawBalance);
+    EXPECT_EQ(normalizedToPanLaw(-0.5), kPanLawLinear);
+    EXPECT_EQ(normalizedToPanLaw(1.5), kPanLawBalance);
+}
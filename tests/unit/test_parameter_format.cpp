@@ -0,0 +1,190 @@
+// test_parameter_format.cpp
+// Unit tests for allocation-free value formatting and parsing
+
+#include "parameter_format.h"
+#include "parameter_table.h"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+std::string panText(float normalized) {
+    char text[kMaxValueTextLength];
+    int length = formatPanText(normalized, text, kMaxValueTextLength);
+    EXPECT_EQ(std::string(text).size(), static_cast<size_t>(length));
+    return text;
+}
+
+std::string gainText(float normalized) {
+    char text[kMaxValueTextLength];
+    formatGainText(normalized, text, kMaxValueTextLength);
+    return text;
+}
+
+std::string delayText(float normalized) {
+    char text[kMaxValueTextLength];
+    formatDelayText(normalized, text, kMaxValueTextLength);
+    return text;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Formatting (same text as the editor labels, without units)
+//------------------------------------------------------------------------------
+
+TEST(ParameterFormat, Pan_SidesAndCenter) {
+    EXPECT_EQ(panText(panToNormalized(0.0f)), "C");
+    EXPECT_EQ(panText(panToNormalized(0.4f)), "C");
+    EXPECT_EQ(panText(panToNormalized(-0.4f)), "C");
+    EXPECT_EQ(panText(panToNormalized(-50.0f)), "L50");
+    EXPECT_EQ(panText(panToNormalized(25.0f)), "R25");
+    EXPECT_EQ(panText(0.0f), "L100");
+    EXPECT_EQ(panText(1.0f), "R100");
+}
+
+TEST(ParameterFormat, Gain_SignedTenthsAndInfinity) {
+    EXPECT_EQ(gainText(dbToNormalized(0.0f)), "+0.0");
+    EXPECT_EQ(gainText(dbToNormalized(6.0f)), "+6.0");
+    EXPECT_EQ(gainText(dbToNormalized(-12.0f)), "-12.0");
+    EXPECT_EQ(gainText(dbToNormalized(-3.5f)), "-3.5");
+    EXPECT_EQ(gainText(dbToNormalized(-59.0f)), "-59.0");
+    EXPECT_EQ(gainText(0.0f), "-\xE2\x88\x9E");
+}
+
+TEST(ParameterFormat, Delay_Tenths) {
+    EXPECT_EQ(delayText(0.0f), "0.0");
+    EXPECT_EQ(delayText(delayMsToNormalized(0.5f)), "0.5");
+    EXPECT_EQ(delayText(delayMsToNormalized(25.5f)), "25.5");
+    EXPECT_EQ(delayText(1.0f), "100.0");
+}
+
+TEST(ParameterFormat, Toggle_OnOff) {
+    char text[kMaxValueTextLength];
+    formatToggleText(1.0, text, kMaxValueTextLength);
+    EXPECT_STREQ(text, "On");
+    formatToggleText(0.0, text, kMaxValueTextLength);
+    EXPECT_STREQ(text, "Off");
+}
+
+TEST(ParameterFormat, Utf16_WritesInfinitySymbol) {
+    char16_t text[kMaxValueTextLength];
+    int length = formatGainText(0.0f, text, kMaxValueTextLength);
+    ASSERT_EQ(length, 2);
+    EXPECT_EQ(text[0], u'-');
+    EXPECT_EQ(text[1], u'∞');
+    EXPECT_EQ(text[2], 0);
+
+    formatPanText(panToNormalized(-30.0f), text, kMaxValueTextLength);
+    EXPECT_EQ(std::u16string(text), u"L30");
+}
+
+TEST(ParameterFormat, SmallBuffer_TruncatesAndTerminates) {
+    char text[4];
+    int length = formatGainText(dbToNormalized(-12.5f), text, 4);
+    EXPECT_EQ(length, 3);
+    EXPECT_STREQ(text, "-12");
+}
+
+//------------------------------------------------------------------------------
+// Parsing
+//------------------------------------------------------------------------------
+
+TEST(ParameterFormat, ParsePan_AcceptsFormattedAndPlainValues) {
+    float normalized = -1.0f;
+    ASSERT_TRUE(parsePanText("C", normalized));
+    EXPECT_FLOAT_EQ(normalized, panToNormalized(0.0f));
+    ASSERT_TRUE(parsePanText(" center ", normalized));
+    EXPECT_FLOAT_EQ(normalized, panToNormalized(0.0f));
+    ASSERT_TRUE(parsePanText("L50", normalized));
+    EXPECT_FLOAT_EQ(normalized, panToNormalized(-50.0f));
+    ASSERT_TRUE(parsePanText("r 25", normalized));
+    EXPECT_FLOAT_EQ(normalized, panToNormalized(25.0f));
+    ASSERT_TRUE(parsePanText("-75.5", normalized));
+    EXPECT_FLOAT_EQ(normalized, panToNormalized(-75.5f));
+    ASSERT_TRUE(parsePanText("R250", normalized));
+    EXPECT_FLOAT_EQ(normalized, 1.0f);
+
+    EXPECT_FALSE(parsePanText("", normalized));
+    EXPECT_FALSE(parsePanText("L", normalized));
+    EXPECT_FALSE(parsePanText("abc", normalized));
+    EXPECT_FALSE(parsePanText("C5", normalized));
+}
+
+TEST(ParameterFormat, ParseGain_AcceptsUnitsAndInfinity) {
+    float normalized = -1.0f;
+    ASSERT_TRUE(parseGainText("-6", normalized));
+    EXPECT_FLOAT_EQ(normalized, dbToNormalized(-6.0f));
+    ASSERT_TRUE(parseGainText("+3.0 dB", normalized));
+    EXPECT_FLOAT_EQ(normalized, dbToNormalized(3.0f));
+    ASSERT_TRUE(parseGainText("12db", normalized));
+    EXPECT_FLOAT_EQ(normalized, 1.0f);
+    ASSERT_TRUE(parseGainText("-\xE2\x88\x9E dB", normalized));
+    EXPECT_FLOAT_EQ(normalized, 0.0f);
+    ASSERT_TRUE(parseGainText("-inf", normalized));
+    EXPECT_FLOAT_EQ(normalized, 0.0f);
+    ASSERT_TRUE(parseGainText(u"-∞", normalized));
+    EXPECT_FLOAT_EQ(normalized, 0.0f);
+
+    EXPECT_FALSE(parseGainText("loud", normalized));
+    EXPECT_FALSE(parseGainText("-6 ms", normalized));
+}
+
+TEST(ParameterFormat, ParseDelayAndToggle) {
+    float delay = -1.0f;
+    ASSERT_TRUE(parseDelayText("25.5 ms", delay));
+    EXPECT_FLOAT_EQ(delay, delayMsToNormalized(25.5f));
+    ASSERT_TRUE(parseDelayText(u"10", delay));
+    EXPECT_FLOAT_EQ(delay, delayMsToNormalized(10.0f));
+    EXPECT_FALSE(parseDelayText("ms", delay));
+
+    double toggle = -1.0;
+    ASSERT_TRUE(parseToggleText("On", toggle));
+    EXPECT_EQ(toggle, 1.0);
+    ASSERT_TRUE(parseToggleText(u"off", toggle));
+    EXPECT_EQ(toggle, 0.0);
+    ASSERT_TRUE(parseToggleText("1", toggle));
+    EXPECT_EQ(toggle, 1.0);
+    EXPECT_FALSE(parseToggleText("maybe", toggle));
+}
+
+TEST(ParameterFormat, Percent_PlainValueInTableRange) {
+    const ParamDescriptor& morph = kParamTable[kParamMorph];
+
+    char text[kMaxValueTextLength];
+    formatPercentText(normalizedToPlain(morph, 0.5), text, kMaxValueTextLength);
+    EXPECT_EQ(std::string(text), "50.0");
+    formatPercentText(normalizedToPlain(morph, 1.0), text, kMaxValueTextLength);
+    EXPECT_EQ(std::string(text), "100.0");
+
+    double percent = -1.0;
+    ASSERT_TRUE(parsePercentText("50", percent));
+    EXPECT_DOUBLE_EQ(plainToNormalized(morph, percent), 0.5);
+    ASSERT_TRUE(parsePercentText(u"12.5 %", percent));
+    EXPECT_DOUBLE_EQ(percent, 12.5);
+    EXPECT_FALSE(parsePercentText("half", percent));
+    EXPECT_FALSE(parsePercentText("50 ms", percent));
+}
+
+TEST(ParameterFormat, RoundTrip_FormattedTextParsesBack) {
+    for (int i = 0; i <= 200; ++i) {
+        float normalized = i / 200.0f;
+        char text[kMaxValueTextLength];
+        float parsed = -1.0f;
+
+        formatPanText(normalized, text, kMaxValueTextLength);
+        ASSERT_TRUE(parsePanText(text, parsed)) << text;
+        EXPECT_NEAR(normalizedToPan(parsed), normalizedToPan(normalized), 0.5f) << text;
+
+        formatGainText(normalized, text, kMaxValueTextLength);
+        ASSERT_TRUE(parseGainText(text, parsed)) << text;
+        EXPECT_NEAR(normalizedToDb(parsed), normalizedToDb(normalized), 0.05f) << text;
+
+        formatDelayText(normalized, text, kMaxValueTextLength);
+        ASSERT_TRUE(parseDelayText(text, parsed)) << text;
+        EXPECT_NEAR(normalizedToDelayMs(parsed), normalizedToDelayMs(normalized), 0.05f) << text;
+    }
+}
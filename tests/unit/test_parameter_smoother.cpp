@@ -321,3 +321,52 @@ TEST(ParameterSmoother, GetCurrentValue_ReturnsLastValue) {
 
     EXPECT_FLOAT_EQ(smoother.getCurrentValue(), value);
 }
+
+//------------------------------------------------------------------------------
+// Block Advance Tests
+//------------------------------------------------------------------------------
+
+TEST(ParameterSmoother, Advance_MatchesRepeatedGetNext) {
+    ParameterSmoother perSample;
+    ParameterSmoother block;
+    perSample.setSampleRate(48000.0);
+    block.setSampleRate(48000.0);
+    perSample.reset(0.2f);
+    block.reset(0.2f);
+    perSample.setTarget(0.9f);
+    block.setTarget(0.9f);
+
+    for (int b = 0; b < 10; ++b) {
+        float expected = 0.0f;
+        for (int i = 0; i < 64; ++i) {
+            expected = perSample.getNext();
+        }
+        EXPECT_NEAR(block.advance(64), expected, 1.0e-4f);
+    }
+}
+
+TEST(ParameterSmoother, Advance_ZeroSamples_NoChange) {
+    ParameterSmoother smoother;
+    smoother.setSampleRate(48000.0);
+    smoother.reset(0.3f);
+    smoother.setTarget(1.0f);
+
+    EXPECT_FLOAT_EQ(smoother.advance(0), 0.3f);
+    EXPECT_FLOAT_EQ(smoother.getCurrentValue(), 0.3f);
+}
+
+TEST(ParameterSmoother, Advance_SampleRateChange_UpdatesDecay) {
+    ParameterSmoother smoother;
+    smoother.setSampleRate(48000.0);
+    smoother.reset(0.0f);
+    smoother.setTarget(1.0f);
+    float at48k = smoother.advance(48);
+
+    smoother.setSampleRate(96000.0);
+    smoother.reset(0.0f);
+    smoother.setTarget(1.0f);
+    float at96k = smoother.advance(48);
+
+    // The same sample count covers half the time at the higher rate
+    EXPECT_LT(at96k, at48k);
+}
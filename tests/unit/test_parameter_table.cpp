@@ -0,0 +1,94 @@
+// test_parameter_table.cpp
+// Unit tests for the parameter descriptor table and its generated conversions
+
+#include "parameter_table.h"
+#include "parameter_utils.h"
+#include "state_serializer.h"
+#include <gtest/gtest.h>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+
+//------------------------------------------------------------------------------
+// Table layout
+//------------------------------------------------------------------------------
+
+TEST(ParameterTable, RowsAreIndexedById) {
+    for (int32 i = 0; i < static_cast<int32>(kParamCount); ++i)
+        EXPECT_EQ(kParamTable[i].id, static_cast<Vst::ParamID>(i));
+}
+
+TEST(ParameterTable, ListRowsHaveOneEntryPerStep) {
+    for (const ParamDescriptor& param : kParamTable) {
+        if (param.format != kFormatList)
+            continue;
+        ASSERT_NE(param.listEntries, nullptr) << param.id;
+        for (int32 i = 0; i <= param.stepCount; ++i)
+            EXPECT_NE(param.listEntries[i], nullptr) << param.id << " step " << i;
+    }
+    EXPECT_EQ(kParamTable[kParamPanLaw].stepCount, kPanLawCount - 1);
+}
+
+TEST(ParameterTable, SelectParams_KeepsIdOrder) {
+    constexpr ParamIdList smoothed = selectParams(
+        [](const ParamDescriptor& param) { return param.smoothed; });
+
+    ASSERT_EQ(smoothed.count, 6);
+    EXPECT_EQ(smoothed.ids[0], kParamLeftPan);
+    EXPECT_EQ(smoothed.ids[1], kParamLeftGain);
+    EXPECT_EQ(smoothed.ids[2], kParamRightPan);
+    EXPECT_EQ(smoothed.ids[3], kParamRightGain);
+    EXPECT_EQ(smoothed.ids[4], kParamMasterGain);
+    EXPECT_EQ(smoothed.ids[5], kParamMorph);
+}
+
+//------------------------------------------------------------------------------
+// Generated conversions
+//------------------------------------------------------------------------------
+
+TEST(ParameterTable, Defaults_MatchPerUnitConversions) {
+    // Exact: the state defaults must not change with the table
+    EXPECT_EQ(defaultNormalized(kParamTable[kParamLeftPan]), panToNormalized(ParamDefault::kLeftPan));
+    EXPECT_EQ(defaultNormalized(kParamTable[kParamRightPan]), panToNormalized(ParamDefault::kRightPan));
+    EXPECT_EQ(defaultNormalized(kParamTable[kParamLeftGain]), dbToNormalized(ParamDefault::kLeftGain));
+    EXPECT_EQ(defaultNormalized(kParamTable[kParamMasterGain]), dbToNormalized(ParamDefault::kMasterGain));
+    EXPECT_EQ(defaultNormalized(kParamTable[kParamLeftDelay]), delayMsToNormalized(ParamDefault::kLeftDelay));
+    EXPECT_EQ(defaultNormalized(kParamTable[kParamLinkGain]), ParamDefault::kLinkGain);
+    EXPECT_EQ(defaultNormalized(kParamTable[kParamPanLaw]), panLawToNormalized(ParamDefault::kPanLaw));
+    EXPECT_EQ(defaultNormalized(kParamTable[kParamMorph]), ParamDefault::kMorph);
+}
+
+TEST(ParameterTable, Continuous_MatchesPerUnitConversions) {
+    for (int i = 0; i <= 100; ++i) {
+        float normalized = i / 100.0f;
+        EXPECT_FLOAT_EQ(normalizedToPlain(kParamTable[kParamLeftPan], normalized), normalizedToPan(normalized));
+        EXPECT_FLOAT_EQ(normalizedToPlain(kParamTable[kParamLeftGain], normalized), normalizedToDb(normalized));
+        EXPECT_FLOAT_EQ(normalizedToPlain(kParamTable[kParamLeftDelay], normalized), normalizedToDelayMs(normalized));
+    }
+    EXPECT_EQ(plainToNormalized(kParamTable[kParamLeftGain], -6.0), dbToNormalized(-6.0f));
+    EXPECT_EQ(plainToNormalized(kParamTable[kParamRightPan], 25.0), panToNormalized(25.0f));
+}
+
+TEST(ParameterTable, Stepped_MatchesVstStepMapping) {
+    const ParamDescriptor& panLaw = kParamTable[kParamPanLaw];
+    for (int law = 0; law < kPanLawCount; ++law) {
+        double normalized = plainToNormalized(panLaw, law);
+        EXPECT_EQ(normalized, panLawToNormalized(law));
+        EXPECT_EQ(normalizedToPlain(panLaw, normalized), law);
+        EXPECT_EQ(static_cast<int>(normalizedToPlain(panLaw, normalized)), normalizedToPanLaw(normalized));
+    }
+    EXPECT_EQ(normalizedToPlain(panLaw, 0.0), 0.0);
+    EXPECT_EQ(normalizedToPlain(panLaw, 1.0), kPanLawCount - 1);
+
+    const ParamDescriptor& link = kParamTable[kParamLinkGain];
+    EXPECT_EQ(normalizedToPlain(link, 0.49), 0.0);
+    EXPECT_EQ(normalizedToPlain(link, 0.5), 1.0);
+}
+
+TEST(ParameterTable, StateDefaults_ComeFromTable) {
+    PluginState state = PluginState::defaults();
+    for (const ParamDescriptor& param : kParamTable) {
+        EXPECT_EQ(state.values[param.id], defaultNormalized(param)) << param.id;
+        EXPECT_EQ(state.values[kStateSnapshotB + param.id], defaultNormalized(param)) << param.id;
+    }
+}
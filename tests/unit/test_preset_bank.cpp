@@ -0,0 +1,212 @@
+// test_preset_bank.cpp
+// Unit tests for the preset bank format and its memory-mapped loading
+
+#include "preset_bank.h"
+#include "mapped_file.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+PresetBankEntry makeEntry(const std::string& name, double base) {
+    PresetBankEntry entry;
+    entry.name = name;
+    entry.state = PluginState::defaults();
+    for (int32 i = 0; i < StateSerializer::kNumParams; ++i)
+        entry.state.values[i] = base + 0.01 * i;
+    return entry;
+}
+
+std::string tempPath(const char* name) {
+    const char* dir = std::getenv("TMPDIR");
+#if defined(_WIN32)
+    if (!dir)
+        dir = std::getenv("TEMP");
+#endif
+    return std::string(dir ? dir : "/tmp") + "/" + name;
+}
+
+bool writeFile(const std::string& path, const std::vector<uint8>& data) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    size_t written = std::fwrite(data.data(), 1, data.size(), file);
+    std::fclose(file);
+    return written == data.size();
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Build / Attach
+//------------------------------------------------------------------------------
+
+TEST(PresetBank, Build_RoundTripsNamesAndValues) {
+    std::vector<PresetBankEntry> entries = {makeEntry("Wide", 0.1), makeEntry("Mono", 0.5)};
+    std::vector<uint8> data = PresetBank::build(entries);
+
+    PresetBank bank;
+    ASSERT_TRUE(bank.attach(data.data(), data.size()));
+    ASSERT_EQ(bank.count(), 2);
+    EXPECT_EQ(bank.numFields(), StateSerializer::kNumParams);
+    EXPECT_EQ(bank.name(0), "Wide");
+    EXPECT_EQ(bank.name(1), "Mono");
+
+    for (int32 p = 0; p < 2; ++p) {
+        PluginState state = PluginState::defaults();
+        ASSERT_TRUE(bank.load(p, state));
+        for (int32 i = 0; i < StateSerializer::kNumParams; ++i)
+            EXPECT_EQ(state.values[i], entries[p].state.values[i]) << "preset " << p << " field " << i;
+    }
+}
+
+TEST(PresetBank, Build_RecordsHaveFixedSize) {
+    std::vector<PresetBankEntry> entries(3, makeEntry("A", 0.2));
+    std::vector<uint8> data = PresetBank::build(entries);
+
+    size_t recordSize = PresetBank::kNameSize + StateSerializer::kNumParams * sizeof(double);
+    EXPECT_EQ(data.size(), PresetBank::kHeaderSize + 3 * recordSize);
+}
+
+TEST(PresetBank, Build_TruncatesLongNames) {
+    std::string longName(100, 'x');
+    std::vector<uint8> data = PresetBank::build({makeEntry(longName, 0.3)});
+
+    PresetBank bank;
+    ASSERT_TRUE(bank.attach(data.data(), data.size()));
+    EXPECT_EQ(bank.name(0), std::string(PresetBank::kNameSize - 1, 'x'));
+}
+
+TEST(PresetBank, Attach_EmptyBankIsValid) {
+    std::vector<uint8> data = PresetBank::build({});
+
+    PresetBank bank;
+    EXPECT_TRUE(bank.attach(data.data(), data.size()));
+    EXPECT_EQ(bank.count(), 0);
+}
+
+TEST(PresetBank, Attach_RejectsBadMagicVersionAndTruncation) {
+    std::vector<uint8> data = PresetBank::build({makeEntry("A", 0.1), makeEntry("B", 0.2)});
+    PresetBank bank;
+
+    std::vector<uint8> badMagic = data;
+    badMagic[0] = 'X';
+    EXPECT_FALSE(bank.attach(badMagic.data(), badMagic.size()));
+
+    std::vector<uint8> badVersion = data;
+    badVersion[4] = 2;
+    EXPECT_FALSE(bank.attach(badVersion.data(), badVersion.size()));
+
+    EXPECT_FALSE(bank.attach(data.data(), data.size() - 1));
+    EXPECT_FALSE(bank.attach(data.data(), PresetBank::kHeaderSize - 1));
+    EXPECT_FALSE(bank.attach(nullptr, 0));
+    EXPECT_FALSE(bank.isAttached());
+}
+
+TEST(PresetBank, Attach_RejectsTooFewFields) {
+    std::vector<uint8> data = PresetBank::build({makeEntry("A", 0.1)});
+    data[12] = static_cast<uint8>(StateSerializer::kVersion1Fields - 1);
+
+    PresetBank bank;
+    EXPECT_FALSE(bank.attach(data.data(), data.size()));
+}
+
+TEST(PresetBank, Load_Version1LayoutKeepsMissingFields) {
+    // Bank written with only the 8 v1 parameters (no Pan Law)
+    const int32 numFields = StateSerializer::kVersion1Fields;
+    std::vector<uint8> data(PresetBank::kHeaderSize + PresetBank::kNameSize + numFields * sizeof(double), 0);
+    uint8* out = data.data();
+    out = StateSerializer::storeUInt32(out, PresetBank::kMagic);
+    out = StateSerializer::storeUInt32(out, PresetBank::kVersion);
+    out = StateSerializer::storeUInt32(out, 1);
+    out = StateSerializer::storeUInt32(out, numFields);
+    out += PresetBank::kNameSize;
+    for (int32 i = 0; i < numFields; ++i)
+        out = StateSerializer::storeDouble(out, 0.25);
+
+    PresetBank bank;
+    ASSERT_TRUE(bank.attach(data.data(), data.size()));
+
+    PluginState state = PluginState::defaults();
+    state.values[kParamPanLaw] = panLawToNormalized(kPanLawBalance);
+    ASSERT_TRUE(bank.load(0, state));
+    EXPECT_EQ(state.values[kParamLeftPan], 0.25);
+    EXPECT_EQ(state.values[kParamLinkGain], 0.25);
+    EXPECT_EQ(state.values[kParamPanLaw], panLawToNormalized(kPanLawBalance));
+    EXPECT_EQ(bank.name(0), "");
+}
+
+TEST(PresetBank, Load_InvalidIndexLeavesStateUntouched) {
+    std::vector<uint8> data = PresetBank::build({makeEntry("A", 0.1)});
+    PresetBank bank;
+    ASSERT_TRUE(bank.attach(data.data(), data.size()));
+
+    PluginState state = PluginState::defaults();
+    EXPECT_FALSE(bank.load(-1, state));
+    EXPECT_FALSE(bank.load(1, state));
+    EXPECT_EQ(state.values[kParamLeftPan], PluginState::defaults().values[kParamLeftPan]);
+    EXPECT_EQ(bank.name(1), "");
+}
+
+//------------------------------------------------------------------------------
+// Program Index Conversion
+//------------------------------------------------------------------------------
+
+TEST(PresetBank, ProgramConversion_RoundTrips) {
+    for (int count : {1, 2, 7, 10000}) {
+        for (int program = 0; program < count; program += std::max(1, count / 50))
+            EXPECT_EQ(normalizedToProgram(programToNormalized(program, count), count), program)
+                << "program " << program << " of " << count;
+    }
+    EXPECT_EQ(normalizedToProgram(1.0, 10000), 9999);
+    EXPECT_EQ(normalizedToProgram(-0.5, 10), 0);
+    EXPECT_EQ(normalizedToProgram(1.5, 10), 9);
+    EXPECT_EQ(normalizedToProgram(0.7, 1), 0);
+}
+
+//------------------------------------------------------------------------------
+// Memory-Mapped File
+//------------------------------------------------------------------------------
+
+TEST(PresetBank, MappedFile_LoadsBankInPlace) {
+    std::vector<PresetBankEntry> entries;
+    for (int i = 0; i < 10000; ++i)
+        entries.push_back(makeEntry("Preset " + std::to_string(i), (i % 50) * 0.01));
+    std::string path = tempPath("simplepanner_test_bank.sppb");
+    ASSERT_TRUE(writeFile(path, PresetBank::build(entries)));
+
+    MappedFile file;
+    ASSERT_TRUE(file.open(path.c_str()));
+
+    PresetBank bank;
+    ASSERT_TRUE(bank.attach(file.data(), file.size()));
+    ASSERT_EQ(bank.count(), 10000);
+    EXPECT_EQ(bank.name(9999), "Preset 9999");
+
+    PluginState state = PluginState::defaults();
+    ASSERT_TRUE(bank.load(4321, state));
+    EXPECT_EQ(state.values[kParamLeftPan], entries[4321].state.values[kParamLeftPan]);
+
+    bank.detach();
+    file.close();
+    EXPECT_FALSE(file.isOpen());
+    std::remove(path.c_str());
+}
+
+TEST(PresetBank, MappedFile_MissingOrEmptyFileFails) {
+    MappedFile file;
+    EXPECT_FALSE(file.open(nullptr));
+    EXPECT_FALSE(file.open(""));
+    EXPECT_FALSE(file.open(tempPath("simplepanner_missing_bank.sppb").c_str()));
+
+    std::string path = tempPath("simplepanner_empty_bank.sppb");
+    ASSERT_TRUE(writeFile(path, {}));
+    EXPECT_FALSE(file.open(path.c_str()));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,142 @@
+// test_preset_table.cpp
+// Unit tests for the program table shared by processor instances of one bank
+
+#include "preset_table.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+std::string tempPath(const char* name) {
+    const char* dir = std::getenv("TMPDIR");
+#if defined(_WIN32)
+    if (!dir)
+        dir = std::getenv("TEMP");
+#endif
+    return std::string(dir ? dir : "/tmp") + "/" + name;
+}
+
+// Write a bank whose preset i has Master Gain base + 0.1 * i
+std::string writeBank(const char* name, int count, double base) {
+    std::vector<PresetBankEntry> entries;
+    for (int i = 0; i < count; ++i) {
+        PresetBankEntry entry = {"Preset", PluginState::defaults()};
+        entry.state.values[kParamMasterGain] = base + 0.1 * i;
+        entries.push_back(entry);
+    }
+    std::vector<uint8> data = PresetBank::build(entries);
+
+    std::string path = tempPath(name);
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return std::string();
+    std::fwrite(data.data(), 1, data.size(), file);
+    std::fclose(file);
+    return path;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Contents
+//------------------------------------------------------------------------------
+
+TEST(PresetTable, Default_SingleProgramOfDefaults) {
+    std::shared_ptr<const PresetTable> table = PresetTable::defaults();
+    ASSERT_EQ(table->count(), 1);
+    EXPECT_EQ(table->numFields(), StateSerializer::kNumParams);
+    EXPECT_EQ(table->checksum(), 0u);
+    for (int32 i = 0; i < StateSerializer::kNumParams; ++i)
+        EXPECT_EQ(table->program(0).values[i], PluginState::defaults().values[i]);
+
+    // One table for every caller
+    EXPECT_EQ(PresetTable::defaults(), table);
+}
+
+TEST(PresetTable, Share_CopiesEveryPreset) {
+    std::string path = writeBank("simplepanner_table_copy.sppb", 3, 0.2);
+    ASSERT_FALSE(path.empty());
+
+    std::shared_ptr<const PresetTable> table = PresetTable::share(path.c_str());
+    std::remove(path.c_str());
+
+    // The copy outlives the file
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->count(), 3);
+    EXPECT_EQ(table->numFields(), StateSerializer::kNumParams);
+    EXPECT_NE(table->checksum(), 0u);
+    for (int32 i = 0; i < 3; ++i)
+        EXPECT_DOUBLE_EQ(table->program(i).values[kParamMasterGain], 0.2 + 0.1 * i);
+}
+
+TEST(PresetTable, Share_MissingOrEmptyBankFails) {
+    EXPECT_EQ(PresetTable::share(nullptr), nullptr);
+    EXPECT_EQ(PresetTable::share(""), nullptr);
+    EXPECT_EQ(PresetTable::share(tempPath("simplepanner_table_missing.sppb").c_str()), nullptr);
+
+    std::string path = writeBank("simplepanner_table_empty.sppb", 0, 0.0);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(PresetTable::share(path.c_str()), nullptr);
+    std::remove(path.c_str());
+}
+
+//------------------------------------------------------------------------------
+// Sharing
+//------------------------------------------------------------------------------
+
+TEST(PresetTable, Share_SamePathSharesOneCopy) {
+    std::string path = writeBank("simplepanner_table_shared.sppb", 2, 0.3);
+    ASSERT_FALSE(path.empty());
+
+    std::shared_ptr<const PresetTable> first = PresetTable::share(path.c_str());
+    ASSERT_NE(first, nullptr);
+
+    // Rewritten on disk: a holder keeps the first copy alive, so it is reused
+    writeBank("simplepanner_table_shared.sppb", 4, 0.5);
+    std::shared_ptr<const PresetTable> second = PresetTable::share(path.c_str());
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(second->count(), 2);
+
+    std::remove(path.c_str());
+}
+
+TEST(PresetTable, Share_ReloadedOnceNobodyHoldsIt) {
+    std::string path = writeBank("simplepanner_table_reload.sppb", 2, 0.3);
+    ASSERT_FALSE(path.empty());
+
+    std::weak_ptr<const PresetTable> released = PresetTable::share(path.c_str());
+    EXPECT_TRUE(released.expired());
+
+    writeBank("simplepanner_table_reload.sppb", 4, 0.5);
+    std::shared_ptr<const PresetTable> reloaded = PresetTable::share(path.c_str());
+    ASSERT_NE(reloaded, nullptr);
+    EXPECT_EQ(reloaded->count(), 4);
+    EXPECT_DOUBLE_EQ(reloaded->program(0).values[kParamMasterGain], 0.5);
+
+    std::remove(path.c_str());
+}
+
+TEST(PresetTable, Share_DifferentPathsAreSeparate) {
+    std::string pathA = writeBank("simplepanner_table_a.sppb", 1, 0.1);
+    std::string pathB = writeBank("simplepanner_table_b.sppb", 1, 0.9);
+    ASSERT_FALSE(pathA.empty());
+    ASSERT_FALSE(pathB.empty());
+
+    std::shared_ptr<const PresetTable> tableA = PresetTable::share(pathA.c_str());
+    std::shared_ptr<const PresetTable> tableB = PresetTable::share(pathB.c_str());
+    ASSERT_NE(tableA, nullptr);
+    ASSERT_NE(tableB, nullptr);
+    EXPECT_NE(tableA, tableB);
+    EXPECT_NE(tableA->checksum(), tableB->checksum());
+    EXPECT_DOUBLE_EQ(tableA->program(0).values[kParamMasterGain], 0.1);
+    EXPECT_DOUBLE_EQ(tableB->program(0).values[kParamMasterGain], 0.9);
+
+    std::remove(pathA.c_str());
+    std::remove(pathB.c_str());
+}
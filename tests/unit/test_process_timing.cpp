@@ -0,0 +1,212 @@
+// test_process_timing.cpp
+// Unit tests for the per-block process() timing statistics
+
+#include "process_timing.h"
+#include <gtest/gtest.h>
+#include <clocale>
+#include <string>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+
+//------------------------------------------------------------------------------
+// Histogram buckets
+//------------------------------------------------------------------------------
+
+TEST(ProcessTiming, Buckets_ExactBelowSixteenNanoseconds) {
+    for (uint64 nanos = 0; nanos < 16; ++nanos) {
+        EXPECT_EQ(ProcessTimingStats::bucketOf(nanos), static_cast<int>(nanos));
+        EXPECT_EQ(ProcessTimingStats::bucketUpperBound(ProcessTimingStats::bucketOf(nanos)), nanos);
+    }
+}
+
+TEST(ProcessTiming, Buckets_ContainTheirDurations) {
+    for (uint64 nanos = 16; nanos < (uint64(1) << 40); nanos = nanos * 3 / 2 + 1) {
+        int bucket = ProcessTimingStats::bucketOf(nanos);
+        ASSERT_LT(bucket, ProcessTimingStats::kNumBuckets);
+        EXPECT_GE(ProcessTimingStats::bucketUpperBound(bucket), nanos);
+        EXPECT_LT(ProcessTimingStats::bucketUpperBound(bucket - 1), nanos);
+
+        // Within 1/8 octave
+        EXPECT_LE(ProcessTimingStats::bucketUpperBound(bucket), nanos + nanos / 8);
+    }
+    EXPECT_EQ(ProcessTimingStats::bucketOf(~uint64(0)), ProcessTimingStats::kNumBuckets - 1);
+    EXPECT_EQ(ProcessTimingStats::bucketUpperBound(ProcessTimingStats::kNumBuckets - 1), ~uint64(0));
+}
+
+//------------------------------------------------------------------------------
+// Summary
+//------------------------------------------------------------------------------
+
+TEST(ProcessTiming, Summary_EmptyPeriodHasNoData) {
+    ProcessTimingStats stats;
+    ProcessTimingSummary summary = stats.summarize(48000.0);
+    EXPECT_EQ(summary.blocks, 0);
+    EXPECT_EQ(summary.maxMicros, 0.0);
+}
+
+TEST(ProcessTiming, Summary_MinMeanMaxAndLoad) {
+    ProcessTimingStats stats;
+    stats.add(10000, 480);   // 10 µs per 10 ms block
+    stats.add(20000, 480);
+    stats.add(30000, 480);
+
+    ProcessTimingSummary summary = stats.summarize(48000.0);
+    EXPECT_EQ(summary.blocks, 3);
+    EXPECT_DOUBLE_EQ(summary.minMicros, 10.0);
+    EXPECT_DOUBLE_EQ(summary.meanMicros, 20.0);
+    EXPECT_DOUBLE_EQ(summary.maxMicros, 30.0);
+    EXPECT_DOUBLE_EQ(summary.p99Micros, 30.0);  // Clamped to the maximum
+    EXPECT_NEAR(summary.load, 60.0e-6 / 30.0e-3, 1.0e-12);
+}
+
+TEST(ProcessTiming, Summary_P99IgnoresTheSlowestPercent) {
+    ProcessTimingStats stats;
+    for (int i = 0; i < 990; ++i)
+        stats.add(5000, 64);
+    for (int i = 0; i < 10; ++i)
+        stats.add(900000, 64);
+
+    ProcessTimingSummary summary = stats.summarize(48000.0);
+    EXPECT_GE(summary.p99Micros, 5.0);
+    EXPECT_LE(summary.p99Micros, 5.0 * 1.125);
+    EXPECT_DOUBLE_EQ(summary.maxMicros, 900.0);
+
+    // One more slow block pushes the 99th percentile into the slow bucket
+    stats.add(900000, 64);
+    EXPECT_GT(stats.summarize(48000.0).p99Micros, 800.0);
+}
+
+TEST(ProcessTiming, Clear_StartsNewPeriod) {
+    ProcessTimingStats stats;
+    stats.add(1000000, 512);
+    stats.clear();
+    stats.add(2000, 512);
+
+    ProcessTimingSummary summary = stats.summarize(48000.0);
+    EXPECT_EQ(summary.blocks, 1);
+    EXPECT_EQ(stats.numSamples(), 512);
+    EXPECT_DOUBLE_EQ(summary.maxMicros, 2.0);
+    EXPECT_DOUBLE_EQ(summary.minMicros, 2.0);
+}
+
+//------------------------------------------------------------------------------
+// Deadline watchdog
+//------------------------------------------------------------------------------
+
+TEST(ProcessTiming, Deadline_UseIsTimeOverBlockDuration) {
+    DeadlineWatchdog watchdog;
+    // 480 samples at 48 kHz: 10 ms deadline
+    EXPECT_DOUBLE_EQ(watchdog.add(1000000, 480, 48000.0), 0.1);
+    EXPECT_DOUBLE_EQ(watchdog.add(20000000, 480, 48000.0), 2.0);
+    EXPECT_DOUBLE_EQ(watchdog.add(500000, 96, 96000.0), 0.5);
+}
+
+TEST(ProcessTiming, Deadline_CountsBlocksOverEachThreshold) {
+    DeadlineWatchdog watchdog;
+    watchdog.add(500000, 480, 48000.0);     //  5 %
+    watchdog.add(2000000, 480, 48000.0);    // 20 %: over 10 %
+    watchdog.add(6000000, 480, 48000.0);    // 60 %: over 10 %, 50 %
+    watchdog.add(12000000, 480, 48000.0);   // 120 %: over all
+    watchdog.add(1000000, 480, 48000.0);    // Exactly 10 %: not over
+
+    DeadlineCounters counters = watchdog.counters();
+    EXPECT_EQ(counters.blocks, 5);
+    EXPECT_EQ(counters.exceeded[0], 3);
+    EXPECT_EQ(counters.exceeded[1], 2);
+    EXPECT_EQ(counters.exceeded[2], 1);
+    EXPECT_DOUBLE_EQ(counters.worstUse, 1.2);
+    for (int32 level = 0; level < kDeadlineLevels; ++level)
+        EXPECT_EQ(counters.thresholds[level], kDefaultDeadlineThresholds[level]);
+}
+
+TEST(ProcessTiming, Deadline_BlocksWithoutAudioAreIgnored) {
+    DeadlineWatchdog watchdog;
+    EXPECT_EQ(watchdog.add(5000000, 0, 48000.0), 0.0);
+    EXPECT_EQ(watchdog.add(5000000, 480, 0.0), 0.0);
+    EXPECT_EQ(watchdog.counters().blocks, 0);
+    EXPECT_EQ(watchdog.counters().exceeded[0], 0);
+}
+
+TEST(ProcessTiming, Deadline_SummaryHasPeriodMaximumAndTotals) {
+    DeadlineWatchdog watchdog;
+    watchdog.add(6000000, 480, 48000.0);
+    watchdog.add(3000000, 480, 48000.0);
+
+    ProcessTimingSummary summary = {};
+    watchdog.summarize(summary);
+    EXPECT_DOUBLE_EQ(summary.maxDeadlineUse, 0.6);
+    EXPECT_EQ(summary.deadlineExceeded[0], 2);
+    EXPECT_EQ(summary.deadlineExceeded[1], 1);
+    EXPECT_EQ(summary.deadlineExceeded[2], 0);
+
+    // The maximum is per period, the counts are not
+    watchdog.add(1500000, 480, 48000.0);
+    watchdog.summarize(summary);
+    EXPECT_DOUBLE_EQ(summary.maxDeadlineUse, 0.15);
+    EXPECT_EQ(summary.deadlineExceeded[0], 3);
+    EXPECT_DOUBLE_EQ(watchdog.counters().worstUse, 0.6);
+
+    watchdog.reset();
+    EXPECT_EQ(watchdog.counters().blocks, 0);
+    EXPECT_EQ(watchdog.counters().exceeded[0], 0);
+    EXPECT_EQ(watchdog.counters().worstUse, 0.0);
+}
+
+TEST(ProcessTiming, Deadline_CustomThresholds) {
+    const double kThresholds[kDeadlineLevels] = {0.25, 0.75, 0.9};
+    DeadlineWatchdog watchdog;
+    watchdog.setThresholds(kThresholds);
+    watchdog.add(2000000, 480, 48000.0);    // 20 %
+    watchdog.add(8000000, 480, 48000.0);    // 80 %
+
+    DeadlineCounters counters = watchdog.counters();
+    EXPECT_EQ(counters.exceeded[0], 1);
+    EXPECT_EQ(counters.exceeded[1], 1);
+    EXPECT_EQ(counters.exceeded[2], 0);
+    EXPECT_EQ(counters.thresholds[1], 0.75);
+}
+
+TEST(ProcessTiming, ParseDeadlineThresholds_Percentages) {
+    double thresholds[kDeadlineLevels] = {};
+    ASSERT_TRUE(parseDeadlineThresholds("20,75,100", thresholds));
+    EXPECT_DOUBLE_EQ(thresholds[0], 0.2);
+    EXPECT_DOUBLE_EQ(thresholds[1], 0.75);
+    EXPECT_DOUBLE_EQ(thresholds[2], 1.0);
+
+    ASSERT_TRUE(parseDeadlineThresholds("12.5,50,150", thresholds));
+    EXPECT_DOUBLE_EQ(thresholds[0], 0.125);
+    EXPECT_DOUBLE_EQ(thresholds[2], 1.5);
+}
+
+TEST(ProcessTiming, ParseDeadlineThresholds_IndependentOfLocale) {
+    // A host running with a decimal comma must not change the parse
+    const char* previous = std::setlocale(LC_NUMERIC, nullptr);
+    std::string saved = previous ? previous : "C";
+    if (!std::setlocale(LC_NUMERIC, "de_DE.UTF-8") && !std::setlocale(LC_NUMERIC, "fr_FR.UTF-8"))
+        GTEST_SKIP() << "no locale with a decimal comma installed";
+
+    double thresholds[kDeadlineLevels] = {1.0, 1.0, 1.0};
+    bool parsed = parseDeadlineThresholds("12.5,50,150", thresholds);
+    std::setlocale(LC_NUMERIC, saved.c_str());
+    ASSERT_TRUE(parsed);
+    EXPECT_DOUBLE_EQ(thresholds[0], 0.125);
+    EXPECT_DOUBLE_EQ(thresholds[1], 0.5);
+    EXPECT_DOUBLE_EQ(thresholds[2], 1.5);
+}
+
+TEST(ProcessTiming, ParseDeadlineThresholds_RejectsMalformedText) {
+    double thresholds[kDeadlineLevels] = {1.0, 2.0, 3.0};
+    EXPECT_FALSE(parseDeadlineThresholds(nullptr, thresholds));
+    EXPECT_FALSE(parseDeadlineThresholds("", thresholds));
+    EXPECT_FALSE(parseDeadlineThresholds("10,50", thresholds));          // Too few
+    EXPECT_FALSE(parseDeadlineThresholds("10,50,100,200", thresholds));  // Too many
+    EXPECT_FALSE(parseDeadlineThresholds("50,10,100", thresholds));      // Not ascending
+    EXPECT_FALSE(parseDeadlineThresholds("0,50,100", thresholds));       // Not positive
+    EXPECT_FALSE(parseDeadlineThresholds("10;50;100", thresholds));
+    EXPECT_FALSE(parseDeadlineThresholds("10,50,100%", thresholds));
+
+    // Unchanged on failure
+    EXPECT_EQ(thresholds[0], 1.0);
+    EXPECT_EQ(thresholds[2], 3.0);
+}
@@ -0,0 +1,128 @@
+// test_record_message.cpp
+// Unit tests for record batches carried in IMessage attributes
+
+#include "record_message.h"
+#include "process_timing.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+// Attribute list holding integers and binary blobs (what records use)
+class TestAttributeList : public IAttributeList {
+public:
+    tresult PLUGIN_API setInt(AttrID id, int64 value) override {
+        mInts[id] = value;
+        return kResultTrue;
+    }
+    tresult PLUGIN_API getInt(AttrID id, int64& value) override {
+        auto it = mInts.find(id);
+        if (it == mInts.end())
+            return kResultFalse;
+        value = it->second;
+        return kResultTrue;
+    }
+    tresult PLUGIN_API setFloat(AttrID, double) override { return kNotImplemented; }
+    tresult PLUGIN_API getFloat(AttrID, double&) override { return kNotImplemented; }
+    tresult PLUGIN_API setString(AttrID, const TChar*) override { return kNotImplemented; }
+    tresult PLUGIN_API getString(AttrID, TChar*, uint32) override { return kNotImplemented; }
+    tresult PLUGIN_API setBinary(AttrID id, const void* data, uint32 size) override {
+        const char* bytes = static_cast<const char*>(data);
+        mBinaries[id].assign(bytes, bytes + size);
+        return kResultTrue;
+    }
+    tresult PLUGIN_API getBinary(AttrID id, const void*& data, uint32& size) override {
+        auto it = mBinaries.find(id);
+        if (it == mBinaries.end())
+            return kResultFalse;
+        data = it->second.data();
+        size = static_cast<uint32>(it->second.size());
+        return kResultTrue;
+    }
+
+    tresult PLUGIN_API queryInterface(const TUID, void** obj) override {
+        *obj = nullptr;
+        return kNoInterface;
+    }
+    uint32 PLUGIN_API addRef() override { return 1; }
+    uint32 PLUGIN_API release() override { return 1; }
+
+private:
+    std::map<std::string, int64> mInts;
+    std::map<std::string, std::vector<char>> mBinaries;
+};
+
+ProcessTimingSummary makeSummary(int64 blocks) {
+    ProcessTimingSummary summary = {blocks, 1.0, 2.0, 3.0, 4.0, 0.25, 0.75, {blocks / 2, blocks / 5, 1}};
+    return summary;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Round Trip
+//------------------------------------------------------------------------------
+
+TEST(RecordMessage, RoundTrip_PreservesRecordsAndOrder) {
+    TestAttributeList attributes;
+    ProcessTimingSummary sent[3] = {makeSummary(10), makeSummary(20), makeSummary(30)};
+    writeRecords(&attributes, sent, 3);
+
+    ProcessTimingSummary received[TimingMessage::kMaxRecords];
+    ASSERT_EQ(readRecords(&attributes, received, TimingMessage::kMaxRecords), 3u);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(received[i].blocks, sent[i].blocks);
+        EXPECT_DOUBLE_EQ(received[i].p99Micros, 3.0);
+        EXPECT_DOUBLE_EQ(received[i].load, 0.25);
+        EXPECT_DOUBLE_EQ(received[i].maxDeadlineUse, 0.75);
+        for (int32 level = 0; level < kDeadlineLevels; ++level)
+            EXPECT_EQ(received[i].deadlineExceeded[level], sent[i].deadlineExceeded[level]) << "level " << level;
+    }
+}
+
+TEST(RecordMessage, Read_TruncatesToMaxCount) {
+    TestAttributeList attributes;
+    ProcessTimingSummary sent[3] = {makeSummary(10), makeSummary(20), makeSummary(30)};
+    writeRecords(&attributes, sent, 3);
+
+    ProcessTimingSummary received[2];
+    ASSERT_EQ(readRecords(&attributes, received, 2), 2u);
+    EXPECT_EQ(received[0].blocks, 10);
+    EXPECT_EQ(received[1].blocks, 20);
+}
+
+//------------------------------------------------------------------------------
+// Malformed Messages
+//------------------------------------------------------------------------------
+
+TEST(RecordMessage, Read_RejectsMissingAttributes) {
+    TestAttributeList attributes;
+    ProcessTimingSummary received[1];
+    EXPECT_EQ(readRecords(&attributes, received, 1), 0u);
+    EXPECT_EQ(readRecords<ProcessTimingSummary>(nullptr, received, 1), 0u);
+}
+
+TEST(RecordMessage, Read_RejectsOtherRecordType) {
+    TestAttributeList attributes;
+    int32 sent[4] = {1, 2, 3, 4};
+    writeRecords(&attributes, sent, 4);
+
+    ProcessTimingSummary received[1];
+    EXPECT_EQ(readRecords(&attributes, received, 1), 0u);
+}
+
+TEST(RecordMessage, Read_RejectsPartialRecord) {
+    TestAttributeList attributes;
+    ProcessTimingSummary sent = makeSummary(10);
+    attributes.setInt(RecordMessage::kRecordSize, static_cast<int64>(sizeof(sent)));
+    attributes.setBinary(RecordMessage::kRecords, &sent, static_cast<uint32>(sizeof(sent) - 1));
+
+    ProcessTimingSummary received[1];
+    EXPECT_EQ(readRecords(&attributes, received, 1), 0u);
+}
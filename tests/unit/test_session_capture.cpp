@@ -0,0 +1,250 @@
+// test_session_capture.cpp
+// Unit tests for the session capture file writer
+
+#include "session_capture.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+std::vector<unsigned char> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<unsigned char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// One record of a capture file
+struct Record {
+    uint32 type;
+    std::vector<unsigned char> payload;
+};
+
+std::vector<Record> records(const std::vector<unsigned char>& bytes) {
+    std::vector<Record> result;
+    size_t offset = sizeof(CaptureFileHeader);
+    while (offset + sizeof(CaptureRecordHeader) <= bytes.size()) {
+        CaptureRecordHeader header;
+        std::memcpy(&header, bytes.data() + offset, sizeof(header));
+        offset += sizeof(header);
+        if (bytes.size() - offset < header.size)
+            break;
+        result.push_back({header.type, std::vector<unsigned char>(bytes.begin() + offset,
+                                                                  bytes.begin() + offset + header.size)});
+        offset += header.size;
+    }
+    return result;
+}
+
+// Stereo input block with a ramp on the left and silence on the right
+struct Block {
+    explicit Block(int32 numSamples)
+        : left(numSamples), right(numSamples, 0.0f), outLeft(numSamples), outRight(numSamples)
+    {
+        for (int32 i = 0; i < numSamples; ++i)
+            left[i] = 0.001f * i;
+        inputs[0] = left.data();
+        inputs[1] = right.data();
+        outputs[0] = outLeft.data();
+        outputs[1] = outRight.data();
+        inputBus.numChannels = 2;
+        inputBus.silenceFlags = 0x2;
+        inputBus.channelBuffers32 = inputs;
+        outputBus.numChannels = 2;
+        outputBus.channelBuffers32 = outputs;
+        data.processMode = kOffline;
+        data.symbolicSampleSize = kSample32;
+        data.numSamples = numSamples;
+        data.numInputs = 1;
+        data.numOutputs = 1;
+        data.inputs = &inputBus;
+        data.outputs = &outputBus;
+    }
+
+    std::vector<float> left, right, outLeft, outRight;
+    float* inputs[2];
+    float* outputs[2];
+    AudioBusBuffers inputBus;
+    AudioBusBuffers outputBus;
+    ProcessData data;
+};
+
+std::string capturePath(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// File layout
+//------------------------------------------------------------------------------
+
+TEST(SessionCapture, File_HeaderRecordsAndEnd) {
+    std::string path = capturePath("capture_layout.spcap");
+    {
+        SessionCapture capture(path.c_str(), false);
+        ASSERT_TRUE(capture.isOpen());
+
+        ProcessSetup setup = {kRealtime, kSample32, 512, 48000.0};
+        capture.recordSetup(setup);
+        capture.recordActive(true);
+        capture.recordState(PluginState::defaults());
+        capture.recordActive(false);
+    }
+
+    std::vector<unsigned char> bytes = readFile(path);
+    ASSERT_GE(bytes.size(), sizeof(CaptureFileHeader));
+    CaptureFileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    EXPECT_EQ(header.magic, kCaptureMagic);
+    EXPECT_EQ(header.version, kCaptureVersion);
+    EXPECT_EQ(header.byteOrder, kCaptureByteOrder);
+    EXPECT_EQ(header.flags, 0u);
+
+    std::vector<Record> list = records(bytes);
+    ASSERT_EQ(list.size(), 5u);
+    EXPECT_EQ(list[0].type, static_cast<uint32>(kCaptureSetup));
+    ASSERT_EQ(list[0].payload.size(), sizeof(CaptureSetup));
+    CaptureSetup setup;
+    std::memcpy(&setup, list[0].payload.data(), sizeof(setup));
+    EXPECT_EQ(setup.maxSamplesPerBlock, 512);
+    EXPECT_EQ(setup.sampleRate, 48000.0);
+
+    EXPECT_EQ(list[1].type, static_cast<uint32>(kCaptureActive));
+    EXPECT_EQ(list[1].payload[0], 1);
+
+    // The state record is the chunk setState reads
+    EXPECT_EQ(list[2].type, static_cast<uint32>(kCaptureState));
+    PluginState state = {};
+    EXPECT_EQ(StateSerializer::decode(list[2].payload.data(), list[2].payload.size(), state),
+              list[2].payload.size());
+    EXPECT_EQ(state.values[kParamMasterGain], PluginState::defaults().values[kParamMasterGain]);
+
+    EXPECT_EQ(list[3].type, static_cast<uint32>(kCaptureActive));
+    EXPECT_EQ(list[3].payload[0], 0);
+
+    EXPECT_EQ(list[4].type, static_cast<uint32>(kCaptureEnd));
+    uint64 dropped = 1;
+    std::memcpy(&dropped, list[4].payload.data(), sizeof(dropped));
+    EXPECT_EQ(dropped, 0u);
+    std::remove(path.c_str());
+}
+
+TEST(SessionCapture, PresetBank_PathAndChecksum) {
+    std::string path = capturePath("capture_bank.spcap");
+    {
+        SessionCapture capture(path.c_str(), false);
+        capture.recordPresetBank("/banks/factory.sppb", 12, 9, 0x1234abcdu);
+        capture.recordPresetBank(nullptr, 1, StateSerializer::kNumParams, 0);
+    }
+
+    std::vector<Record> list = records(readFile(path));
+    ASSERT_EQ(list.size(), 3u);
+    ASSERT_EQ(list[0].type, static_cast<uint32>(kCapturePresetBank));
+    ASSERT_EQ(list[0].payload.size(), sizeof(CapturePresetBank) + std::strlen("/banks/factory.sppb"));
+    CapturePresetBank bank;
+    std::memcpy(&bank, list[0].payload.data(), sizeof(bank));
+    EXPECT_EQ(bank.count, 12);
+    EXPECT_EQ(bank.numFields, 9);
+    EXPECT_EQ(bank.checksum, 0x1234abcdu);
+    EXPECT_EQ(std::string(list[0].payload.begin() + sizeof(bank), list[0].payload.end()), "/banks/factory.sppb");
+
+    // No bank: no path
+    ASSERT_EQ(list[1].type, static_cast<uint32>(kCapturePresetBank));
+    ASSERT_EQ(list[1].payload.size(), sizeof(CapturePresetBank));
+    std::memcpy(&bank, list[1].payload.data(), sizeof(bank));
+    EXPECT_EQ(bank.count, 1);
+    EXPECT_EQ(bank.checksum, 0u);
+    EXPECT_EQ(bank.pathSize, 0u);
+    std::remove(path.c_str());
+}
+
+TEST(SessionCapture, Block_HeaderAndAudio) {
+    std::string path = capturePath("capture_block.spcap");
+    Block block(64);
+    {
+        SessionCapture capture(path.c_str(), true);
+        ASSERT_TRUE(capture.isOpen());
+        capture.recordBlock(block.data);
+    }
+
+    std::vector<unsigned char> bytes = readFile(path);
+    CaptureFileHeader fileHeader;
+    std::memcpy(&fileHeader, bytes.data(), sizeof(fileHeader));
+    EXPECT_EQ(fileHeader.flags, kCaptureFlagAudio);
+
+    std::vector<Record> list = records(bytes);
+    ASSERT_EQ(list.size(), 2u);
+    ASSERT_EQ(list[0].type, static_cast<uint32>(kCaptureBlock));
+    ASSERT_EQ(list[0].payload.size(), sizeof(CaptureBlockHeader) + 2 * 64 * sizeof(float));
+
+    CaptureBlockHeader header;
+    std::memcpy(&header, list[0].payload.data(), sizeof(header));
+    EXPECT_EQ(header.numSamples, 64);
+    EXPECT_EQ(header.processMode, kOffline);
+    EXPECT_EQ(header.silenceFlags, 0x2u);
+    EXPECT_EQ(header.inputChannels, 2);
+    EXPECT_EQ(header.outputChannels, 2);
+    EXPECT_EQ(header.numQueues, 0);
+    EXPECT_EQ(header.audioChannels, 2);
+
+    std::vector<float> left(64);
+    std::memcpy(left.data(), list[0].payload.data() + sizeof(header), 64 * sizeof(float));
+    EXPECT_EQ(left, block.left);
+    std::remove(path.c_str());
+}
+
+TEST(SessionCapture, Block_WithoutAudioIsHeaderOnly) {
+    std::string path = capturePath("capture_no_audio.spcap");
+    Block block(64);
+    {
+        SessionCapture capture(path.c_str(), false);
+        capture.recordBlock(block.data);
+    }
+
+    std::vector<Record> list = records(readFile(path));
+    ASSERT_EQ(list.size(), 2u);
+    ASSERT_EQ(list[0].payload.size(), sizeof(CaptureBlockHeader));
+    CaptureBlockHeader header;
+    std::memcpy(&header, list[0].payload.data(), sizeof(header));
+    EXPECT_EQ(header.audioChannels, 0);
+    std::remove(path.c_str());
+}
+
+TEST(SessionCapture, QueueFull_RecordDroppedAndCounted) {
+    std::string path = capturePath("capture_dropped.spcap");
+    // Two channels of this block are larger than the whole queue
+    const int32 kHugeBlock = static_cast<int32>(SessionCapture::kQueueBytes / sizeof(float));
+    Block huge(kHugeBlock);
+    Block small(16);
+    uint64 dropped = 0;
+    {
+        SessionCapture capture(path.c_str(), true);
+        capture.recordBlock(huge.data);
+        capture.recordBlock(small.data);
+        dropped = capture.numDropped();
+    }
+    EXPECT_EQ(dropped, 1u);
+
+    std::vector<Record> list = records(readFile(path));
+    ASSERT_EQ(list.size(), 2u);
+    CaptureBlockHeader header;
+    std::memcpy(&header, list[0].payload.data(), sizeof(header));
+    EXPECT_EQ(header.numSamples, 16);
+    uint64 counted = 0;
+    std::memcpy(&counted, list[1].payload.data(), sizeof(counted));
+    EXPECT_EQ(counted, 1u);
+    std::remove(path.c_str());
+}
+
+TEST(SessionCapture, UnwritablePath_IsNotOpen) {
+    SessionCapture capture("/nonexistent-directory/capture.spcap", true);
+    EXPECT_FALSE(capture.isOpen());
+}
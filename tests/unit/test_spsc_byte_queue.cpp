@@ -0,0 +1,137 @@
+// test_spsc_byte_queue.cpp
+// Unit tests for the lock-free single producer / single consumer byte stream
+
+#include "spsc_byte_queue.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+void writeRecord(SpscByteQueue& queue, const char* text) {
+    size_t size = std::strlen(text);
+    ASSERT_TRUE(queue.reserve(size));
+    queue.append(text, size);
+    queue.commit();
+}
+
+std::string readAll(SpscByteQueue& queue) {
+    char bytes[64];
+    size_t count = queue.read(bytes, sizeof(bytes));
+    return std::string(bytes, count);
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Single Thread Semantics
+//------------------------------------------------------------------------------
+
+TEST(SpscByteQueue, Empty_ReadReturnsZero) {
+    SpscByteQueue queue(16);
+    char bytes[16];
+    EXPECT_EQ(queue.read(bytes, sizeof(bytes)), 0u);
+    EXPECT_EQ(queue.capacity(), 16u);
+}
+
+TEST(SpscByteQueue, Read_DeliversInWriteOrder) {
+    SpscByteQueue queue(32);
+    writeRecord(queue, "abc");
+    writeRecord(queue, "defgh");
+    EXPECT_EQ(readAll(queue), "abcdefgh");
+    EXPECT_EQ(readAll(queue), "");
+}
+
+TEST(SpscByteQueue, Record_InvisibleUntilCommitted) {
+    SpscByteQueue queue(32);
+    ASSERT_TRUE(queue.reserve(6));
+    queue.append("abc", 3);
+    EXPECT_EQ(readAll(queue), "");
+
+    queue.append("def", 3);
+    queue.commit();
+    EXPECT_EQ(readAll(queue), "abcdef");
+}
+
+TEST(SpscByteQueue, Append_LimitedToReservation) {
+    SpscByteQueue queue(32);
+    ASSERT_TRUE(queue.reserve(4));
+    queue.append("abcdef", 6);
+    queue.commit();
+    EXPECT_EQ(readAll(queue), "abcd");
+}
+
+TEST(SpscByteQueue, Full_ReserveFailsAndKeepsOldBytes) {
+    SpscByteQueue queue(8);
+    writeRecord(queue, "abcde");
+    EXPECT_FALSE(queue.reserve(4));
+    EXPECT_TRUE(queue.reserve(3));
+    queue.append("fgh", 3);
+    queue.commit();
+    EXPECT_FALSE(queue.reserve(1));
+
+    EXPECT_EQ(readAll(queue), "abcdefgh");
+
+    // Reading frees the space again
+    EXPECT_TRUE(queue.reserve(8));
+    EXPECT_FALSE(queue.reserve(9));
+}
+
+TEST(SpscByteQueue, Records_WrapAroundTheEnd) {
+    SpscByteQueue queue(8);
+    char bytes[8];
+    writeRecord(queue, "abcdef");
+    ASSERT_EQ(queue.read(bytes, 4), 4u);
+
+    writeRecord(queue, "ghijkl");  // Crosses the end of the storage
+    EXPECT_EQ(readAll(queue), "efghijkl");
+}
+
+//------------------------------------------------------------------------------
+// Concurrency
+//------------------------------------------------------------------------------
+
+TEST(SpscByteQueue, Concurrent_RecordsArriveWhole) {
+    // Each record is its index repeated over a varying length; the reader
+    // must see every record complete and in order
+    SpscByteQueue queue(256);
+    const int kRecords = 20000;
+
+    std::thread producer([&queue] {
+        for (int i = 0; i < kRecords; ++i) {
+            unsigned char record[1 + 40];
+            size_t length = 1 + static_cast<size_t>(i % 40);
+            record[0] = static_cast<unsigned char>(length);
+            std::memset(record + 1, i & 0xff, length);
+            while (!queue.reserve(length + 1))
+                std::this_thread::yield();
+            queue.append(record, 1);
+            queue.append(record + 1, length);
+            queue.commit();
+        }
+    });
+
+    std::vector<unsigned char> stream;
+    size_t expected = 0;
+    for (int i = 0; i < kRecords; ++i)
+        expected += 2 + static_cast<size_t>(i % 40);
+    unsigned char bytes[97];
+    while (stream.size() < expected) {
+        size_t count = queue.read(bytes, sizeof(bytes));
+        stream.insert(stream.end(), bytes, bytes + count);
+    }
+    producer.join();
+
+    size_t offset = 0;
+    for (int i = 0; i < kRecords; ++i) {
+        size_t length = stream[offset];
+        ASSERT_EQ(length, 1 + static_cast<size_t>(i % 40)) << "record " << i;
+        for (size_t b = 1; b <= length; ++b)
+            ASSERT_EQ(stream[offset + b], static_cast<unsigned char>(i & 0xff)) << "record " << i;
+        offset += 1 + length;
+    }
+}
@@ -0,0 +1,136 @@
+// test_spsc_ring_buffer.cpp
+// Unit tests for the lock-free single producer / single consumer ring buffer
+
+#include "spsc_ring_buffer.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+// Large enough that a torn copy would show mismatching fields
+struct Record {
+    long values[8];
+};
+
+Record makeRecord(long value) {
+    Record record;
+    for (long& v : record.values)
+        v = value;
+    return record;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Single Thread Semantics
+//------------------------------------------------------------------------------
+
+TEST(SpscRingBuffer, Empty_PopReturnsZero) {
+    SpscRingBuffer<int, 8> buffer;
+    int values[8] = {};
+    EXPECT_EQ(buffer.pop(values, 8), 0u);
+    EXPECT_EQ(buffer.size(), 0u);
+}
+
+TEST(SpscRingBuffer, Pop_DeliversInPushOrder) {
+    SpscRingBuffer<int, 8> buffer;
+    for (int i = 1; i <= 5; ++i)
+        EXPECT_TRUE(buffer.push(i));
+    EXPECT_EQ(buffer.size(), 5u);
+
+    int values[8] = {};
+    ASSERT_EQ(buffer.pop(values, 8), 5u);
+    for (int i = 0; i < 5; ++i)
+        EXPECT_EQ(values[i], i + 1);
+    EXPECT_EQ(buffer.pop(values, 8), 0u);
+}
+
+TEST(SpscRingBuffer, Pop_TakesAtMostMaxCount) {
+    SpscRingBuffer<int, 8> buffer;
+    for (int i = 1; i <= 5; ++i)
+        buffer.push(i);
+
+    int values[8] = {};
+    ASSERT_EQ(buffer.pop(values, 2), 2u);
+    EXPECT_EQ(values[0], 1);
+    EXPECT_EQ(values[1], 2);
+
+    ASSERT_EQ(buffer.pop(values, 8), 3u);
+    EXPECT_EQ(values[0], 3);
+    EXPECT_EQ(values[2], 5);
+}
+
+TEST(SpscRingBuffer, Full_PushFailsAndKeepsOldRecords) {
+    SpscRingBuffer<int, 4> buffer;
+    for (int i = 1; i <= 4; ++i)
+        EXPECT_TRUE(buffer.push(i));
+    EXPECT_FALSE(buffer.push(5));
+    EXPECT_EQ(buffer.size(), 4u);
+
+    int values[4] = {};
+    ASSERT_EQ(buffer.pop(values, 4), 4u);
+    EXPECT_EQ(values[0], 1);
+    EXPECT_EQ(values[3], 4);
+
+    // Popping frees the slots again
+    EXPECT_TRUE(buffer.push(6));
+}
+
+TEST(SpscRingBuffer, WrapAround_KeepsOrder) {
+    SpscRingBuffer<int, 4> buffer;
+    int next = 0;
+    int expected = 0;
+    int values[4] = {};
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 3; ++i)
+            ASSERT_TRUE(buffer.push(next++));
+        size_t count = buffer.pop(values, 4);
+        ASSERT_EQ(count, 3u);
+        for (size_t i = 0; i < count; ++i)
+            EXPECT_EQ(values[i], expected++);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Concurrency
+//------------------------------------------------------------------------------
+
+TEST(SpscRingBuffer, Concurrent_NoLostTornOrReorderedRecords) {
+    SpscRingBuffer<Record, 64> buffer;
+    const long kNumRecords = 200000;
+    std::atomic<bool> done{false};
+
+    // Retries on a full buffer so that every record must arrive
+    std::thread producer([&] {
+        for (long i = 1; i <= kNumRecords; ++i) {
+            while (!buffer.push(makeRecord(i)))
+                std::this_thread::yield();
+        }
+        done.store(true);
+    });
+
+    long last = 0;
+    bool consistent = true;
+    bool sequential = true;
+    Record records[16];
+    for (;;) {
+        bool finished = done.load();
+        size_t count = buffer.pop(records, 16);
+        for (size_t i = 0; i < count; ++i) {
+            for (long v : records[i].values)
+                consistent = consistent && (v == records[i].values[0]);
+            sequential = sequential && (records[i].values[0] == last + 1);
+            last = records[i].values[0];
+        }
+        if (count == 0 && finished)
+            break;
+    }
+    producer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_TRUE(sequential);
+    EXPECT_EQ(last, kNumRecords);
+}
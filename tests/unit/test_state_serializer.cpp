@@ -0,0 +1,223 @@
+// test_state_serializer.cpp
+// Unit tests for the v1/v2 component state format
+
+#include "state_serializer.h"
+#include "base/source/fstreamer.h"
+#include "public.sdk/source/common/memorystream.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+PluginState makeState() {
+    PluginState state = PluginState::defaults();
+    for (int32 i = 0; i < StateSerializer::kNumFields; ++i)
+        state.values[i] = 0.05 * (i + 1);
+    return state;
+}
+
+void expectSameValues(const PluginState& actual, const PluginState& expected) {
+    for (int32 i = 0; i < StateSerializer::kNumFields; ++i)
+        EXPECT_EQ(actual.values[i], expected.values[i]) << "field " << i;
+}
+
+// Stream wrapper counting read/write calls
+class CountingStream : public MemoryStream {
+public:
+    tresult PLUGIN_API read(void* buffer, int32 numBytes, int32* numBytesRead) override {
+        ++numReads;
+        return MemoryStream::read(buffer, numBytes, numBytesRead);
+    }
+    tresult PLUGIN_API write(void* buffer, int32 numBytes, int32* numBytesWritten) override {
+        ++numWrites;
+        return MemoryStream::write(buffer, numBytes, numBytesWritten);
+    }
+    int numReads = 0;
+    int numWrites = 0;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Version 2
+//------------------------------------------------------------------------------
+
+TEST(StateSerializer, V2_RoundTrip) {
+    PluginState written = makeState();
+    uint8 buffer[StateSerializer::kMaxChunkSize];
+    size_t size = StateSerializer::encode(written, buffer);
+
+    EXPECT_EQ(size, StateSerializer::kHeaderSize + StateSerializer::kNumFields * sizeof(double) + StateSerializer::kChecksumSize);
+
+    PluginState read = PluginState::defaults();
+    EXPECT_EQ(StateSerializer::decode(buffer, size, read), size);
+    expectSameValues(read, written);
+}
+
+TEST(StateSerializer, V2_SingleStreamCallEachWay) {
+    CountingStream stream;
+    PluginState written = makeState();
+    ASSERT_TRUE(StateSerializer::write(&stream, written));
+    EXPECT_EQ(stream.numWrites, 1);
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState read = PluginState::defaults();
+    ASSERT_TRUE(StateSerializer::read(&stream, read));
+    EXPECT_EQ(stream.numReads, 1);
+    expectSameValues(read, written);
+}
+
+TEST(StateSerializer, V2_CorruptChecksum_Rejected) {
+    uint8 buffer[StateSerializer::kMaxChunkSize];
+    size_t size = StateSerializer::encode(makeState(), buffer);
+    buffer[StateSerializer::kHeaderSize + 3] ^= 0x10;
+
+    PluginState read = PluginState::defaults();
+    EXPECT_EQ(StateSerializer::decode(buffer, size, read), 0u);
+    expectSameValues(read, PluginState::defaults());
+}
+
+TEST(StateSerializer, V2_Truncated_Rejected) {
+    uint8 buffer[StateSerializer::kMaxChunkSize];
+    size_t size = StateSerializer::encode(makeState(), buffer);
+
+    PluginState read = PluginState::defaults();
+    EXPECT_EQ(StateSerializer::decode(buffer, size - 1, read), 0u);
+}
+
+TEST(StateSerializer, V2_FewerFields_KeepDefaults) {
+    // Chunk from a version that only knew the 8 original parameters
+    MemoryStream stream;
+    IBStreamer streamer(&stream, kLittleEndian);
+    streamer.writeInt32(StateSerializer::kVersion2);
+    streamer.writeInt32(8);
+    for (int i = 0; i < 8; ++i)
+        streamer.writeDouble(0.25);
+    uint32 checksum = StateSerializer::checksum(reinterpret_cast<const uint8*>(stream.getData()), static_cast<size_t>(stream.getSize()));
+    streamer.writeInt32u(checksum);
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState read = PluginState::defaults();
+    ASSERT_TRUE(StateSerializer::read(&stream, read));
+    EXPECT_EQ(read.values[kParamLinkGain], 0.25);
+    EXPECT_EQ(read.values[kParamPanLaw], PluginState::defaults().values[kParamPanLaw]);
+}
+
+TEST(StateSerializer, V2_UnknownTrailingFields_Skipped) {
+    // Chunk from a newer version with two extra fields, followed by other data
+    MemoryStream stream;
+    IBStreamer streamer(&stream, kLittleEndian);
+    streamer.writeInt32(StateSerializer::kVersion2);
+    streamer.writeInt32(StateSerializer::kNumFields + 2);
+    for (int32 i = 0; i < StateSerializer::kNumFields + 2; ++i)
+        streamer.writeDouble(0.5);
+    uint32 checksum = StateSerializer::checksum(reinterpret_cast<const uint8*>(stream.getData()), static_cast<size_t>(stream.getSize()));
+    streamer.writeInt32u(checksum);
+    int64 chunkEnd = 0;
+    stream.tell(&chunkEnd);
+    streamer.writeInt32(12345);
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState read = PluginState::defaults();
+    ASSERT_TRUE(StateSerializer::read(&stream, read));
+    EXPECT_EQ(read.values[kParamPanLaw], 0.5);
+
+    // Stream is left right after the chunk
+    int64 position = 0;
+    stream.tell(&position);
+    EXPECT_EQ(position, chunkEnd);
+}
+
+//------------------------------------------------------------------------------
+// Version 1 Compatibility
+//------------------------------------------------------------------------------
+
+TEST(StateSerializer, V1_EightFields_PanLawDefaults) {
+    MemoryStream stream;
+    IBStreamer streamer(&stream, kLittleEndian);
+    streamer.writeInt32(StateSerializer::kVersion1);
+    for (int i = 0; i < 8; ++i)
+        streamer.writeDouble(0.125 * i);
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState read = PluginState::defaults();
+    ASSERT_TRUE(StateSerializer::read(&stream, read));
+    for (int i = 0; i < 8; ++i)
+        EXPECT_EQ(read.values[i], 0.125 * i);
+    EXPECT_EQ(read.values[kParamPanLaw], PluginState::defaults().values[kParamPanLaw]);
+}
+
+TEST(StateSerializer, V1_NinthValue_NotReadAsPanLaw) {
+    // v1 never stores the pan law; a value after the 8 parameters is not part of the chunk
+    MemoryStream stream;
+    IBStreamer streamer(&stream, kLittleEndian);
+    streamer.writeInt32(StateSerializer::kVersion1);
+    for (int i = 0; i < 8; ++i)
+        streamer.writeDouble(0.5);
+    streamer.writeDouble(panLawToNormalized(kPanLawBalance));
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState read = PluginState::defaults();
+    ASSERT_TRUE(StateSerializer::read(&stream, read));
+    EXPECT_EQ(read.values[kParamPanLaw], PluginState::defaults().values[kParamPanLaw]);
+}
+
+TEST(StateSerializer, V1_TrailingData_NotReadAsParameters) {
+    MemoryStream stream;
+    IBStreamer streamer(&stream, kLittleEndian);
+    streamer.writeInt32(StateSerializer::kVersion1);
+    for (int i = 0; i < 8; ++i)
+        streamer.writeDouble(0.5);
+    streamer.writeDouble(0.75);  // Data of the host, not a Pan Law or Morph value
+    streamer.writeDouble(0.75);
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState read = PluginState::defaults();
+    ASSERT_TRUE(StateSerializer::read(&stream, read));
+    EXPECT_EQ(read.values[kParamPanLaw], PluginState::defaults().values[kParamPanLaw]);
+    EXPECT_EQ(read.values[kParamMorph], PluginState::defaults().values[kParamMorph]);
+
+    // The stream is left at the trailing data
+    int64 position = -1;
+    stream.tell(&position);
+    EXPECT_EQ(position, static_cast<int64>(sizeof(int32) + 8 * sizeof(double)));
+}
+
+TEST(StateSerializer, V1_Truncated_Rejected) {
+    MemoryStream stream;
+    IBStreamer streamer(&stream, kLittleEndian);
+    streamer.writeInt32(StateSerializer::kVersion1);
+    for (int i = 0; i < 7; ++i)
+        streamer.writeDouble(0.5);
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState read = PluginState::defaults();
+    EXPECT_FALSE(StateSerializer::read(&stream, read));
+}
+
+//------------------------------------------------------------------------------
+// Invalid Input
+//------------------------------------------------------------------------------
+
+TEST(StateSerializer, UnknownVersion_Rejected) {
+    MemoryStream stream;
+    IBStreamer streamer(&stream, kLittleEndian);
+    streamer.writeInt32(99);
+    for (int i = 0; i < 16; ++i)
+        streamer.writeDouble(0.5);
+
+    stream.seek(0, IBStream::kIBSeekSet, nullptr);
+    PluginState read = PluginState::defaults();
+    EXPECT_FALSE(StateSerializer::read(&stream, read));
+}
+
+TEST(StateSerializer, EmptyOrNullStream_Rejected) {
+    MemoryStream stream;
+    PluginState read = PluginState::defaults();
+    EXPECT_FALSE(StateSerializer::read(&stream, read));
+    EXPECT_FALSE(StateSerializer::read(nullptr, read));
+    EXPECT_FALSE(StateSerializer::write(nullptr, read));
+}
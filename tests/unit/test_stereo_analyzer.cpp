@@ -0,0 +1,141 @@
+// test_stereo_analyzer.cpp
+// Unit tests for the stereo correlation and goniometer analysis
+
+#include "stereo_analyzer.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Stereo sine pair with a phase offset between the channels
+void makeSines(int32 numSamples, double phase, std::vector<float>& left, std::vector<float>& right) {
+    left.resize(numSamples);
+    right.resize(numSamples);
+    for (int32 i = 0; i < numSamples; ++i) {
+        double angle = 2.0 * kPi * 750.0 * i / 48000.0;
+        left[i] = static_cast<float>(0.5 * std::sin(angle));
+        right[i] = static_cast<float>(0.5 * std::sin(angle + phase));
+    }
+}
+
+// Run a signal through an analyzer in blocks, collecting the frames
+std::vector<ScopeFrame> analyze(StereoAnalyzer& analyzer, const std::vector<float>& left,
+                                const std::vector<float>& right, int32 blockSize) {
+    std::vector<ScopeFrame> frames;
+    int32 numSamples = static_cast<int32>(left.size());
+    for (int32 offset = 0; offset < numSamples; offset += blockSize) {
+        int32 count = std::min(blockSize, numSamples - offset);
+        analyzer.add(left.data() + offset, right.data() + offset, count,
+                     [&](const ScopeFrame& frame) { frames.push_back(frame); });
+    }
+    return frames;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Correlation
+//------------------------------------------------------------------------------
+
+TEST(StereoAnalyzer, PhaseCorrelation_Extremes) {
+    EXPECT_FLOAT_EQ(phaseCorrelation(2.0, 2.0, 2.0), 1.0f);     // Mono
+    EXPECT_FLOAT_EQ(phaseCorrelation(-2.0, 2.0, 2.0), -1.0f);   // Polarity inverted
+    EXPECT_FLOAT_EQ(phaseCorrelation(0.0, 2.0, 2.0), 0.0f);     // Uncorrelated
+}
+
+TEST(StereoAnalyzer, PhaseCorrelation_SilenceIsZero) {
+    EXPECT_EQ(phaseCorrelation(0.0, 0.0, 0.0), 0.0f);
+    EXPECT_EQ(phaseCorrelation(0.0, 1.0, 0.0), 0.0f);           // One channel silent
+}
+
+TEST(StereoAnalyzer, Frames_CorrelationOfPhaseShiftedSines) {
+    std::vector<float> left, right;
+    StereoAnalyzer analyzer;
+    analyzer.setSampleRate(48000.0);
+
+    makeSines(16000, 0.0, left, right);
+    std::vector<ScopeFrame> frames = analyze(analyzer, left, right, 256);
+    ASSERT_EQ(frames.size(), 10u);
+    EXPECT_NEAR(frames.back().correlation, 1.0f, 1.0e-4f);
+
+    makeSines(16000, kPi, left, right);
+    frames = analyze(analyzer, left, right, 256);
+    EXPECT_NEAR(frames.back().correlation, -1.0f, 1.0e-4f);
+
+    // 750 Hz: 64 samples per cycle, so a 1600-sample frame holds whole cycles
+    makeSines(16000, kPi / 2.0, left, right);
+    frames = analyze(analyzer, left, right, 256);
+    EXPECT_NEAR(frames.back().correlation, 0.0f, 1.0e-3f);
+}
+
+//------------------------------------------------------------------------------
+// Framing and Decimation
+//------------------------------------------------------------------------------
+
+TEST(StereoAnalyzer, Frames_FollowAudioTimeNotBlockSize) {
+    std::vector<float> left, right;
+    makeSines(48000, 0.3, left, right);
+
+    StereoAnalyzer whole;
+    whole.setSampleRate(48000.0);
+    std::vector<ScopeFrame> expected = analyze(whole, left, right, 1600);
+    ASSERT_EQ(expected.size(), 30u);
+
+    StereoAnalyzer odd;
+    odd.setSampleRate(48000.0);
+    std::vector<ScopeFrame> frames = analyze(odd, left, right, 37);
+    ASSERT_EQ(frames.size(), expected.size());
+    for (size_t f = 0; f < frames.size(); ++f) {
+        ASSERT_EQ(frames[f].numPoints, expected[f].numPoints);
+        for (int32 i = 0; i < frames[f].numPoints; ++i) {
+            EXPECT_EQ(frames[f].left[i], expected[f].left[i]);
+            EXPECT_EQ(frames[f].right[i], expected[f].right[i]);
+        }
+        EXPECT_NEAR(frames[f].correlation, expected[f].correlation, 1.0e-5f);
+    }
+}
+
+TEST(StereoAnalyzer, Points_AreDecimatedSamplesWithinBudget) {
+    const double kSampleRates[] = {22050.0, 44100.0, 48000.0, 96000.0, 192000.0, 384000.0};
+    for (double sampleRate : kSampleRates) {
+        StereoAnalyzer analyzer;
+        analyzer.setSampleRate(sampleRate);
+        int32 frameLength = analyzer.frameLength();
+        EXPECT_EQ(frameLength, static_cast<int32>(sampleRate / kScopeFrameRateHz));
+
+        std::vector<float> left(frameLength), right(frameLength);
+        for (int32 i = 0; i < frameLength; ++i) {
+            left[i] = static_cast<float>(i);
+            right[i] = -static_cast<float>(i);
+        }
+        std::vector<ScopeFrame> frames = analyze(analyzer, left, right, 64);
+        ASSERT_EQ(frames.size(), 1u) << sampleRate;
+
+        const ScopeFrame& frame = frames[0];
+        EXPECT_LE(frame.numPoints, kScopePoints) << sampleRate;
+        EXPECT_GT(frame.numPoints, kScopePoints / 2) << sampleRate;
+        for (int32 i = 0; i < frame.numPoints; ++i) {
+            EXPECT_EQ(frame.left[i], static_cast<float>(i * analyzer.decimation()));
+            EXPECT_EQ(frame.right[i], -frame.left[i]);
+        }
+    }
+}
+
+TEST(StereoAnalyzer, Reset_DiscardsPartialFrame) {
+    std::vector<float> left, right;
+    makeSines(1000, 0.0, left, right);
+
+    StereoAnalyzer analyzer;
+    analyzer.setSampleRate(48000.0);
+    EXPECT_TRUE(analyze(analyzer, left, right, 100).empty());
+
+    analyzer.reset();
+    EXPECT_TRUE(analyze(analyzer, left, right, 100).empty());
+    EXPECT_EQ(analyze(analyzer, left, right, 100).size(), 1u);  // 2000 samples since reset
+}
@@ -0,0 +1,115 @@
+// test_trace_recorder.cpp
+// Unit tests for the Chrome trace event recorder
+
+#include "trace_recorder.h"
+#include "test_file_helpers.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+namespace {
+
+std::string tracePath(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Recorder
+//------------------------------------------------------------------------------
+
+TEST(TraceRecorder, File_IsChromeTraceArray) {
+    std::string path = tracePath("trace_basic.json");
+    {
+        TraceRecorder recorder(path.c_str());
+        ASSERT_TRUE(recorder.isOpen());
+        recorder.record("lifecycle", "Processor::initialize", 7, 1500, 4250);
+        recorder.record("audio", "Processor::process", 7, 10000, 10042);
+    }
+
+    std::string text = readFile(path);
+    EXPECT_EQ(text.compare(0, 2, "[\n"), 0);
+    EXPECT_EQ(text.compare(text.size() - 3, 3, "\n]\n"), 0);
+    EXPECT_NE(text.find("\"process_name\""), std::string::npos);
+    EXPECT_NE(text.find("{\"name\":\"Processor::initialize\",\"cat\":\"lifecycle\",\"ph\":\"X\",\"pid\":1,"),
+              std::string::npos);
+    EXPECT_NE(text.find("\"ts\":1.500,\"dur\":2.750,\"args\":{\"instance\":7}}"), std::string::npos);
+    EXPECT_NE(text.find("\"ts\":10.000,\"dur\":0.042,"), std::string::npos);
+    EXPECT_NE(text.find("\"args\":{\"count\":0}"), std::string::npos);
+    EXPECT_EQ(countOf(text, "\"ph\":\"X\""), 2u);
+    std::remove(path.c_str());
+}
+
+TEST(TraceRecorder, Events_FromManyThreadsAreAllWritten) {
+    std::string path = tracePath("trace_threads.json");
+    const int kThreads = 4;
+    const int kEventsPerThread = 500;
+    {
+        TraceRecorder recorder(path.c_str());
+        ASSERT_TRUE(recorder.isOpen());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&recorder] {
+                for (int i = 0; i < kEventsPerThread; ++i) {
+                    int64 start = recorder.now();
+                    recorder.record("audio", "Processor::process", 1, start, recorder.now());
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        EXPECT_EQ(recorder.numDropped(), 0u);  // Fewer events than kCapacity
+    }
+
+    std::string text = readFile(path);
+    EXPECT_EQ(countOf(text, "\"ph\":\"X\""), static_cast<size_t>(kThreads * kEventsPerThread));
+    std::remove(path.c_str());
+}
+
+TEST(TraceRecorder, WriterThread_WritesWhileRunning) {
+    std::string path = tracePath("trace_running.json");
+    TraceRecorder recorder(path.c_str());
+    ASSERT_TRUE(recorder.isOpen());
+    recorder.record("ui", "Editor::open", 3, 0, 1000);
+
+    for (int i = 0; i < 200 && recorder.numWritten() == 0; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(recorder.numWritten(), 1u);
+    EXPECT_NE(readFile(path).find("\"Editor::open\""), std::string::npos);
+}
+
+TEST(TraceRecorder, UnwritablePath_IsNotOpen) {
+    TraceRecorder recorder("/nonexistent-directory/trace.json");
+    EXPECT_FALSE(recorder.isOpen());
+}
+
+TEST(TraceRecorder, NextInstance_IsUnique) {
+    uint32 first = TraceRecorder::nextInstance();
+    uint32 second = TraceRecorder::nextInstance();
+    EXPECT_NE(first, second);
+    EXPECT_GT(first, 0u);
+}
+
+//------------------------------------------------------------------------------
+// Scope
+//------------------------------------------------------------------------------
+
+TEST(TraceRecorder, Get_IsNullWithoutEnvironmentVariable) {
+    // First use in this executable decides; CTest does not set the variable
+    if (std::getenv(PluginInfo::kTraceEnv))
+        GTEST_SKIP() << PluginInfo::kTraceEnv << " is set";
+
+    EXPECT_EQ(TraceRecorder::get(), nullptr);
+    TraceScope scope("lifecycle", "Processor::initialize", 1);  // No effect
+
+    TraceRecorder::shutdown();  // Nothing to stop
+    EXPECT_EQ(TraceRecorder::get(), nullptr);
+}
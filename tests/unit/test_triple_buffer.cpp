@@ -0,0 +1,97 @@
+// test_triple_buffer.cpp
+// Unit tests for the lock-free triple buffer handoff
+
+#include "triple_buffer.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+// Large enough that a torn copy would show mismatching fields
+struct Snapshot {
+    long values[16];
+};
+
+Snapshot makeSnapshot(long value) {
+    Snapshot snapshot;
+    for (long& v : snapshot.values)
+        v = value;
+    return snapshot;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Single Thread Semantics
+//------------------------------------------------------------------------------
+
+TEST(TripleBuffer, Empty_ConsumeReturnsFalse) {
+    TripleBuffer<int> buffer;
+    int value = 42;
+    EXPECT_FALSE(buffer.consume(value));
+    EXPECT_EQ(value, 42);
+}
+
+TEST(TripleBuffer, PublishThenConsume_DeliversOnce) {
+    TripleBuffer<int> buffer;
+    buffer.publish(7);
+
+    int value = 0;
+    EXPECT_TRUE(buffer.consume(value));
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(buffer.consume(value));
+}
+
+TEST(TripleBuffer, MultiplePublishes_DeliverLatest) {
+    TripleBuffer<int> buffer;
+    for (int i = 1; i <= 10; ++i)
+        buffer.publish(i);
+
+    int value = 0;
+    EXPECT_TRUE(buffer.consume(value));
+    EXPECT_EQ(value, 10);
+
+    buffer.publish(11);
+    EXPECT_TRUE(buffer.consume(value));
+    EXPECT_EQ(value, 11);
+}
+
+//------------------------------------------------------------------------------
+// Concurrency
+//------------------------------------------------------------------------------
+
+TEST(TripleBuffer, Concurrent_NoTornOrStaleValues) {
+    TripleBuffer<Snapshot> buffer;
+    const long kNumPublishes = 200000;
+    std::atomic<bool> done{false};
+
+    std::thread producer([&] {
+        for (long i = 1; i <= kNumPublishes; ++i)
+            buffer.publish(makeSnapshot(i));
+        done.store(true);
+    });
+
+    long last = 0;
+    bool consistent = true;
+    bool monotonic = true;
+    Snapshot snapshot = makeSnapshot(0);
+    for (;;) {
+        bool finished = done.load();
+        if (buffer.consume(snapshot)) {
+            for (long v : snapshot.values)
+                consistent = consistent && (v == snapshot.values[0]);
+            monotonic = monotonic && (snapshot.values[0] > last);
+            last = snapshot.values[0];
+        } else if (finished) {
+            break;
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_TRUE(monotonic);
+    EXPECT_EQ(last, kNumPublishes);
+}
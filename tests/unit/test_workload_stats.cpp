@@ -0,0 +1,194 @@
+// test_workload_stats.cpp
+// Unit tests for the per-block workload histograms
+
+#include "workload_stats.h"
+#include "test_file_helpers.h"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Steinberg::SimplePanner;
+using namespace SimplePannerTest;
+
+namespace {
+
+// Stereo input block without audio buffers (WorkloadStats reads the header only)
+struct BlockHeader {
+    explicit BlockHeader(int32 numSamples, uint64 silenceFlags = 0, int32 processMode = kRealtime) {
+        input.numChannels = 2;
+        input.silenceFlags = silenceFlags;
+        data.processMode = processMode;
+        data.symbolicSampleSize = kSample32;
+        data.numSamples = numSamples;
+        data.numInputs = 1;
+        data.inputs = &input;
+    }
+
+    AudioBusBuffers input;
+    ProcessData data;
+};
+
+void addBlock(WorkloadStats& stats, int32 numSamples, uint64 silenceFlags = 0, int32 processMode = kRealtime) {
+    BlockHeader block(numSamples, silenceFlags, processMode);
+    stats.add(block.data);
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Buckets
+//------------------------------------------------------------------------------
+
+TEST(WorkloadStats, Bucket_PowersOfTwo) {
+    EXPECT_EQ(workloadBucket(0), 0);
+    EXPECT_EQ(workloadBucket(1), 1);
+    EXPECT_EQ(workloadBucket(2), 2);
+    EXPECT_EQ(workloadBucket(3), 2);
+    EXPECT_EQ(workloadBucket(4), 3);
+    EXPECT_EQ(workloadBucket(255), 8);
+    EXPECT_EQ(workloadBucket(256), 9);
+    EXPECT_EQ(workloadBucket(32768), kWorkloadBuckets - 1);
+    EXPECT_EQ(workloadBucket(1 << 20), kWorkloadBuckets - 1);
+
+    EXPECT_EQ(workloadBucketLow(0), 0);
+    EXPECT_EQ(workloadBucketLow(1), 1);
+    EXPECT_EQ(workloadBucketLow(9), 256);
+    for (int32 bucket = 1; bucket < kWorkloadBuckets; ++bucket)
+        EXPECT_EQ(workloadBucket(workloadBucketLow(bucket)), bucket);
+}
+
+//------------------------------------------------------------------------------
+// Collection
+//------------------------------------------------------------------------------
+
+TEST(WorkloadStats, BlockSizes_HistogramAndRange) {
+    WorkloadStats stats;
+    addBlock(stats, 512);
+    addBlock(stats, 512);
+    addBlock(stats, 300);
+    addBlock(stats, 0);
+
+    EXPECT_EQ(stats.numBlocks(), 4);
+    const WorkloadHistogram& sizes = stats.blockSizes();
+    EXPECT_EQ(sizes.counts[workloadBucket(512)], 2);
+    EXPECT_EQ(sizes.counts[workloadBucket(300)], 1);
+    EXPECT_EQ(sizes.counts[0], 1);
+    EXPECT_EQ(sizes.min, 0);
+    EXPECT_EQ(sizes.max, 512);
+    EXPECT_EQ(sizes.total, 1324);
+    EXPECT_EQ(stats.nonPowerOfTwoBlocks(), 1);
+
+    // No parameter list: every block has zero queues and points
+    EXPECT_EQ(stats.parameterQueues().counts[0], 4);
+    EXPECT_EQ(stats.parameterPoints().max, 0);
+}
+
+TEST(WorkloadStats, SilenceFlags_AllOrSomeChannels) {
+    WorkloadStats stats;
+    addBlock(stats, 64, 0x0);
+    addBlock(stats, 64, 0x3);
+    addBlock(stats, 64, 0x1);
+    addBlock(stats, 64, 0x2);
+    addBlock(stats, 64, 0x4);  // No such channel
+
+    EXPECT_EQ(stats.silentBlocks(), 1);
+    EXPECT_EQ(stats.partlySilentBlocks(), 2);
+}
+
+TEST(WorkloadStats, ProcessModes_Counted) {
+    WorkloadStats stats;
+    addBlock(stats, 64, 0, kRealtime);
+    addBlock(stats, 64, 0, kOffline);
+    addBlock(stats, 64, 0, kOffline);
+    addBlock(stats, 64, 0, kPrefetch);
+
+    EXPECT_EQ(stats.modeBlocks(kRealtime), 1);
+    EXPECT_EQ(stats.modeBlocks(kPrefetch), 1);
+    EXPECT_EQ(stats.modeBlocks(kOffline), 2);
+}
+
+TEST(WorkloadStats, SampleRates_BlocksPerRate) {
+    WorkloadStats stats;
+    addBlock(stats, 64);  // Before any rate: counted, but in no row
+
+    stats.setSampleRate(44100.0);
+    addBlock(stats, 64);
+    stats.setSampleRate(96000.0);
+    addBlock(stats, 64);
+    addBlock(stats, 64);
+    stats.setSampleRate(44100.0);
+    addBlock(stats, 64);
+
+    ASSERT_EQ(stats.numSampleRates(), 2);
+    EXPECT_EQ(stats.sampleRate(0), 44100.0);
+    EXPECT_EQ(stats.sampleRateBlocks(0), 2);
+    EXPECT_EQ(stats.sampleRate(1), 96000.0);
+    EXPECT_EQ(stats.sampleRateBlocks(1), 2);
+    EXPECT_EQ(stats.numBlocks(), 5);
+}
+
+TEST(WorkloadStats, SampleRates_ExtraRatesShareLastRow) {
+    WorkloadStats stats;
+    for (int32 i = 0; i < WorkloadStats::kMaxSampleRates + 2; ++i) {
+        stats.setSampleRate(8000.0 * (i + 1));
+        addBlock(stats, 64);
+    }
+
+    EXPECT_EQ(stats.numSampleRates(), WorkloadStats::kMaxSampleRates);
+    EXPECT_EQ(stats.sampleRateBlocks(WorkloadStats::kMaxSampleRates - 1), 3);
+}
+
+TEST(WorkloadStats, Clear_StartsOver) {
+    WorkloadStats stats;
+    stats.setSampleRate(48000.0);
+    addBlock(stats, 100, 0x3, kOffline);
+    stats.clear();
+
+    EXPECT_EQ(stats.numBlocks(), 0);
+    EXPECT_EQ(stats.blockSizes().counts[workloadBucket(100)], 0);
+    EXPECT_EQ(stats.nonPowerOfTwoBlocks(), 0);
+    EXPECT_EQ(stats.silentBlocks(), 0);
+    EXPECT_EQ(stats.modeBlocks(kOffline), 0);
+    EXPECT_EQ(stats.numSampleRates(), 0);
+}
+
+//------------------------------------------------------------------------------
+// Output
+//------------------------------------------------------------------------------
+
+TEST(WorkloadStats, Write_Json) {
+    WorkloadStats stats;
+    stats.setSampleRate(44100.0);
+    addBlock(stats, 512);
+    addBlock(stats, 512, 0x3);
+    addBlock(stats, 300, 0x1, kOffline);
+    stats.setSampleRate(48000.0);  // No blocks: left out
+
+    std::string path = ::testing::TempDir() + "workload_stats.json";
+    ASSERT_TRUE(stats.write(path.c_str()));
+
+    std::string text = readFile(path);
+    EXPECT_EQ(text.compare(0, 2, "{\n"), 0);
+    EXPECT_EQ(text.compare(text.size() - 2, 2, "}\n"), 0);
+    EXPECT_NE(text.find("\"blocks\": 3,"), std::string::npos);
+    EXPECT_NE(text.find("\"blockSize\": {\"min\": 300, \"max\": 512, \"mean\": 441, \"buckets\": "
+                        "[{\"from\": 256, \"blocks\": 1}, {\"from\": 512, \"blocks\": 2}]},"),
+              std::string::npos);
+    EXPECT_NE(text.find("\"nonPowerOfTwoBlocks\": 1,"), std::string::npos);
+    EXPECT_NE(text.find("\"parameterPoints\": {\"min\": 0, \"max\": 0, \"mean\": 0, \"buckets\": "
+                        "[{\"from\": 0, \"blocks\": 3}]},"),
+              std::string::npos);
+    EXPECT_NE(text.find("\"silentInputBlocks\": 1,"), std::string::npos);
+    EXPECT_NE(text.find("\"partlySilentInputBlocks\": 1,"), std::string::npos);
+    EXPECT_NE(text.find("\"processMode\": {\"realtime\": 2, \"prefetch\": 0, \"offline\": 1},"),
+              std::string::npos);
+    EXPECT_NE(text.find("\"sampleRates\": [{\"hz\": 44100, \"blocks\": 3}]"), std::string::npos);
+}
+
+TEST(WorkloadStats, Write_UnwritablePathFails) {
+    WorkloadStats stats;
+    addBlock(stats, 64);
+    std::string path = ::testing::TempDir() + "no_such_directory/workload_stats.json";
+    EXPECT_FALSE(stats.write(path.c_str()));
+}
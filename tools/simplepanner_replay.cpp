@@ -0,0 +1,147 @@
+// simplepanner_replay.cpp
+// Replays a session capture (SIMPLEPANNER_CAPTURE_DIR) into a fresh
+// SimplePannerProcessor and reports how long process() took
+//
+//     simplepanner_replay <capture file> [--blocks N] [--repeat N]
+//
+// --blocks stops after N blocks (to bisect a session), --repeat replays N
+// times with a new processor each time. The output hash is the same for
+// every run of the same capture and build; a change points at a change in
+// processing.
+//
+// Program changes select from the preset bank recorded in the capture.
+// The replay loads that bank unless SIMPLEPANNER_PRESET_BANK names another
+// one, and warns when the bank it uses is not the captured one.
+
+#include "pluginprocessor.h"
+#include "plugids.h"
+#include "session_replay.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Steinberg;
+using namespace Steinberg::SimplePanner;
+
+namespace {
+
+void setEnvironment(const char* name, const char* value)
+{
+#if defined(_WIN32)
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+int usage()
+{
+    std::fprintf(stderr, "usage: simplepanner_replay <capture file> [--blocks N] [--repeat N]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const char* path = nullptr;
+    long long maxBlocks = -1;
+    long repeat = 1;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--blocks") == 0 && i + 1 < argc)
+            maxBlocks = std::atoll(argv[++i]);
+        else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            repeat = std::max(std::atol(argv[++i]), 1L);
+        else if (!path && argv[i][0] != '-')
+            path = argv[i];
+        else
+            return usage();
+    }
+    if (!path)
+        return usage();
+
+    SessionReplay replay;
+    if (!replay.open(path))
+    {
+        std::fprintf(stderr, "%s: %s\n", path, replay.error());
+        return 1;
+    }
+
+    // The replayed processor must not capture itself
+    setEnvironment(PluginInfo::kCaptureDirEnv, "");
+
+    // Same bank as the captured session, unless one is given explicitly
+    const ReplayPresetBank& capturedBank = replay.presetBank();
+    const char* bankOverride = std::getenv(PluginInfo::kPresetBankEnv);
+    if (capturedBank.recorded && !(bankOverride && *bankOverride))
+        setEnvironment(PluginInfo::kPresetBankEnv, capturedBank.path.c_str());
+
+    std::printf("%s: %s\n", path, replay.hasAudio() ? "with input audio" : "without input audio (silence)");
+    if (capturedBank.recorded)
+        std::printf("  preset bank: %s (%d programs, checksum %08x)\n",
+                    capturedBank.path.empty() ? "none" : capturedBank.path.c_str(), capturedBank.count,
+                    static_cast<unsigned>(capturedBank.checksum));
+    else
+        std::printf("  warning: the capture does not record its preset bank; program changes may differ\n");
+
+    for (long run = 0; run < repeat; ++run)
+    {
+        SimplePannerProcessor* processor = new SimplePannerProcessor();
+        processor->initialize(nullptr);
+
+        const PresetTable& table = processor->getPresetTable();
+        if (run == 0 && capturedBank.recorded && table.checksum() != capturedBank.checksum)
+            std::printf("  warning: replaying with preset bank %s (checksum %08x), not the captured one;"
+                        " program changes recall other values\n",
+                        processor->getPresetBankPath().empty() ? "none" : processor->getPresetBankPath().c_str(),
+                        static_cast<unsigned>(table.checksum()));
+
+        // FNV-1a over the output samples of every block
+        uint32 outputHash = 2166136261u;
+        ReplayStats stats;
+        bool ok = replay.run(*processor, stats, maxBlocks, [&outputHash](int64, Vst::ProcessData& data) {
+            for (int32 b = 0; b < data.numOutputs; ++b)
+            {
+                for (int32 c = 0; c < data.outputs[b].numChannels; ++c)
+                {
+                    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(
+                        data.outputs[b].channelBuffers32[c]);
+                    for (size_t i = 0; i < sizeof(float) * static_cast<size_t>(data.numSamples); ++i)
+                    {
+                        outputHash ^= bytes[i];
+                        outputHash *= 16777619u;
+                    }
+                }
+            }
+        });
+
+        processor->terminate();
+        processor->release();
+
+        double meanMicros = stats.blocks > 0 ? 1.0e6 * stats.processSeconds / stats.blocks : 0.0;
+        double realtimeFactor = stats.processSeconds > 0.0 ? stats.audioSeconds / stats.processSeconds : 0.0;
+        std::printf("run %ld: %lld blocks, %lld samples (%.3f s of audio), %d setups, %d activations, %d states\n",
+                    run + 1, static_cast<long long>(stats.blocks), static_cast<long long>(stats.samples),
+                    stats.audioSeconds, stats.setups, stats.activations, stats.states);
+        std::printf("  process(): %.3f ms total, %.2f us mean, %.2f us max, %.1fx real time\n",
+                    1.0e3 * stats.processSeconds, meanMicros, 1.0e6 * stats.maxBlockSeconds, realtimeFactor);
+        std::printf("  output hash %08x\n", static_cast<unsigned>(outputHash));
+
+        if (!stats.complete && maxBlocks < 0)
+            std::printf("  warning: the capture was not closed properly; the session may be cut short\n");
+        if (stats.presetBanks > 1)
+            std::printf("  warning: the preset bank changed during the capture; only the first one is replayed\n");
+        if (stats.droppedRecords > 0)
+            std::printf("  warning: %llu records were lost during capture; the replay is not exact\n",
+                        static_cast<unsigned long long>(stats.droppedRecords));
+        if (!ok)
+        {
+            std::fprintf(stderr, "%s: %s\n", path, replay.error());
+            return 1;
+        }
+    }
+    return 0;
+}